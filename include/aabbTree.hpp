@@ -0,0 +1,220 @@
+/*!	\file	aabbTree.hpp
+	\brief	Class storing axis-aligned bounding boxes in a bounding volume hierarchy. */
+
+#ifndef HH_AABBTREE_HH
+#define HH_AABBTREE_HH
+
+#include <vector>
+#include <array>
+#include <limits>
+
+#include "boundingBox.hpp"
+
+namespace geometry
+{
+	/*!	This class stores a set of three-dimensional bounding boxes,
+		each labelled by the Id of an element, in a binary tree of
+		axis-aligned boxes. The tree is built top-down, splitting the boxes
+		of each node in two halves along the direction where their barycenters
+		spread the most; a node is a leaf when it holds at most leafSize boxes.
+		The nodes are stored in pre-order: the left child follows its parent,
+		the right child follows the whole left subtree. Since the shape of the
+		tree only depends on the number of boxes, any subtree can be re-built
+		in place over the same boxes.
+
+		When a box is replaced or erased, the bounds of its leaf and of the
+		ancestors are re-computed bottom-up, stopping at the first node whose
+		bounds do not change (refit). The boxes of a node whose surface has
+		grown more than a given factor since the node has been built are
+		likely to be poorly clustered; then the topmost of these subtrees
+		are re-built, so that the queries keep visiting few nodes. The whole
+		tree should be re-built when erased boxes are the majority.
+
+		Boxes of elements not in the tree are kept aside in a list which is
+		scanned linearly, until the next build.
+
+		\sa structuredData.hpp */
+	class aabbTree
+	{
+		public:
+			/*!	Value marking a missing location, a leaf or an erased box. */
+			static constexpr UInt none = numeric_limits<UInt>::max();
+
+		private:
+			/*!	Node of the tree. */
+			struct node
+			{
+				/*!	South-West and North-East point of the node. */
+				array<Real,3>	SW;
+				array<Real,3>	NE;
+
+				/*!	Surface of the node when it has been built. */
+				Real			area;
+
+				/*!	Parent; none for the root. */
+				UInt			parent;
+
+				/*!	Right child; none for a leaf. */
+				UInt			right;
+
+				/*!	Range of the boxes of the subtree. */
+				UInt			first;
+				UInt			count;
+			};
+
+			/*!	Maximum number of boxes in a leaf. */
+			static constexpr UInt leafSize = 4;
+
+			/*!	Nodes, in pre-order. */
+			vector<node> nodes;
+
+			/*!	Boxes, sorted so that the boxes of each subtree are contiguous;
+				erased boxes have Id aabbTree::none. */
+			vector<bbox3d> boxes;
+
+			/*!	Boxes of elements not in the tree. */
+			vector<bbox3d> extra;
+
+			/*!	Leaf of each box. */
+			vector<UInt> leaf;
+
+			/*!	Location of the box of each element: either the position in
+				boxes, or the size of boxes plus the position in extra. */
+			vector<UInt> location;
+
+			/*!	Leaves whose boxes have changed since the last refit. */
+			vector<UInt> dirty;
+
+			/*!	Maximum growth of the surface of a node. */
+			Real maxGrowth;
+
+			/*!	Number of erased boxes. */
+			UInt numErased;
+
+			/*!	Number of subtrees re-built after a refit. */
+			UInt numRebuilds;
+
+		public:
+			//
+			// Constructors
+			//
+
+			/*!	(Default) constructor.
+				\param mg	maximum growth of the surface of a node
+							before its subtree is re-built */
+			aabbTree(const Real & mg = 2.);
+
+			//
+			// Get methods
+			//
+
+			/*!	Get the number of (live) boxes.
+				\return		number of boxes */
+			UInt size() const;
+
+			/*!	Get the (live) boxes.
+				\return		vector of bounding boxes */
+			vector<bbox3d> getBoundingBox() const;
+
+			/*!	Get the maximum growth of the surface of a node.
+				\return		the growth */
+			Real getMaxGrowth() const;
+
+			/*!	Get the number of subtrees re-built after a refit.
+				\return		number of re-builds */
+			UInt getNumRebuilds() const;
+
+			/*!	Check whether the whole tree should be re-built, i.e. when
+				erased boxes or boxes not in the tree are too many.
+				\return		TRUE if the tree should be re-built,
+							FALSE otherwise */
+			bool toRebuild() const;
+
+			/*!	Get the memory occupied by the tree.
+				\return		number of bytes */
+			size_t getMemory() const;
+
+			/*!	Visit the (live) boxes overlapping a given box,
+				boundary included.
+				\param SW	South-West point of the box
+				\param NE	North-East point of the box
+				\param f	function taking a bounding box */
+			template<typename F>
+			void forEachOverlap(const point3d & SW, const point3d & NE, F f) const;
+
+			//
+			// Set methods
+			//
+
+			/*!	Set the maximum growth of the surface of a node.
+				\param mg	the growth, greater than one */
+			void setMaxGrowth(const Real & mg);
+
+			//
+			// Modify the tree
+			//
+
+			/*!	Build the tree.
+				\param all	the bounding boxes, with the Id's of the elements */
+			void build(const vector<bbox3d> & all);
+
+			/*!	Replace the box of an element; the tree is updated
+				at the next refit.
+				\param bb	the bounding box, with the Id of the element */
+			void replace(const bbox3d & bb);
+
+			/*!	Erase the box of an element; the tree is updated
+				at the next refit.
+				\param id	Id of the element */
+			void erase(const UInt & id);
+
+			/*!	Re-compute the bounds of the nodes whose boxes have changed,
+				then re-build the subtrees which have grown too much. */
+			void refit();
+
+			/*!	Re-build the tree dropping the erased boxes, and release
+				the memory not needed anymore. */
+			void shrinkToFit();
+
+		private:
+			//
+			// Auxiliary methods
+			//
+
+			/*!	Build a subtree.
+				\param n		index of the root of the subtree
+				\param first	first box of the subtree
+				\param count	number of boxes of the subtree
+				\param parent	parent of the root
+				\return			index following the last node of the subtree */
+			UInt buildSubtree(const UInt & n, const UInt & first,
+				const UInt & count, const UInt & parent);
+
+			/*!	Re-compute the bounds of a node from its boxes
+				or its children.
+				\param n	index of the node
+				\return		TRUE if the bounds have changed,
+							FALSE otherwise */
+			bool computeBounds(const UInt & n);
+
+			/*!	Get the surface of a node.
+				\param nd	the node
+				\return		the surface */
+			static Real getArea(const node & nd);
+
+			/*!	Get the number of nodes of a subtree.
+				\param count	number of boxes of the subtree
+				\return			number of nodes */
+			static UInt getNumNodes(const UInt & count);
+	};
+}
+
+/*!	Include definitions of inlined members. */
+#ifdef INLINED
+#include "inline/inline_aabbTree.hpp"
+#endif
+
+/*!	Include definitions of template members. */
+#include "implementation/imp_aabbTree.hpp"
+
+#endif
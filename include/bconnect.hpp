@@ -5,11 +5,11 @@
 #define HH_BCONNECT_HH
 
 #include <memory>
-#include <unordered_set>
 
-#include "hash.hpp"
+#include "edgeTable.hpp"
 #include "graphItem.hpp"
 #include "mesh.hpp"
+#include "view.hpp"
 
 namespace geometry
 {
@@ -52,8 +52,12 @@ namespace geometry
 			/*! The mesh. */
 			mesh<SHAPE,MT> grid;
 			
-			/*! Set of edges. */
-			unordered_set<geoElement<Line>> edges;
+			/*! Set of edges; each edge is identified by its handle. */
+			edgeTable edges;
+			
+			/*! Old-to-new map for the handles of the edges, as given by
+				the last re-numbering of the set of edges. */
+			vector<UInt> edgesOld2New;
 			
 			/*! Node-node connections. */
 			vector<graphItem> node2node;
@@ -92,15 +96,36 @@ namespace geometry
 			
 			/*! Initialize node-element connections. */
 			void buildNode2Elem();
+			
+			/*! Initialize the set of edges only. */
+			void buildEdges();
 						
-			/*! Re-build all connections. 
+			/*! Refresh the mesh and apply the resulting old-to-new maps to
+				all connections in place, then re-build the set of edges.
+				\param keepEdges	if TRUE, the set of edges is supposed to have
+									been kept updated through the collapses (see
+									replaceNodeInEdges()), then it is re-numbered
+									rather than re-built (see getEdgesOld2New())
+				\return 	old-to-new map for nodes Id's
+				\return		old-to-new map for elements Id's */
+			virtual pair<vector<UInt>, vector<UInt>> refresh(const bool & keepEdges = false);
+			
+			/*!	Re-order nodes and elements of the mesh along the Morton
+				curve (see bmesh::reorder()) and apply the resulting maps
+				to all connections, including the set of edges, which is
+				re-numbered (see getEdgesOld2New()).
+				The mesh is supposed to be refreshed.
 				\return 	old-to-new map for nodes Id's
 				\return		old-to-new map for elements Id's */
-			virtual pair<map<UInt,UInt>, map<UInt,UInt>> refresh();
+			virtual pair<vector<UInt>, vector<UInt>> reorder();
 			
 			/*! Clear all connections and the set of edges. */
 			virtual void clear();
 			
+			/*!	Release the memory not used by the mesh, the connections
+				and the set of edges, e.g. after a refresh. */
+			virtual void shrinkToFit();
+			
 			//
 			// Modify connections 
 			//
@@ -301,6 +326,18 @@ namespace geometry
 			void undoEdgeCollapse(const UInt & oldId, const UInt & newId,
 				const vector<UInt> & newId_oldNode2Node, const vector<UInt> & newId_oldNode2Elem,
 				const vector<UInt> & onEdge);
+			
+			/*!	Update the set of edges after an edge collapse has been applied:
+				the edges connected to the removed node are erased, and the edges
+				connecting the collapsing node to its new neighbours are inserted.
+				The handles of the other edges are preserved, while the handles
+				of the erased edges may be recycled.
+				This is not done by applyEdgeCollapse(), so that the temporary
+				collapses, undone by undoEdgeCollapse(), leave the handles alone.
+				
+				\param oldId	Id of the removed node
+				\param newId	Id of the collapsing node */
+			void replaceNodeInEdges(const UInt & oldId, const UInt & newId);
 									
 			//
 			// Get methods
@@ -318,29 +355,58 @@ namespace geometry
 				\return		number of edges */
 			UInt getNumEdges() const;
 			
-			/*! Get edges of the mesh.
+			/*! Get edges of the mesh. The Id of each edge is its handle
+				in the set of edges, which does not change until the set
+				gets re-built (e.g. by refresh()).
 				\return		vector of edges */
 			// Note: we return a (possible huge) vector by value for Return Value Optimization (RVO).
 			// Reference: https://web.archive.org/web/20130930101140/http://cpp-next.com/archive/2009/08/want-speed-pass-by-value
 			vector<geoElement<Line>> getEdges() const;
+			
+			/*! Get a view on the edges of the mesh, to iterate over 
+				them without copying; the view is invalidated by any 
+				change in the connectivity. Each edge is given by the
+				pair (min Id, max Id) of its end-points, and its position
+				in the view is its handle. Between two re-numberings,
+				the edges erased by replaceNodeInEdges() are given by
+				the pair (edgeTable::none, edgeTable::none).
+				\return		view on the edges */
+			view<typename vector<array<UInt,2>>::const_iterator> getEdgesView() const;
+			
+			/*!	Get the set of edges, e.g. to get the handle of an edge.
+				\return		non-owning reference to the set of edges */
+			const edgeTable & getEdgeTable() const;
+			
+			/*!	Get the old-to-new map for the handles of the edges, as given
+				by the last call to refresh(true) or reorder(); the erased edges
+				are marked with edgeTable::none. This lets the information
+				stored for each handle be moved along with the edges.
+				\return		non-owning reference to the map */
+			const vector<UInt> & getEdgesOld2New() const;
 						
 			/*! Get the node-node connections for a node.
 				\param Id	node Id
-				\return		the connections */
-			graphItem getNode2Node(const UInt & Id) const;
+				\return		non-owning reference to the connections */
+			const graphItem & getNode2Node(const UInt & Id) const;
 			
 			/*! Get node-node connections for all nodes.
-				\return		vector of connections */			
-			vector<graphItem> getNode2Node() const;
+				\return		non-owning reference to the vector of connections */			
+			const vector<graphItem> & getNode2Node() const;
 			
 			/*! Get the node-element connections for a node.
 				\param Id	node Id
-				\return		the connections */
-			graphItem getNode2Elem(const UInt & Id) const;
+				\return		non-owning reference to the connections */
+			const graphItem & getNode2Elem(const UInt & Id) const;
 			
 			/*! Get node-element connections for all nodes.
-				\return		vector of connections */
-			vector<graphItem> getNode2Elem() const;
+				\return		non-owning reference to the vector of connections */
+			const vector<graphItem> & getNode2Elem() const;
+			
+			/*!	Get the memory occupied by the mesh, the connections 
+				and the set of edges.
+				\param mr	the report, whose fields for these
+							components are set */
+			virtual void getMemory(memoryReport & mr) const;
 						
 			//
 			// Set methods
@@ -349,6 +415,48 @@ namespace geometry
 			/*! Set mesh. After that, the connections are (re-)built.
 				\param g	the new mesh */
 			void setMesh(const bmesh<SHAPE> & g);
+			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the mesh and the connections in binary format.
+				\param out	output stream */
+			virtual void save(ostream & out) const;
+			
+			/*!	Read the mesh and the connections from binary format,
+				as written by save(). The connections are not re-built.
+				\param in	input stream */
+			virtual void load(istream & in);
+			
+		protected:
+			/*!	Write a list of connections in binary format.
+				\param out	output stream
+				\param v	the connections */
+			static void save(ostream & out, const vector<graphItem> & v);
+			
+			/*!	Read a list of connections from binary format.
+				\param in	input stream
+				\param v	the connections */
+			static void load(istream & in, vector<graphItem> & v);
+			
+			/*!	Get the memory occupied by a list of connections,
+				including the connected Id's spilled on the heap.
+				\param v	the connections
+				\return		number of bytes */
+			static size_t getMemory(const vector<graphItem> & v);
+			
+			/*!	Apply old-to-new maps to a list of connections after a
+				refresh or a re-ordering of the mesh. Each item is moved to
+				the position given by its new Id, or erased if removed, and
+				its connected Id's are re-mapped. If the maps are increasing,
+				as after a refresh, this is done in place.
+				\param v				the connections
+				\param itemsOld2New	old-to-new map for the Id's of the items
+				\param connOld2New		old-to-new map for the connected Id's;
+										if empty, the connected Id's are kept */
+			static void refresh(vector<graphItem> & v, const vector<UInt> & itemsOld2New,
+				const vector<UInt> & connOld2New = {});
 	};
 }
 
@@ -9,17 +9,23 @@
 #include <map>
 
 #include "point.hpp"
+#include "nodeStore.hpp"
 #include "geoElement.hpp"
+#include "memoryReport.hpp"
 
 namespace geometry
 {
-	/*! A mesh is stored as a vector of nodes and a vector of elements.
+	/*! A mesh is stored as a list of nodes and a vector of elements.
 		In both vectors, the Id of a node/element coincides with its position 
 		in the vector even after an erase. However, as the class has been designed, 
 		one should avoid to erase nodes or elements but make them unactive. 
 		Note however that once a node is set as unactive, the vector of elements is 
 		not properly updated. This task will be accomplished by the class connect.
 		
+		The nodes are kept in a nodeStore, i.e. as a structure of arrays;
+		hence, a node is returned by value, while the geometric kernels
+		may read the coordinates directly from the store.
+		
 		Although this class can be instantiated, the user should preferer the class mesh, 
 		which inherits from bmesh and also allows for data distributed over the mesh. 
 		
@@ -36,8 +42,8 @@ namespace geometry
 			UInt numNodes;
 			UInt numElems;
 					
-			/*! Vector of nodes. */
-			vector<point> 				nodes;
+			/*! List of nodes. */
+			nodeStore 					nodes;
 			
 			/*! Vector of elements. */
 			vector<geoElement<SHAPE>> 	elems;
@@ -100,18 +106,28 @@ namespace geometry
 				\return		the point */
 			point getNode(const UInt & Id) const;
 			
+			/*!	Get the coordinates of a node.
+				\param Id	node Id
+				\return		the coordinates */
+			point3d getCoor(const UInt & Id) const;
+			
 			/*!	Get full list of nodes.
-				\return		list of nodes */
+				\return		vector of nodes */
 			vector<point> getNodes() const;
+			
+			/*!	Get the store of the nodes, giving direct access
+				to the coordinates arrays.
+				\return		non-owning reference to the store */
+			const nodeStore & getNodeStore() const;
 						
 			/*! Get an element.
 				\param Id	element Id
-				\return		the element */
-			geoElement<SHAPE> getElem(const UInt & Id) const;
+				\return		non-owning reference to the element */
+			const geoElement<SHAPE> & getElem(const UInt & Id) const;
 			
 			/*!	Get full list of elements.
-				\return		list of elements */
-			vector<geoElement<SHAPE>> getElems() const;
+				\return		non-owning reference to the list of elements */
+			const vector<geoElement<SHAPE>> & getElems() const;
 			
 			/*! Get number of nodes.
 				\return		number of nodes */
@@ -143,6 +159,12 @@ namespace geometry
 							FALSE otherwise */
 			bool isElemActive(const UInt & Id) const; 
 			
+			/*!	Get the memory occupied by nodes and elements, 
+				both active and inactive.
+				\param mr	the report, whose fields for nodes and 
+							elements are set */
+			virtual void getMemory(memoryReport & mr) const;
+			
 			//
 			// Set methods
 			//
@@ -241,9 +263,25 @@ namespace geometry
 			//
 			
 			/*!	Remove inactive nodes and elements from the lists and update Id's.
+				Both lists are compacted in place, preserving the order,
+				so that the old-to-new maps are increasing.
+				\return 	old-to-new map for nodes Id's
+				\return		old-to-new map for elements Id's;
+							in both maps, removed entries are mapped to REMOVED_ID */
+			pair<vector<UInt>, vector<UInt>> refresh();
+			
+			/*!	Re-number nodes and elements along the Morton curve, so that
+				nodes and elements close in space get close Id's and the
+				walks through the adjacencies are cache-friendly. Nodes are
+				sorted by their coordinates, elements by their barycenters.
+				The mesh is supposed to be refreshed, i.e. without inactive
+				nodes and elements.
 				\return 	old-to-new map for nodes Id's
 				\return		old-to-new map for elements Id's */
-			pair<map<UInt,UInt>, map<UInt,UInt>> refresh();
+			pair<vector<UInt>, vector<UInt>> reorder();
+			
+			/*!	Release the memory not used by the lists, e.g. after a refresh. */
+			virtual void shrinkToFit();
 			
 			//
 			// Print
@@ -258,14 +296,24 @@ namespace geometry
 				\param filename	name of the output file */
 			void print(const string & filename); 
 			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the mesh in binary format. Inactive nodes and elements
+				are kept, so that Id's are preserved.
+				\param out	output stream */
+			virtual void save(ostream & out) const;
+			
+			/*!	Read the mesh from binary format, as written by save().
+				\param in	input stream */
+			virtual void load(istream & in);
+			
 		protected:
 			//
 			// Update Id's
 			//
 			
-			/*! Update nodes Id's so to make them coincide with the position in the vector. */
-			void setUpNodesIds();
-			
 			/*! Update elements Id's so to make them coincide with the position in the vector. */
 			void setUpElemsIds();
 						
@@ -292,6 +340,20 @@ namespace geometry
 			/*! Print in .inp or .txt format. 
 				\param filename	name of the output file */
 			virtual void print_inp(const string & filename) const;
+			
+			//
+			// Binary input/output of a node
+			//
+			
+			/*!	Write a node in binary format.
+				\param out	output stream
+				\param p	the node */
+			static void savePoint(ostream & out, const point & p);
+			
+			/*!	Read a node from binary format.
+				\param in	input stream
+				\param p	the node */
+			static void loadPoint(istream & in, point & p);
 	};
 }
 
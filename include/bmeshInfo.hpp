@@ -89,13 +89,22 @@ namespace geometry
 			void setMesh(const bmesh<SHAPE> & g);
 			
 			//
-			// Refresh method
+			// Refresh methods
 			//
 			
 			/*!	Refresh the mesh and all the connections. 
+				\param keepEdges	if TRUE, the set of edges, kept updated
+									through the collapses, is re-numbered
+									rather than re-built
 				\return		old-to-new map for nodes Id's
 				\return 	old-to-new map for elements Id's */
-			pair<map<UInt,UInt>, map<UInt,UInt>> refresh();
+			pair<vector<UInt>, vector<UInt>> refresh(const bool & keepEdges = false);
+			
+			/*!	Re-order nodes and elements along the Morton curve
+				and update all the connections.
+				\return		old-to-new map for nodes Id's
+				\return 	old-to-new map for elements Id's */
+			pair<vector<UInt>, vector<UInt>> reorder();
 						
 			//
 			// Print methods
@@ -7,41 +7,21 @@
 #include <iostream>
 
 #include "geoPoint.hpp"
-#include "bmeshInfo.hpp"
 
 namespace geometry
 {
 	/*!	This class stores the extrema of the bounding box surrounding 
-		an element. Moreover, it also computes the indices needed for
-		a structured data search. However, the characteristic
-		dimension of the mesh along each direction is needed, as long
-		as the number of cells and its South-West point. Then all these 
-		required information are stored as static class attributes. 
-		To set them, call the method setup() before any use of this class.
-		Note that for this class to properly work, the code should deal
-		with just one mesh at a time. */
+		an element, together with the Id of the element and the index of
+		the cell of a Cartesian grid the box belongs to. The box does not
+		know the grid: the index is assigned by the owner of the grid
+		through setIdx(), so that boxes referring to different meshes
+		can coexist.
+		
+		\sa cartesianGrid.hpp, structuredData.hpp */
 	template<UInt N>
 	class boundingBox
 	{
 		private:
-			//
-			// Static attributes
-			//
-			
-			/*!	Mesh (global) North-East and South-West point. */
-			static geoPoint<N> NE_global;
-			static geoPoint<N> SW_global;
-			
-			/*! Mesh characteristic dimension along each direction. */
-			static array<Real,N> cellSize;
-			
-			/*! Number of cells along each direction. */
-			static array<UInt,N> numCells;
-			
-			//
-			// Non-static attributes
-			//
-			
 			/*!	Element Id. */
 			UInt Id;
 			
@@ -155,47 +135,21 @@ namespace geometry
 				\return		the South-West point */	
 			geoPoint<N> getSW() const;
 			
-			/*!	Get mesh (global) North-East point.
-				\return		the mesh North-East point. */
-			static geoPoint<N> getGlobalNE();
-			
-			/*!	Get mesh (global) South-West point.
-				\return		the mesh South-West point. */
-			static geoPoint<N> getGlobalSW();
-			
-			/*! Get one size of the cells.
-				\param i	component
-				\return 	the size */
-			static Real getCellSize(const UInt & i);
-			
-			/*! Get cells sizes.
-				\return		array with cells sizes */
-			static array<Real,N> getCellSize();
-			
-			/*! Get number of cells along one direction.
-				\param i	direction
-				\return		number of cells */
-			static UInt getNumCells(const UInt & i);
-			
-			/*! Get number of cells along each direction.
-				\return		array with number of cells along each direction */
-			static array<UInt,N> getNumCells();
-			
 			//
 			// Set methods
 			//
-			// Note: we prevent the user to directly modify the index 
-			// and the end-points of the (local) box. These can be modified 
-			// only by the class once it will be given new vertices.
-			// On the other hand, the user is allowed to modify the parameters
-			// of the bounding box surrounding the grid. 
-			// Static methods guaranteing the coherency of the static members 
-			// are provided in the following.
+			// Note: we prevent the user to directly modify the end-points
+			// of the (local) box. These can be modified only by the class
+			// once it will be given new vertices.
 			
 			/*!	Set element Id.
 				\param id	the new Id */
 			void setId(const UInt & id);
 			
+			/*!	Set element index, i.e. the cell the box belongs to.
+				\param index	the new index */
+			void setIdx(const UInt & index);
+			
 			/*!	Update the vertices of the element, then its bounding box.
 				\param args	vertices of the elements */
 			template<typename... Args>
@@ -207,64 +161,6 @@ namespace geometry
 			template<typename... Args>
 			void update(const UInt & id, Args... args);
 						
-			/*! Set mesh (global) North-East point.
-				\param p	the new North-East point */
-			static void setGlobalNE(const geoPoint<N> & p);
-			
-			/*! Set mesh (global) South-West point.
-				\param p	the new South-West point */
-			static void setGlobalSW(const geoPoint<N> & p);
-			
-			/*! Set one cells size.
-				\param i	component
-				\param val	value */
-			static void setCellSize(const UInt & i, const Real & val);
-			
-			/*! Set all cells sizes.
-				\param val	array with new cells sizes */
-			static void setCellSize(const array<Real,N> & val);
-			
-			/*! Set number of cells along one direction.
-				\param i	component
-				\param val	value */
-			static void setNumCells(const UInt & i, const UInt & val);
-			
-			/*! Set number of cells along each direction.
-				\param val	array with new number of cells */
-			static void setNumCells(const array<UInt,N> & val);
-			
-			/*! Set static (i.e. global) class members.
-				This method should be called BEFORE any use of the class.
-								
-				\param pne	mesh North-East point
-				\param psw	mesh South-West point
-				\param dl	cell size */
-			static void setup(const geoPoint<N> & pne, const geoPoint<N> & psw, 
-				const array<Real,N> & dl);
-			
-			/*! Set static (i.e. global) class members.
-				This method should be called BEFORE any use of the class.
-				It is provided only for three-dimensional elements.
-				
-				\param pne	mesh North-East point
-				\param psw	mesh South-West point
-				\param dx	cells size along x
-				\param dy	cells size along y
-				\param dz	cells size along z */
-			static void setup(const point3d & pne = point3d(1.),  
-				const point3d & psw = point3d(0.), 
-				const Real & dx = 1., const Real & dy = 1., const Real & dz = 1.);
-				
-			/*! Set static (i.e. global) class members.
-				This method should be called BEFORE any use of the class.
-				It is provided only for three-dimensional elements.
-				
-				\param news	a bmeshInfo object
-				
-				\sa bmeshInfo.hpp, meshInfo.hpp */
-			template<typename SHAPE, MeshType MT>
-			static void setup(const bmeshInfo<SHAPE,MT> & news);
-					
 		private:
 			//
 			// Methods to compute (local) North-East and South-West points
@@ -285,24 +181,6 @@ namespace geometry
 				\param args	all other vertices */
 			template<typename... Args>
 			void computeBoundingBoxVertices(const geoPoint<N> & p, Args... args);
-			
-			//
-			// Methods to keep static variables coherent
-			//     
-			
-			/*! Update number of cells along one direction. 
-				\param i	direction */
-			static void updateNumCells(const UInt & i);            
-			
-			/*! Update number of cells along each direction. */
-			static void updateNumCells();
-			
-			/*! Update cells size along one direction.
-				\param i	direction */
-			static void updateCellSize(const UInt & i);
-			
-			/*! Update cells sizes along each direction. */
-			static void updateCellSize();
 	};
 	
 	/*!	A couple of typedef's for ease of notation. */
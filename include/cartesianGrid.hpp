@@ -0,0 +1,180 @@
+/*!	\file	cartesianGrid.hpp
+	\brief	Class describing the hexaedral Cartesian grid employed
+			in the structured data search. */
+
+#ifndef HH_CARTESIANGRID_HH
+#define HH_CARTESIANGRID_HH
+
+#include <array>
+
+#include "boundingBox.hpp"
+#include "bmeshInfo.hpp"
+
+namespace geometry
+{
+	/*!	This class stores the parameters of a Cartesian grid surrounding
+		a three-dimensional mesh: the North-East and South-West points of the
+		mesh (global) bounding box, the size of the cells and the number of
+		cells along each direction. The size of the cells is adjusted so that
+		an integer number of cells covers the box. The grid then assigns to
+		points and bounding boxes the index of the cell they fall within.
+
+		Each structuredData object owns its grid, so that independent meshes
+		can be searched at the same time, e.g. by simplifications running
+		on separate threads.
+
+		\sa structuredData.hpp, boundingBox.hpp */
+	class cartesianGrid
+	{
+		private:
+			/*!	Mesh (global) North-East and South-West point. */
+			point3d NE;
+			point3d SW;
+
+			/*! Size of the cells along each direction. */
+			array<Real,3> cellSize;
+
+			/*! Number of cells along each direction. */
+			array<UInt,3> numCells;
+
+		public:
+			//
+			// Constructors
+			//
+
+			/*!	(Default) constructor.
+				\param pne	mesh North-East point
+				\param psw	mesh South-West point
+				\param dl	(maximum) size of the cells along each direction */
+			cartesianGrid(const point3d & pne = point3d(1.,1.,1.),
+				const point3d & psw = point3d(0.,0.,0.),
+				const array<Real,3> & dl = {{1.,1.,1.}});
+
+			/*!	Constructor. The grid surrounds the active nodes of a mesh,
+				while the size of the cells is given by the maximum extent
+				of the edges along each direction.
+				\param news	a bmeshInfo object
+
+				\sa bmeshInfo.hpp */
+			template<typename SHAPE, MeshType MT>
+			cartesianGrid(const bmeshInfo<SHAPE,MT> & news);
+
+			//
+			// Get methods
+			//
+
+			/*!	Get mesh (global) North-East point.
+				\return		the mesh North-East point */
+			point3d getNE() const;
+
+			/*!	Get mesh (global) South-West point.
+				\return		the mesh South-West point */
+			point3d getSW() const;
+
+			/*! Get one size of the cells.
+				\param i	component
+				\return 	the size */
+			Real getCellSize(const UInt & i) const;
+
+			/*! Get cells sizes.
+				\return		array with cells sizes */
+			array<Real,3> getCellSize() const;
+
+			/*! Get number of cells along one direction.
+				\param i	direction
+				\return		number of cells */
+			UInt getNumCells(const UInt & i) const;
+
+			/*! Get number of cells along each direction.
+				\return		array with number of cells along each direction */
+			array<UInt,3> getNumCells() const;
+
+			/*!	Get the total number of cells.
+				\return		number of cells */
+			UInt getTotalNumCells() const;
+
+			/*!	Get the cell a coordinate falls within along one direction.
+				Coordinates outside the mesh (global) bounding box are
+				assigned to the first or the last cell.
+				\param x	the coordinate
+				\param i	direction
+				\return		index of the cell */
+			UInt getCell(const Real & x, const UInt & i) const;
+
+			/*!	Get the cell a point falls within along each direction.
+				\param p	the point
+				\return		indices of the cell */
+			array<UInt,3> getCells(const point3d & p) const;
+
+			/*!	Get the scalar index of the cell a point falls within.
+				\param p	the point
+				\return		the index */
+			UInt getIdx(const point3d & p) const;
+
+			/*!	Get the scalar index of the cell the barycenter
+				of a bounding box falls within.
+				\param bb	the bounding box
+				\return		the index */
+			UInt getIdx(const bbox3d & bb) const;
+
+			//
+			// Set methods
+			//
+			// The methods keep the number and the size of the cells coherent.
+
+			/*! Set mesh (global) North-East point.
+				\param p	the new North-East point */
+			void setNE(const point3d & p);
+
+			/*! Set mesh (global) South-West point.
+				\param p	the new South-West point */
+			void setSW(const point3d & p);
+
+			/*! Set one cells size.
+				\param i	component
+				\param val	value */
+			void setCellSize(const UInt & i, const Real & val);
+
+			/*! Set all cells sizes.
+				\param val	array with new cells sizes */
+			void setCellSize(const array<Real,3> & val);
+
+			/*! Set number of cells along one direction.
+				\param i	component
+				\param val	value */
+			void setNumCells(const UInt & i, const UInt & val);
+
+			/*! Set number of cells along each direction.
+				\param val	array with new number of cells */
+			void setNumCells(const array<UInt,3> & val);
+
+		private:
+			//
+			// Methods to keep the attributes coherent
+			//
+
+			/*! Update number of cells along one direction.
+				\param i	direction */
+			void updateNumCells(const UInt & i);
+
+			/*! Update number of cells along each direction. */
+			void updateNumCells();
+
+			/*! Update cells size along one direction.
+				\param i	direction */
+			void updateCellSize(const UInt & i);
+
+			/*! Update cells sizes along each direction. */
+			void updateCellSize();
+	};
+}
+
+/*! Include definitions of inlined members. */
+#ifdef INLINED
+#include "inline/inline_cartesianGrid.hpp"
+#endif
+
+/*!	Include definitions of template members. */
+#include "implementation/imp_cartesianGrid.hpp"
+
+#endif
@@ -29,6 +29,13 @@ namespace geometry
 			/*!	Collapsing cost. */
 			Real cost;
 			
+			/*!	Components of the cost before normalization, e.g. the 
+				geometric, data displacement and data distribution costs 
+				for DataGeo. They let the cost be re-computed whenever the
+				normalization changes, without re-evaluating the collapse.
+				Unused by purely geometric cost classes. */
+			array<Real,3> components;
+			
 		public:
 			//
 			// Constructor
@@ -41,9 +48,10 @@ namespace geometry
 				\param id1	Id of first end-point
 				\param id2	Id of second end-point
 				\param val	collapsing cost
-				\param cp	collapsing point */
+				\param cp	collapsing point
+				\param cmp	components of the cost */
 			collapsingEdge(const UInt & id1, const UInt & id2, const Real & val = 0.,
-				const point3d & cp = {0.,0.,0.});
+				const point3d & cp = {0.,0.,0.}, const array<Real,3> & cmp = {{0.,0.,0.}});
 				
 			/*!	Constructor.
 				\param ids	vector with end-points Id's
@@ -93,6 +101,10 @@ namespace geometry
 				\return		the cost */
 			Real getCost() const;
 			
+			/*!	Get components of the collapsing cost.
+				\return		the components */
+			array<Real,3> getComponents() const;
+			
 			//
 			// Set methods
 			//
@@ -112,6 +124,10 @@ namespace geometry
 			/*!	Set collapsing cost.
 				\param val	the new cost */	
 			void setCost(const Real & val);
+			
+			/*!	Set components of the collapsing cost.
+				\param cmp	the new components */
+			void setComponents(const array<Real,3> & cmp);
 	};
 }
 
@@ -0,0 +1,292 @@
+/*!	\file	collapsingQueue.hpp
+	\brief	Class storing the collapsing edges in a priority queue addressable by end-points. */
+
+#ifndef HH_COLLAPSINGQUEUE_HH
+#define HH_COLLAPSINGQUEUE_HH
+
+#include <vector>
+#include <functional>
+
+#include "collapsingEdge.hpp"
+#include "edgeTable.hpp"
+
+namespace geometry
+{
+	/*!	Queue mode:
+		<ol>
+		<li> ADDRESSABLE: each edge is stored once and it is moved
+			 within the heap whenever its cost changes;
+		<li> LAZY: a new entry is pushed any time the cost of an edge
+			 changes, while old entries are left in the heap and
+			 discarded when they reach the top.
+		<\ol> */
+	enum class QueueMode {ADDRESSABLE, LAZY};
+
+	/*!	This class stores the collapsingEdge objects in a d-ary min-heap,
+		ordered according to the less-than operator of collapsingEdge
+		(i.e. first by cost, then by end-points Id's).
+		The queue does not store the edges by itself: it refers to the set
+		of edges of the mesh (see bconnect::getEdgeTable()), which gives each
+		edge a handle, and an index stores a value for each handle. Each entry
+		of the heap keeps the handle of its edge, so that moving entries within
+		the heap involves no hashing at all: the end-points are hashed only when
+		an edge is looked up by end-points, i.e. once per emplace() or erase().
+		Any edge inserted in the queue must be in the set. Two modes are
+		available.
+
+		In ADDRESSABLE mode the index stores the position in the heap of
+		each edge. Then, the cheapest edge is accessed in constant time,
+		while an edge can be found, erased or have its cost changed
+		(decrease-key and increase-key) in logarithmic time given just
+		its end-points.
+
+		In LAZY mode each entry of the heap is stamped with a version
+		number, and the index stores the version of the only valid entry
+		of each edge. Erasing an edge just removes it from the index,
+		while changing its cost pushes a new entry with a new version.
+		Stale entries are discarded when they reach the top of the heap;
+		moreover, the heap is compacted whenever the fraction of stale
+		entries exceeds a given bound, so to keep memory bounded.
+
+		In both modes the cheapest valid edge is the same, so switching
+		mode does not affect the simplification process.
+		Note that the end-points are not required to be sorted: the edges
+		(id1,id2) and (id2,id1) are considered the same.
+
+		\sa collapsingEdge.hpp, simplification.hpp */
+	class collapsingQueue
+	{
+		private:
+			/*!	Heap entry: a collapsingEdge, its version and the handle
+				of the edge. The version is meaningful only in LAZY mode. */
+			struct entry
+			{
+				collapsingEdge	cEdge;
+				UInt			version;
+				UInt			handle;
+			};
+
+			/*!	Arity of the heap. */
+			static constexpr UInt D = 4;
+
+			/*!	Minimum number of entries in the heap for the
+				compaction to take place. */
+			static constexpr UInt minCompactSize = 1024;
+
+			/*!	Queue mode. */
+			QueueMode mode;
+
+			/*!	Maximum fraction of stale entries in LAZY mode. */
+			Real staleBound;
+
+			/*!	Last version assigned in LAZY mode. */
+			UInt lastVersion;
+
+			/*!	The heap. */
+			vector<entry> heap;
+
+			/*!	Set of edges of the mesh, giving the handles. */
+			const edgeTable * edges;
+
+			/*!	Number of (valid) edges in the queue. */
+			UInt numEdges;
+
+			/*!	Index keyed by the handles of the edges.
+				In ADDRESSABLE mode, it stores the position in the heap of
+				each edge; in LAZY mode, the version of its valid entry.
+				Erased edges are marked with edgeTable::none. */
+			vector<UInt> pos;
+
+		public:
+			//
+			// Constructors
+			//
+
+			/*!	(Default) constructor.
+				\param et	pointer to the set of edges, which is not owned
+				\param qm	queue mode
+				\param sb	maximum fraction of stale entries in LAZY mode */
+			collapsingQueue(const edgeTable * et = nullptr,
+				const QueueMode & qm = QueueMode::ADDRESSABLE, const Real & sb = 0.5);
+
+			/*!	Constructor.
+				\param et		pointer to the set of edges, which is not owned
+				\param cEdges	vector of collapsingEdge objects;
+								each edge should appear at most once
+				\param qm		queue mode
+				\param sb		maximum fraction of stale entries in LAZY mode */
+			collapsingQueue(const edgeTable * et, const vector<collapsingEdge> & cEdges,
+				const QueueMode & qm = QueueMode::ADDRESSABLE, const Real & sb = 0.5);
+
+			//
+			// Access members
+			//
+
+			/*!	Get the number of (valid) edges in the queue.
+				\return		number of edges */
+			UInt size() const;
+
+			/*!	Get the number of entries in the heap, including
+				the stale ones in LAZY mode.
+				\return		number of entries */
+			UInt getHeapSize() const;
+
+			/*!	Check if the queue is empty.
+				\return		TRUE if the queue is empty, FALSE otherwise */
+			bool empty() const;
+
+			/*!	Get the cheapest edge.
+				The queue should not be empty.
+
+				\return		the edge with minimum cost */
+			const collapsingEdge & top() const;
+
+			/*!	Check whether an edge is in the queue.
+				\param id1	Id of first end-point of the edge
+				\param id2	Id of second end-point of the edge
+				\return		TRUE if the edge has been found, FALSE otherwise */
+			bool find(const UInt & id1, const UInt & id2) const;
+
+			/*!	Get a copy of all the (valid) edges in the queue.
+				The edges are not sorted.
+
+				\return		vector of collapsingEdge objects */
+			vector<collapsingEdge> getEdges() const;
+
+			/*!	Get the queue mode.
+				\return		the mode */
+			QueueMode getMode() const;
+
+			/*!	Get the maximum fraction of stale entries in LAZY mode.
+				\return		the bound */
+			Real getStaleBound() const;
+
+			/*!	Get the memory occupied by the queue.
+				\return		number of bytes */
+			size_t getMemory() const;
+
+			//
+			// Set methods
+			//
+
+			/*!	Set the queue mode. The edges currently in the queue are kept.
+				\param qm	the new mode */
+			void setMode(const QueueMode & qm);
+
+			/*!	Set the maximum fraction of stale entries in LAZY mode.
+				\param sb	the new bound, in (0,1] */
+			void setStaleBound(const Real & sb);
+
+			//
+			// Updating methods
+			//
+
+			/*!	Insert an edge or, if already present, replace its cost and
+				collapsing point.
+
+				\param id1	Id of first end-point of the edge
+				\param id2	Id of second end-point of the edge
+				\param val	collapsing cost
+				\param p	collapsing point
+				\param cmp	components of the cost */
+			void emplace(const UInt & id1, const UInt & id2, const Real & val,
+				const point3d & p = {0.,0.,0.}, const array<Real,3> & cmp = {{0.,0.,0.}});
+
+			/*!	Insert a set of edges at once. If the queue is empty, the heap
+				is built bottom-up in linear time; otherwise, the edges are
+				inserted one by one through emplace().
+
+				\param cEdges	vector of collapsingEdge objects;
+								each edge should appear at most once */
+			void insert(const vector<collapsingEdge> & cEdges);
+
+			/*!	Erase an edge.
+				\param id1	Id of first end-point of the edge
+				\param id2	Id of second end-point of the edge
+				\return		TRUE if the edge has been found, FALSE otherwise */
+			bool erase(const UInt & id1, const UInt & id2);
+
+			/*!	Remove the cheapest edge.
+				The queue should not be empty. */
+			void pop();
+
+			/*!	Remove all edges. */
+			void clear();
+
+			/*!	Replace the cost of all edges, leaving end-points, collapsing
+				points and components unchanged, then re-build the heap in 
+				linear time. This is useful whenever the costs are re-scaled,
+				e.g. because the normalization of their components has changed.
+				\param f	function giving the new cost of an edge */
+			void rekey(const function<Real(const collapsingEdge &)> & f);
+			
+			/*!	Apply an old-to-new map to all nodes Id's, leaving costs and
+				collapsing points unchanged. This method should be called any
+				time the mesh gets refreshed, i.e. the inactive nodes and
+				elements are removed, after the set of edges has been
+				re-numbered accordingly.
+
+				\param old2new	old-to-new map for nodes Id's */
+			void refresh(const vector<UInt> & old2new);
+
+			/*!	Release the memory not used by the queue, e.g. after
+				a refresh. In LAZY mode, the stale entries are dropped. */
+			void shrinkToFit();
+
+		private:
+			//
+			// Heap handling
+			//
+
+			/*!	Get the handle of an edge from the set of edges, making
+				room for it in the index. The edge must be in the set.
+				\param id1	Id of first end-point of the edge
+				\param id2	Id of second end-point of the edge
+				\return		the handle
+				\return		TRUE if the edge is not in the queue,
+							FALSE otherwise */
+			pair<UInt,bool> getHandle(const UInt & id1, const UInt & id2);
+
+			/*!	Check whether an entry is valid, i.e. not stale.
+				\param e	the entry
+				\return		TRUE if the entry is valid, FALSE otherwise */
+			bool isValid(const entry & e) const;
+
+			/*!	Store an entry in a slot of the heap and, in ADDRESSABLE mode,
+				update the index.
+				\param i	slot
+				\param e	the entry */
+			void place(const UInt & i, const entry & e);
+
+			/*!	Move an entry towards the root until the heap property is restored.
+				\param i	starting slot */
+			void siftUp(UInt i);
+
+			/*!	Move an entry towards the leaves until the heap property is restored.
+				\param i	starting slot */
+			void siftDown(UInt i);
+
+			/*!	Remove the entry in a slot, restoring the heap property.
+				\param i	slot */
+			void removeAt(const UInt & i);
+
+			/*!	In LAZY mode, discard the stale entries on the top of the heap
+				and possibly compact the heap. */
+			void prune();
+
+			/*!	Remove all stale entries. */
+			void compact();
+
+			/*!	Restore the heap property over the whole heap and re-build
+				the index. All entries are supposed to be valid, and to
+				store the handles of their edges. */
+			void heapify();
+	};
+}
+
+/*!	Include implementations of inlined class members. */
+#ifdef INLINED
+#include "inline/inline_collapsingQueue.hpp"
+#endif
+
+#endif
@@ -177,14 +177,35 @@ namespace geometry
 				prefered whenever data locations do not coincide with grid nodes. */
 			void buildElem2Data_p();
 					
-			/*! Re-build all connections. 
+			/*! Refresh the mesh and apply the resulting old-to-new maps to
+				all connections in place, then re-build the set of edges.
+				\param keepEdges	if TRUE, the set of edges, kept updated
+									through the collapses, is re-numbered
+									rather than re-built
 				\return 	old-to-new map for nodes Id's
 				\return		old-to-new map for elements Id's */
-			virtual pair<map<UInt,UInt>, map<UInt,UInt>> refresh();
+			virtual pair<vector<UInt>, vector<UInt>> refresh(const bool & keepEdges = false);
+			
+			/*!	Re-order nodes and elements of the mesh along the Morton
+				curve and apply the resulting maps to all connections,
+				then re-build the set of edges. Data points are left
+				untouched; see reorderData().
+				\return 	old-to-new map for nodes Id's
+				\return		old-to-new map for elements Id's */
+			virtual pair<vector<UInt>, vector<UInt>> reorder();
+			
+			/*!	Re-order the data points along the Morton curve and
+				apply the resulting map to the connections.
+				\return		old-to-new map for data points Id's */
+			vector<UInt> reorderData();
 			
 			/*! Clear all connections and the set of edges. */
 			virtual void clear();
 			
+			/*!	Release the memory not used by the mesh, the connections
+				and the set of edges. */
+			virtual void shrinkToFit();
+			
 			//
 			// Modify connections
 			//
@@ -227,21 +248,27 @@ namespace geometry
 			
 			/*! Get data-element connections for a datum.
 				\param Id	datum Id
-				\return		the connections */
-			graphItem getData2Elem(const UInt & Id) const;
+				\return		non-owning reference to the connections */
+			const graphItem & getData2Elem(const UInt & Id) const;
 			
 			/*! Get data-element connections for all data.
-				\return		vector of connections */
-			vector<graphItem> getData2Elem() const;
+				\return		non-owning reference to the vector of connections */
+			const vector<graphItem> & getData2Elem() const;
 			
 			/*! Get element-data connections for an element.
 				\param Id	element Id
-				\return		the connections */
-			graphItem getElem2Data(const UInt & Id) const;
+				\return		non-owning reference to the connections */
+			const graphItem & getElem2Data(const UInt & Id) const;
 			
 			/*! Get element-data connections for all elements.
-				\return		vector of connections */
-			vector<graphItem> getElem2Data() const;
+				\return		non-owning reference to the vector of connections */
+			const vector<graphItem> & getElem2Data() const;
+			
+			/*!	Get the memory occupied by the mesh, the connections 
+				and the set of edges.
+				\param mr	the report, whose fields for these
+							components are set */
+			virtual void getMemory(memoryReport & mr) const;
 						
 			//
 			// Set methods
@@ -287,6 +314,19 @@ namespace geometry
 				
 				\param newData2Elem	vector of connections */
 			void setData2Elem(const vector<graphItem> & newData2Elem);
+			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the mesh and all the connections in binary format.
+				\param out	output stream */
+			virtual void save(ostream & out) const;
+			
+			/*!	Read the mesh and all the connections from binary format,
+				as written by save(). The connections are not re-built.
+				\param in	input stream */
+			virtual void load(istream & in);
 		
 		protected:
 			//
@@ -295,7 +335,7 @@ namespace geometry
 			
 			/*!	Update data-element connections after a mesh refresh.
 				\param old2new	old-to-new map for elements Id's */
-			void refreshData2Elem(map<UInt,UInt> old2new);
+			void refreshData2Elem(const vector<UInt> & old2new);
 	};
 }
 
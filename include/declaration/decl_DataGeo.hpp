@@ -5,6 +5,7 @@
 #define HH_DECLDATAGEO_HH
 
 #include <tuple>
+#include <queue>
 
 namespace geometry
 {
@@ -68,6 +69,20 @@ namespace geometry
 				whether the class requires an update. */
 			Real min_geo, min_disp, min_equi;
 			
+			/*!	For each edge whose cost has been stored, the minima of the
+				three components over its collapsing points. The vector is
+				indexed by the handles of the edges in the connectivity (see
+				bconnect::getEdgeTable()); the edges not stored are marked
+				with the largest representable value. */
+			vector<array<Real,3>> minCosts;
+			
+			/*!	For each component, a max-heap of the per-edge minima stored
+				in minCosts, paired with the handles of the edges, so that the
+				maximum over the current edges is available at any time.
+				Entries are never erased on update: they are discarded when
+				they reach the top and disagree with minCosts. */
+			array<priority_queue<pair<Real,UInt>>,3> maxHeaps;
+			
 			/*!	Boolean saying whether the costs should be re-computed
 				because the maxima have significantly changed. */
 			bool to_update;
@@ -204,6 +219,34 @@ namespace geometry
 			/*!	Get maximum geometric, data displacement and data distribution
 				cost function over the entire mesh. */
 			void getMaximumCosts();
+			
+			/*!	Store the current minima min_geo, min_disp and min_equi
+				for an edge and push them on the max-heaps.
+				
+				\param id1		first end-point of the edge
+				\param id2		second end-point of the edge */
+			void storeMinimumCosts(const UInt & id1, const UInt & id2);
+			
+			/*!	Re-build the max-heaps from the minima stored in minCosts,
+				so to get rid of the stale entries. */
+			void rebuildMaxHeaps();
+			
+			/*!	Get the maximum of a component over the current edges,
+				discarding the stale entries on top of the heap.
+				
+				\param i	geometric (i = 0), data displacement (i = 1)
+							or data distribution (i = 2) cost 
+				\return		the maximum; the lowest representable value
+							if no edge has been stored */
+			Real getRunningMaximum(const UInt & i);
+			
+			/*!	Check whether an entry of a max-heap is out-of-date.
+				
+				\param i	geometric (i = 0), data displacement (i = 1)
+							or data distribution (i = 2) cost 
+				\param e	the entry
+				\return		TRUE if the entry is stale, FALSE otherwise */
+			bool isStale(const UInt & i, const pair<Real,UInt> & e) const;
 						
 			//
 			// Set methods
@@ -273,12 +316,87 @@ namespace geometry
 			Real imp_getCost_f(const UInt & id1, const UInt & id2, const point3d & p,
 				const vector<UInt> & toKeep, const vector<UInt> & toMove) const;
 				
+			/*!	Get cost for collapsing an edge in a point and keep track 
+				of the components for future updating checks.
+				The outcome of the collapse is given by a trial collapse,
+				so the mesh is not supposed to be modified.
+				This method provides the implementation of the method 
+				getCost() of bcost.
+				
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, with the data 
+								already projected
+				\return			the cost */
+			Real imp_getCost(const UInt & id1, const UInt & id2, const point3d & p,
+				const trialCollapse<Triangle, MeshType::DATA> & trial);
+				
+			/*!	Get cost for collapsing an edge in a point.
+				The outcome of the collapse is given by a trial collapse,
+				so the mesh is not supposed to be modified.
+				This method provides the implementation of the method 
+				getCost_f() of bcost.
+				
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, with the data 
+								already projected
+				\return			the cost */
+			Real imp_getCost_f(const UInt & id1, const UInt & id2, const point3d & p,
+				const trialCollapse<Triangle, MeshType::DATA> & trial) const;
+				
+			/*!	Get the geometric, data displacement and data distribution
+				cost functions for collapsing an edge in a point, given 
+				a trial collapse. The components are not normalized.
+				This method provides the implementation of the method 
+				getCostComponents() of bcost.
+				
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, with the data 
+								already projected
+				\return			the three components */
+			array<Real,3> imp_getCostComponents(const UInt & id1, const UInt & id2, 
+				const point3d & p, const trialCollapse<Triangle, MeshType::DATA> & trial) const;
+				
+			/*!	Normalize and combine the components of the cost and keep 
+				track of them for future updating checks.
+				This method provides the implementation of the method 
+				getCost() of bcost.
+				
+				\param cmp	geometric, data displacement and data 
+							distribution cost functions
+				\return		the cost */
+			Real imp_getCost(const array<Real,3> & cmp);
+			
+			/*!	Normalize and combine the components of the cost.
+				This method provides the implementation of the method 
+				getCost_f() of bcost.
+				
+				\param cmp	geometric, data displacement and data 
+							distribution cost functions
+				\return		the cost */
+			Real imp_getCost_f(const array<Real,3> & cmp) const;
+			
+			/*!	Get the memory occupied by Q matrices, original data 
+				locations, quantities of information and running minima.
+				This method provides the implementation of the method 
+				getMemory() of bcost.
+				
+				\param mr	the report */
+			void imp_getMemory(memoryReport & mr) const;
+				
 			//
 			// Updating methods
 			//
 			
-			/*!	Add a collapseInfo object to the list and check if the costs
-				should be re-computed because the maxima have significantly changed.
+			/*!	Notify the class that the cost of an edge has been stored and
+				check if the costs should be re-computed because the maxima have significantly changed.
+				The maxima are tracked through the max-heaps, so they may
+				both increase and decrease.
 				This method provides the implementation of the method 
 				addCollapseInfo() of bcost.
 				
@@ -294,9 +412,31 @@ namespace geometry
 				and all the connections.
 				It provides the implementation of the method update() of bcost.
 				
+				The minima stored for the edges connected to the removed
+				node are dropped; then the edges of the connectivity must
+				not have been updated yet (see bconnect::replaceNodeInEdges()).
+				
 				\param newId	Id of the collapsing point 
+				\param oldId	Id of the removed node
 				\param toRemove	elements insisting on the edge, then to remove */
-			void imp_update(const UInt & newId, const vector<UInt> & toRemove);
+			void imp_update(const UInt & newId, const UInt & oldId, const vector<UInt> & toRemove);
+			
+			/*!	Apply the old-to-new maps given by a refresh of the mesh to
+				the Q matrices, the quantities of information and the minima
+				stored for each edge. The set of edges of the connectivity is
+				supposed to have been re-numbered (see bconnect::getEdgesOld2New()).
+				It provides the implementation of the method refresh() of bcost.
+				
+				\param nodesOld2New	old-to-new map for nodes Id's
+				\param elemsOld2New	old-to-new map for elements Id's */
+			void imp_refresh(const vector<UInt> & nodesOld2New, const vector<UInt> & elemsOld2New);
+			
+			/*!	Apply the old-to-new map given by a re-ordering of the data
+				points to their original locations.
+				It provides the implementation of the method refreshData() of bcost.
+				
+				\param dataOld2New	old-to-new map for data points Id's */
+			void imp_refreshData(const vector<UInt> & dataOld2New);
 			
 			/*!	Check if the costs should be re-computed because the maxima
 				have significantly changed. 
@@ -307,10 +447,34 @@ namespace geometry
 							FALSE otherwise */
 			bool imp_toUpdate() const;
 			
-			/*!	Clear the collapseInfo's list.
+			/*!	Reset the update flag before all the costs get re-computed.
 				This method provides the implementation of the method 
 				clear() of bcost. */
 			void imp_clear(); 
+			
+			/*!	Release the memory not used by the state of the class.
+				The stale entries of the max-heaps are dropped as well.
+				This method provides the implementation of the method 
+				shrinkToFit() of bcost. */
+			void imp_shrinkToFit();
+			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write Q matrices, original data locations, quantities of
+				information, normalizing factors and the running minima
+				in binary format.
+				This method provides the implementation of the method 
+				save() of bcost.
+				\param out	output stream */
+			void imp_save(ostream & out) const;
+			
+			/*!	Read the state of the class from binary format.
+				This method provides the implementation of the method 
+				load() of bcost.
+				\param in	input stream */
+			void imp_load(istream & in);
 	};
 }
 
@@ -142,15 +142,52 @@ namespace geometry
 				\return		the cost */
 			Real imp_getCost_f(const UInt & id1, const UInt & id2, const point3d & p) const;
 			
+			/*!	Get the components of the cost for collapsing an edge in a point.
+				The geometric cost is the only component, while the other two
+				are set to zero.
+				This method provides the implementation of the method 
+				getCostComponents() of bcost.
+				
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, unused
+				\return			the components */
+			array<Real,3> imp_getCostComponents(const UInt & id1, const UInt & id2, 
+				const point3d & p, const trialCollapse<Triangle,MT> & trial) const;
+			
+			/*!	Get cost from its components, i.e. the geometric cost.
+				This method provides the implementation of the methods 
+				getCost() and getCost_f() of bcost.
+				
+				\param cmp	the components
+				\return		the cost */
+			Real imp_getCost(const array<Real,3> & cmp) const;
+			
+			/*!	Get cost from its components, i.e. the geometric cost.
+				As it is implemented, this method performs the same operations
+				of imp_getCost().
+				
+				\param cmp	the components
+				\return		the cost */
+			Real imp_getCost_f(const array<Real,3> & cmp) const;
+			
+			/*!	Get the memory occupied by the list of Q matrices.
+				This method provides the implementation of the method 
+				getMemory() of bcost.
+				
+				\param mr	the report */
+			void imp_getMemory(memoryReport & mr) const;
+			
 			//
 			// Updating methods
 			//
 			
-			/*!	Add a collapseInfo object to the list.
+			/*!	Notify the class that the cost of an edge has been stored.
 				This method provides the implementation of the method 
 				addCollapseInfo() of bcost.
-				Actually, as it is implemented this method is equal to
-				the method addCollapseInfo_f() of bcost.
+				Actually, the class OnlyGeo never requires the costs to be
+				re-computed, then this method does nothing.
 				
 				\param id1	Id of first end-point of the edge
 				\param id2	Id of second end-point of the edge
@@ -167,7 +204,21 @@ namespace geometry
 				\param newId	Id of the collapsing point */
 			void imp_update(const UInt & newId);
 				
-			/*!	Check whether the collapseInfo's list should be re-built.
+			/*!	Apply the old-to-new map for nodes Id's to the list of 
+				Q matrices after a refresh of the mesh.
+				It provides the implementation of the method refresh() of bcost.
+				
+				\param nodesOld2New	old-to-new map for nodes Id's
+				\param elemsOld2New	old-to-new map for elements Id's; unused */
+			void imp_refresh(const vector<UInt> & nodesOld2New, const vector<UInt> & elemsOld2New);
+			
+			/*!	No state depends on the data points Id's, then nothing is done.
+				It provides the implementation of the method refreshData() of bcost.
+				
+				\param dataOld2New	old-to-new map for data points Id's; unused */
+			void imp_refreshData(const vector<UInt> & dataOld2New);
+				
+			/*!	Check whether the costs should be re-computed.
 				This method provides the implementation of the method 
 				toUpdate() of bcost.
 				Actually, the class OnlyGeo never requires the costs to be re-computed,
@@ -176,10 +227,31 @@ namespace geometry
 				\return		FALSE */
 			CONSTEXPR bool imp_toUpdate() const;
 			
-			/*!	Clear the collapseInfo's list.
+			/*!	Reset the class before all the costs get re-computed.
 				This method provides the implementation of the method 
-				clear() of bcost. */
+				clear() of bcost. Actually, it does nothing. */
 			void imp_clear(); 
+			
+			/*!	Release the memory not used by the list of Q matrices.
+				This method provides the implementation of the method 
+				shrinkToFit() of bcost. */
+			void imp_shrinkToFit();
+			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the list of Q matrices in binary format.
+				This method provides the implementation of the method 
+				save() of bcost.
+				\param out	output stream */
+			void imp_save(ostream & out) const;
+			
+			/*!	Read the list of Q matrices from binary format.
+				This method provides the implementation of the method 
+				load() of bcost.
+				\param in	input stream */
+			void imp_load(istream & in);
 	};
 }
 
@@ -4,11 +4,10 @@
 #ifndef HH_DECLBCOST_HH
 #define HH_DECLBCOST_HH
 
-#include <unordered_set>
 #include <tuple>
 
 #include "bmeshOperation.hpp"
-#include "collapseInfo.hpp"
+#include "trialCollapse.hpp"
 
 namespace geometry
 {
@@ -21,19 +20,13 @@ namespace geometry
 		Note that, as required by the CRTP technique, the
 		derived class appears as a template parameter of the class. 
 		
-		All cost classes contain an ordered set of collapseInfo
-		objects. Then, it should be fast to find an edge in the list
-		based on its end-points. 
-		Conversely, the class simplification will contain a set of 
-		collapsingEdge objects ascending-ordered according to their 
-		costs. Then, in simplification should be fast to find an edge 
-		based on its cost.
-		In this sense, bcost and simplification are complementary:
-		when simplification needs to find an edge given its end-points,
-		first it will ask bcost for the cost, then it will look for
-		the cost in its list.
+		The cost classes do not store the computed costs: these are
+		kept by the class simplification in a collapsingQueue, which can
+		be queried both by cost and by edge end-points. The cost classes
+		are just notified whenever a new cost is stored, so that they
+		can possibly require all the costs to be re-computed.
 		
-		\sa collapseInfo.hpp, collapsingInfo.hpp, simplification.hpp */
+		\sa collapsingQueue.hpp, simplification.hpp */
 	template<typename SHAPE, MeshType MT, typename D>
 	class bcost
 	{
@@ -42,10 +35,6 @@ namespace geometry
 				\sa bmeshOperation.hpp */
 			bmeshOperation<SHAPE,MT> * oprtr;
 			
-			/*!	Store info on collapsing edges through
-				an unordered set of collapseInfo objects. */
-			unordered_set<collapseInfo> cInfoList;
-			
 		public:
 			//
 			// Constructors
@@ -65,14 +54,6 @@ namespace geometry
 				\param bmo	pointer to a bmeshOperation object */
 			void setMeshOperation(bmeshOperation<SHAPE,MT> * bmo);
 			
-			//
-			// Access members
-			//
-			
-			/*!	Get list of collapseInfo objects.
-				\return		vector of collapseInfo objects */
-			vector<collapseInfo> getCollapseInfoList() const;
-			
 			//
 			// Get methods
 			//
@@ -131,13 +112,86 @@ namespace geometry
 				of arguments to the implementation. */
 			Real getCost_f(const UInt & id1, const UInt & id2, const point3d & p, 
 				const vector<UInt> & toKeep = {}, const vector<UInt> & toMove = {}) const;
+				
+			/*!	Get cost for collapsing an edge in a point and possibly keep
+				track of the resulting cost(s) for future class updates.
+				Unlike the previous version, the method relies on a trial
+				collapse rather than on a mesh temporarily modified, so that
+				the mesh is not accessed to get the outcome of the collapse.
+				The implementation is delegated to the derived class.
+			
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, with p as collapsing point
+				\return			the cost 
+				
+				\sa trialCollapse.hpp */
+			Real getCost(const UInt & id1, const UInt & id2, const point3d & p, 
+				const trialCollapse<SHAPE,MT> & trial);
+				
+			/*!	Get cost for collapsing an edge in a point without keeping
+				track of the resulting cost(s) for future class updates.
+				The outcome of the collapse is given by a trial collapse.
+				The implementation is delegated to the derived class.
+			
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, with p as collapsing point
+				\return			the cost 
+				
+				\sa trialCollapse.hpp */
+			Real getCost_f(const UInt & id1, const UInt & id2, const point3d & p, 
+				const trialCollapse<SHAPE,MT> & trial) const;
+				
+			/*!	Get the raw components of the cost for collapsing an edge 
+				in a point, i.e. before normalization. The cost can then
+				be re-evaluated from the components whenever the normalization
+				changes, without re-running the trial collapse.
+				The implementation is delegated to the derived class; only
+				cost classes combining several contributions, e.g. DataGeo,
+				are required to provide it.
+			
+				\param id1		Id of first end-point of the edge
+				\param id2		Id of second end-point of the edge
+				\param p		collapsing point
+				\param trial	the trial collapse, with p as collapsing point
+				\return			the components
+				
+				\sa trialCollapse.hpp */
+			array<Real,3> getCostComponents(const UInt & id1, const UInt & id2, 
+				const point3d & p, const trialCollapse<SHAPE,MT> & trial) const;
+				
+			/*!	Get cost from its raw components and keep track of them 
+				for future class updates.
+				The implementation is delegated to the derived class.
+				
+				\param cmp		the components
+				\return			the cost */
+			Real getCost(const array<Real,3> & cmp);
+			
+			/*!	Get cost from its raw components without keeping track 
+				of them for future class updates.
+				The implementation is delegated to the derived class.
+				
+				\param cmp		the components
+				\return			the cost */
+			Real getCost_f(const array<Real,3> & cmp) const;
+			
+			/*!	Get the memory occupied by the state of the class.
+				The implementation is delegated to the derived class.
+				
+				\param mr	the report, whose fields for the cost 
+							class are set */
+			void getMemory(memoryReport & mr) const;
 						
 			//
 			// Updating methods
 			//
 							
-			/*!	Add a collapseInfo object to the list and possible check if the class  
-				requires an update.
+			/*!	Notify the class that the cost of an edge has been stored
+				and possibly check if the class requires an update.
 				The implementation is delegated to the derived class.
 				
 				\param id1	Id of first end-point of the edge
@@ -147,24 +201,6 @@ namespace geometry
 			void addCollapseInfo(const UInt & id1, const UInt & id2, const Real & val,
 				const point3d & p);
 				
-			/*!	Add a collapseInfo object to the list without checking if the class  
-				requires an update. Indeed, "f" stands for "fast".
-				The implementation is delegated to the derived class.
-				
-				\param id1	Id of first end-point of the edge
-				\param id2	Id of second end-point of the edge
-				\param val	collapsing cost
-				\param p	collapsing point */
-			void addCollapseInfo_f(const UInt & id1, const UInt & id2, const Real & val,
-				const point3d & p);
-			
-			/*!	Erase a collapseInfo object from the list.
-				\param id1	Id of first end-point of the edge
-				\param id2	Id of second end-point of the edge
-				\return		TRUE if the edge has been found, FALSE otherwise
-				\return		previously computed cost associated with the edge */
-			pair<bool,Real> eraseCollapseInfo(const UInt & id1, const UInt & id2); 
-			
 			/*!	Update after an edge collapse.
 				This method should be called after having updated the mesh
 				and all the connections.
@@ -187,24 +223,58 @@ namespace geometry
 			void update(const UInt & newId, const UInt & oldId = 0.,
 				const vector<UInt> & toRemove = {});
 				
-			/*!	Check whether the collapseInfo's list should be re-built.
+			/*!	Apply the old-to-new maps given by a refresh of the mesh
+				to the state of the class, so that nothing has to be
+				re-computed.
+				The implementation is delegated to the derived class.
+				
+				\param nodesOld2New	old-to-new map for nodes Id's
+				\param elemsOld2New	old-to-new map for elements Id's */
+			void refresh(const vector<UInt> & nodesOld2New, const vector<UInt> & elemsOld2New);
+			
+			/*!	Apply the old-to-new map given by a re-ordering of the
+				data points to the state of the class.
+				The implementation is delegated to the derived class.
+				
+				\param dataOld2New	old-to-new map for data points Id's */
+			void refreshData(const vector<UInt> & dataOld2New);
+				
+			/*!	Check whether all the costs should be re-computed, e.g. 
+				because their normalization has changed.
 				The implementation is delegated to the derived class.
 				Some derived classes, e.g. OnlyGeo, may never require a re-build. 
 				
-				\return		TRUE if the collapseInfo's list should be re-built,
+				\return		TRUE if the costs should be re-computed,
 							FALSE otherwise */
 			bool toUpdate() const;
 			
-			/*!	Refresh cInfoList by applying an old-to-new map to all nodes Id's.
-				This method should be called any time the underlying mesh gets refreshed,
-				i.e. the inactive nodes and elements are removed.
-				
-				\param old2new	old-to-new map for nodes Id's */
-			void refreshCInfoList(map<UInt,UInt> old2new);
-			
-			/*!	Clear the collapseInfo's list.
+			/*!	Reset the class before all the costs get re-computed.
 				The implementation is delegated to the derived class. */
 			void clear(); 
+			
+			/*!	Release the memory not used by the state of the class,
+				e.g. after a refresh.
+				The implementation is delegated to the derived class. */
+			void shrinkToFit();
+			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the state of the class, e.g. the Q matrices,
+				in binary format.
+				The implementation is delegated to the derived class.
+				
+				\param out	output stream */
+			void save(ostream & out) const;
+			
+			/*!	Read the state of the class from binary format, as written
+				by save(). Nothing is re-computed, so the state should refer
+				to the mesh currently pointed by the operator.
+				The implementation is delegated to the derived class.
+				
+				\param in	input stream */
+			void load(istream & in);
 	};
 }
 
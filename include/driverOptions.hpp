@@ -0,0 +1,97 @@
+/*!	\file	driverOptions.hpp
+	\brief	Class storing the settings of the simplification drivers. */
+
+#ifndef HH_DRIVEROPTIONS_HH
+#define HH_DRIVEROPTIONS_HH
+
+#include <memory>
+
+#include "simplification.hpp"
+
+namespace geometry
+{
+	/*!	This is a merely storing class collecting the settings shared by
+		the executables running the simplification process (see main/),
+		as given by command line. The options specific to an executable
+		(e.g. the weights of DataGeo) are left to the executable itself,
+		which should first pass each option to read().
+
+		\sa simplification.hpp */
+	struct driverOptions
+	{
+		/*!	Path to input file. */
+		string iFile;
+
+		/*!	Path to output file. */
+		string oFile;
+
+		/*!	Target numbers of nodes. */
+		vector<UInt> n;
+
+		/*!	TRUE if one element must be fixed, FALSE otherwise. */
+		bool fixedElem = true;
+
+		/*!	Mode of the collapse queue. */
+		QueueMode qm = QueueMode::ADDRESSABLE;
+
+		/*!	Mode of the structured data search. */
+		SearchMode sm = SearchMode::GRID;
+
+		/*!	TRUE if the cells of the search grid are tuned, FALSE otherwise. */
+		bool autoTuning = false;
+
+		/*!	Number of random edges sampled by the multiple-choice scheduler;
+			if zero, the queue is used. */
+		UInt k = 0;
+
+		/*!	Seed for the multiple-choice scheduler. */
+		UInt seed = 0;
+
+		/*!	Numbers of nodes of the meshes to extract from the collapse log. */
+		vector<UInt> lods;
+
+		/*!	Path to checkpoint file to write. */
+		string cFile;
+
+		/*!	Path to checkpoint file to resume from. */
+		string rFile;
+
+		/*!	Number of collapsed nodes between two checkpoints. */
+		UInt step = 1000;
+
+		/*!	Read an option given by command line.
+			\param option	the option, e.g. -n
+			\param arg		its argument; the comma-separated list of
+							targets is split here
+			\return			TRUE if the option is known, FALSE otherwise */
+		bool read(const char * option, const char * arg);
+
+		/*!	Check that the mandatory settings have been given;
+			if not, an explanatory message is printed.
+			\return	TRUE if the settings are complete, FALSE otherwise */
+		bool check() const;
+
+		/*!	Print the description of the options shared by the executables.
+			\param out	output stream */
+		static void printHelp(ostream & out = cout);
+
+		/*!	Create the simplification object, either from the input file,
+			applying the settings, or from the checkpoint to resume from,
+			whose settings are taken as they are.
+			\return	the object; null if the checkpoint can not be opened */
+		template<MeshType MT, typename CostClass>
+		unique_ptr<simplification<Triangle,MT,CostClass>> getSimplifier() const;
+
+		/*!	Run the simplification process and print the output meshes,
+			i.e. the final mesh, the snapshots and the meshes extracted
+			from the collapse log (see simplification::getSnapshotFile()).
+			\param simplifier	the simplification object */
+		template<MeshType MT, typename CostClass>
+		void run(simplification<Triangle,MT,CostClass> & simplifier) const;
+	};
+}
+
+/*!	Include implementations of class members. */
+#include "implementation/imp_driverOptions.hpp"
+
+#endif
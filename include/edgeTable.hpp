@@ -0,0 +1,215 @@
+/*!	\file	edgeTable.hpp
+	\brief	Class mapping the edges of a mesh to dense and stable handles. */
+
+#ifndef HH_EDGETABLE_HH
+#define HH_EDGETABLE_HH
+
+#include <array>
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+#include "inc.hpp"
+
+namespace geometry
+{
+	/*!	This class maps each edge, given by the Id's of its end-points, to
+		an integer handle. Handles are dense, i.e. they lie in the range
+		[0, getNumHandles()), and stable, i.e. the handle of an edge does not
+		change as long as the edge is in the table. Handles of erased edges
+		are recycled by the following insertions. Then, any information on
+		the edges (e.g. costs, collapsing points or positions in a queue)
+		can be stored in plain vectors indexed by handle.
+
+		The end-points of an edge are sorted, so that the edges (id1,id2)
+		and (id2,id1) are the same, and packed in a 64-bit key to be hashed.
+		The edges are stored in an open-addressing hash table with linear
+		probing and Robin Hood insertion: an entry is allowed to displace
+		an entry closer to its home slot, so to bound the variance of the
+		probe lengths. Lookups then stop as soon as an entry closer to its
+		home slot than the key looked for is found, and the erasure shifts
+		back the following entries, without leaving tombstones.
+		Compared to an unordered_set, no memory is allocated per edge and
+		probing reads contiguous memory.
+
+		\sa bconnect.hpp, collapsingQueue.hpp */
+	class edgeTable
+	{
+		public:
+			/*!	Value marking a missing edge, or the end-points
+				of an erased edge. */
+			static constexpr UInt none = numeric_limits<UInt>::max();
+
+		private:
+			/*!	Slot of the hash table: the end-points of the edge, sorted
+				in ascending order, and its handle. The slot is empty if the
+				first end-point is edgeTable::none. */
+			struct slot
+			{
+				UInt	id1;
+				UInt	id2;
+				UInt	handle;
+			};
+
+			/*!	Minimum number of slots. */
+			static constexpr UInt minNumSlots = 16;
+
+			/*!	The hash table; the number of slots is a power of two. */
+			vector<slot> slots;
+
+			/*!	Number of bits to shift the hashed key by, so to get
+				the home slot. */
+			UInt shift;
+
+			/*!	End-points of the edge associated with each handle. */
+			vector<array<UInt,2>> ends;
+
+			/*!	Handles of erased edges, ready to be recycled. */
+			vector<UInt> freeHandles;
+
+		public:
+			//
+			// Constructor
+			//
+
+			/*!	(Default) constructor.
+				\param n	number of edges to reserve memory for */
+			edgeTable(const UInt & n = 0);
+
+			//
+			// Get methods
+			//
+
+			/*!	Get the number of edges.
+				\return		number of edges */
+			UInt size() const;
+
+			/*!	Check whether the table is empty.
+				\return		TRUE if the table is empty, FALSE otherwise */
+			bool empty() const;
+
+			/*!	Get the number of handles, i.e. an upper bound for the handles
+				of the edges in the table.
+				\return		number of handles */
+			UInt getNumHandles() const;
+
+			/*!	Get the handle of an edge.
+				\param id1	Id of first end-point
+				\param id2	Id of second end-point
+				\return		the handle, or edgeTable::none if the edge
+							is not in the table */
+			UInt find(const UInt & id1, const UInt & id2) const;
+
+			/*!	Check whether a handle refers to an edge in the table.
+				\param h	the handle
+				\return		TRUE if the handle is valid, FALSE otherwise */
+			bool isValid(const UInt & h) const;
+
+			/*!	Get the end-points of an edge.
+				\param h	the handle
+				\return		(min Id, max Id) */
+			const array<UInt,2> & getEnds(const UInt & h) const;
+
+			/*!	Get the end-points of all edges, indexed by handle.
+				Erased edges which have not been recycled yet have
+				both end-points equal to edgeTable::none.
+				\return		vector of end-points */
+			const vector<array<UInt,2>> & getEnds() const;
+
+			/*!	Get the memory occupied by the table.
+				\return		number of bytes */
+			size_t getMemory() const;
+
+			//
+			// Insert and erase methods
+			//
+
+			/*!	Insert an edge, if not already present.
+				\param id1	Id of first end-point
+				\param id2	Id of second end-point
+				\return		the handle of the edge
+				\return		TRUE if the edge has been inserted,
+							FALSE if it was already present */
+			pair<UInt,bool> insert(const UInt & id1, const UInt & id2);
+
+			/*!	Erase an edge.
+				\param id1	Id of first end-point
+				\param id2	Id of second end-point
+				\return		the handle the edge had, or edgeTable::none
+							if the edge was not in the table */
+			UInt erase(const UInt & id1, const UInt & id2);
+
+			/*!	Remove all edges. The memory is not released. */
+			void clear();
+
+			/*!	Reserve memory.
+				\param n	number of edges */
+			void reserve(const UInt & n);
+
+			/*!	Release the memory not used by the edges: the hash table
+				is shrunk to the least number of slots keeping the load
+				factor below 3/4, and the trailing free handles are dropped,
+				so that the handles of the edges in the table are preserved. */
+			void shrinkToFit();
+
+			/*!	Apply an old-to-new map to the end-points of all edges, e.g.
+				after the inactive nodes of the mesh have been removed. The
+				edges with a removed end-point are erased, while the others
+				get dense handles, in the same order as the old ones.
+				\param old2new	old-to-new map for nodes Id's; removed nodes
+								are marked with REMOVED_ID
+				\return			old-to-new map for handles; erased edges
+								are marked with edgeTable::none */
+			vector<UInt> refresh(const vector<UInt> & old2new);
+
+		private:
+			//
+			// Auxiliary methods
+			//
+
+			/*!	Pack the end-points of an edge in a key; with 64-bit
+				indices, the key is not unique to the edge.
+				\param id1	Id of smaller end-point
+				\param id2	Id of larger end-point
+				\return		the key */
+			static uint64_t key(const UInt & id1, const UInt & id2);
+
+			/*!	Pack the end-points stored in a slot in a key.
+				\param s	the slot
+				\return		the key */
+			static uint64_t key(const slot & s);
+
+			/*!	Get the home slot of a key, through Fibonacci hashing.
+				\param k	the key
+				\return		the slot */
+			UInt home(const uint64_t & k) const;
+
+			/*!	Get the distance of a slot from the home slot of its key.
+				\param i	the slot
+				\return		the distance */
+			UInt distance(const UInt & i) const;
+
+			/*!	Find the slot storing an edge.
+				\param id1	Id of smaller end-point
+				\param id2	Id of larger end-point
+				\return		the slot, or edgeTable::none if the edge
+							is not in the table */
+			UInt findSlot(const UInt & id1, const UInt & id2) const;
+
+			/*!	Store an edge in the table through Robin Hood insertion;
+				the edge is supposed not to be in the table.
+				\param s	the slot to store */
+			void place(slot s);
+
+			/*!	Re-build the hash table with a given number of slots.
+				\param n	number of slots; must be a power of two */
+			void rehash(const UInt & n);
+	};
+}
+
+/*!	Include implementations of inlined class members. */
+#ifdef INLINED
+#include "inline/inline_edgeTable.hpp"
+#endif
+
+#endif
@@ -0,0 +1,245 @@
+/*!	\file	flatSet.hpp
+	\brief	A sorted set of values stored in a small contiguous buffer. */
+
+#ifndef HH_FLATSET_HH
+#define HH_FLATSET_HH
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "inc.hpp"
+
+namespace geometry
+{
+	/*!	This class stores a set of distinct values, ascending-ordered,
+		in a contiguous buffer. Up to N values are kept within the object
+		itself; beyond that, the values are moved to a buffer allocated on
+		the heap, whose capacity is doubled any time it gets full.
+
+		Compared to a STL set, lookups are performed by binary search and
+		insertions and deletions shift the following values. For the small
+		sets arising in a mesh connectivity (a node of a triangular mesh is
+		connected to six nodes and six elements on average), this is both
+		faster and far more compact than a red-black tree, whose nodes are
+		allocated one by one.
+
+		The iterators are plain pointers. They are invalidated by any
+		insertion or deletion.
+
+		\param T	type of the values; it must be trivially copyable
+		\param N	number of values stored within the object */
+	template<typename T, UInt N = 8>
+	class flatSet
+	{
+		static_assert(is_trivially_copyable<T>::value,
+			"flatSet can only store trivially copyable values.");
+		static_assert(N > 0, "flatSet requires a non-empty inline buffer.");
+
+		public:
+			using value_type = T;
+			using size_type = UInt;
+			using iterator = T *;
+			using const_iterator = const T *;
+
+		private:
+			/*!	Number of stored values. */
+			UInt sz;
+
+			/*!	Number of values which can be stored without reallocating;
+				if greater than N, the values are on the heap. */
+			UInt cap;
+
+			/*!	Storage: the inline buffer or the pointer to the heap buffer. */
+			union
+			{
+				T buf[N];
+				T * heap;
+			};
+
+		public:
+			//
+			// Constructors and destructor
+			//
+
+			/*!	(Default) constructor. */
+			flatSet();
+
+			/*!	Constructor.
+				\param first	iterator to the first value to insert
+				\param last		iterator past the last value to insert
+
+				The values need neither be sorted nor be distinct. */
+			template<typename InputIt>
+			flatSet(InputIt first, InputIt last);
+
+			/*!	Copy constructor.
+				\param s	another set */
+			flatSet(const flatSet & s);
+
+			/*!	Move constructor.
+				\param s	another set */
+			flatSet(flatSet && s) noexcept;
+
+			/*!	Destructor. */
+			~flatSet();
+
+			//
+			// Operators
+			//
+
+			/*!	Copy assignment operator.
+				\param s	another set
+				\return		updated object */
+			flatSet & operator=(const flatSet & s);
+
+			/*!	Move assignment operator.
+				\param s	another set
+				\return		updated object */
+			flatSet & operator=(flatSet && s) noexcept;
+
+			/*!	The equality operator.
+				\param s1	first set
+				\param s2	second set
+				\return		TRUE if the sets store the same values, FALSE otherwise */
+			template<typename U, UInt M>
+			friend bool operator==(const flatSet<U,M> & s1, const flatSet<U,M> & s2);
+
+			/*!	The inequality operator.
+				\param s1	first set
+				\param s2	second set
+				\return		TRUE if the sets store different values, FALSE otherwise */
+			template<typename U, UInt M>
+			friend bool operator!=(const flatSet<U,M> & s1, const flatSet<U,M> & s2);
+
+			/*!	Less than operator; sets are compared lexicographically,
+				as STL sets do.
+				\param s1	first set
+				\param s2	second set
+				\return		bool saying whether s1 is "less than" s2 or not */
+			template<typename U, UInt M>
+			friend bool operator<(const flatSet<U,M> & s1, const flatSet<U,M> & s2);
+
+			//
+			// Iterators
+			//
+
+			/*!	\return	iterator to the first value */
+			iterator begin();
+
+			/*!	\return	iterator past the last value */
+			iterator end();
+
+			/*!	\return	iterator to the first value */
+			const_iterator begin() const;
+
+			/*!	\return	iterator past the last value */
+			const_iterator end() const;
+
+			/*!	\return	iterator to the first value */
+			const_iterator cbegin() const;
+
+			/*!	\return	iterator past the last value */
+			const_iterator cend() const;
+
+			//
+			// Get methods
+			//
+
+			/*!	Get number of stored values.
+				\return		number of values */
+			UInt size() const;
+
+			/*!	Check whether the set is empty.
+				\return		TRUE if no value is stored, FALSE otherwise */
+			bool empty() const;
+
+			/*!	Get the number of values which can be stored without reallocating.
+				\return		the capacity */
+			UInt capacity() const;
+
+			/*!	Get the memory allocated on the heap.
+				\return		number of bytes; zero if the values are inline */
+			size_t getHeapMemory() const;
+
+			//
+			// Find, insert and erase methods
+			//
+
+			/*!	Find a value.
+				\param val	value to search
+				\return		iterator to the value if found, end() otherwise */
+			iterator find(const T & val);
+
+			/*!	Find a value.
+				\param val	value to search
+				\return		iterator to the value if found, end() otherwise */
+			const_iterator find(const T & val) const;
+
+			/*!	Count the occurrences of a value.
+				\param val	value to search
+				\return		one if the value is stored, zero otherwise */
+			UInt count(const T & val) const;
+
+			/*!	Insert a value.
+				\param val	value to insert
+				\return		pair where the first element is an iterator to
+							the value, while the second element is a bool
+							saying whether the value has been inserted or
+							it was already present */
+			pair<iterator,bool> insert(const T & val);
+
+			/*!	Insert a value, with a hint on its position.
+				When the hint is end() and the value is greater than all
+				stored values, the value is appended in constant time;
+				this makes inserter() as efficient as back_inserter()
+				on sorted ranges.
+				\param hint	iterator to the position before which the value
+							should be inserted
+				\param val	value to insert
+				\return		iterator to the value */
+			iterator insert(const_iterator hint, const T & val);
+
+			/*!	Insert a range of values.
+				\param first	iterator to the first value to insert
+				\param last		iterator past the last value to insert
+
+				The values need neither be sorted nor be distinct. */
+			template<typename InputIt>
+			void insert(InputIt first, InputIt last);
+
+			/*!	Erase a value.
+				\param val	value to erase
+				\return		number of removed values */
+			UInt erase(const T & val);
+
+			/*!	Erase a value.
+				\param it	iterator to the value to erase
+				\return		iterator to the value following the erased one */
+			iterator erase(const_iterator it);
+
+			/*!	Remove all values; the capacity is not released. */
+			void clear();
+
+			/*!	Make room for a given number of values.
+				\param n	desired capacity */
+			void reserve(const UInt & n);
+
+		private:
+			/*!	Get pointer to the storage.
+				\return		pointer to the first value */
+			T * data();
+
+			/*!	Get pointer to the storage.
+				\return		pointer to the first value */
+			const T * data() const;
+
+			/*!	Release the heap buffer, if any, and go back to the inline one. */
+			void release();
+	};
+}
+
+/*!	Include definitions of template members and friend functions. */
+#include "implementation/imp_flatSet.hpp"
+
+#endif
@@ -90,8 +90,9 @@ namespace geometry
 			template<UInt DIM>
 			geoPoint<N>(const geoPoint<DIM> & gp);
 			
-			/*!	Synthetic destructor. */
-			virtual ~geoPoint() = default;
+			/*!	Synthetic destructor. It is not virtual, so that a point
+				does not carry a pointer to a virtual table. */
+			~geoPoint() = default;
 			
 			//
 			// Operators
@@ -100,7 +101,7 @@ namespace geometry
 			/*!	Copy-assignment operator. 
 				\param gp	another point
 				\return		the current point updated */
-			virtual geoPoint & operator=(const geoPoint & gp);
+			geoPoint & operator=(const geoPoint & gp);
 			
 			/*! Sum operator. 
 				\param gpA	first point
@@ -10,13 +10,16 @@
 #include <vector>
 
 #include "inc.hpp"
+#include "flatSet.hpp"
 
 namespace geometry
 {
 	/*! This class represents an element of a generic graph.
 		The element is characterized by an Id and the Id's of the connected
-		elements are stored in a STL set. In this way, the order in which
-		the connected elements are inserted does not matter. 
+		elements are stored in a flatSet, i.e. a sorted small vector whose
+		first values are kept within the object itself. In this way, the order
+		in which the connected elements are inserted does not matter, while
+		no allocation is needed for the typical valence of a mesh node.
 		Connected Id's are ascendig-ordered.  
 		Every operation is carefully performed not to give rise to 
 		duplicated in connected Id's set.
@@ -30,7 +33,7 @@ namespace geometry
 			UInt Id;
 		
 			/*! Id's of connected elements. */
-			set<UInt> conn;
+			flatSet<UInt> conn;
 		
 			/*! Flag
 				<ol>
@@ -58,9 +61,18 @@ namespace geometry
 				\param s	ID's of connected elements */
 			graphItem(const set<UInt> & c, const UInt & ID = 0);
 			
+			/*! Constructor.
+				\param ID	element Id 
+				\param s	ID's of connected elements */
+			graphItem(const flatSet<UInt> & c, const UInt & ID = 0);
+			
 			/*! Synthetic copy constructor.
 				\param g	another graph item */
 			graphItem(const graphItem & g) = default;
+			
+			/*! Synthetic move constructor.
+				\param g	another graph item */
+			graphItem(graphItem && g) = default;
 						
 			//
 			// Operators
@@ -70,6 +82,11 @@ namespace geometry
 				\param g	another graph item
 				\return		updated object */
 			graphItem & operator=(const graphItem & g);
+			
+			/*! Synthetic move assignment operator.
+				\param g	another graph item
+				\return		updated object */
+			graphItem & operator=(graphItem && g) = default;
 						
 			/*! Less than operator. 
 				\param g1	the first graph item
@@ -110,11 +127,30 @@ namespace geometry
 			/*! Get a set with the Id's of connected elements.
 				\return 	Id's of connected elements */
 			vector<UInt> getConnected() const;
+			
+			/*! Get a connected Id.
+				\param i	position of the Id among the (ascending-ordered) connected Id's
+				\return		the Id */
+			const UInt & operator[](const UInt & i) const;
+			
+			/*! Get iterator to the first connected Id; together with end(),
+				it allows to loop over the connected Id's without copying them.
+				\return		the iterator */
+			flatSet<UInt>::const_iterator begin() const;
+			
+			/*! Get iterator past the last connected Id.
+				\return		the iterator */
+			flatSet<UInt>::const_iterator end() const;
 						
 			/*! Get active flag.
 				\return		active flag */
 			bool isActive() const;
 			
+			/*! Get the memory occupied by the item, including the
+				connected Id's spilled on the heap, if any.
+				\return		number of bytes */
+			size_t getMemory() const;
+			
 			//
 			// Set methods
 			//
@@ -134,7 +170,7 @@ namespace geometry
 			void setInactive();
 			
 			//
-			// Find, insert, replace and erase methods
+			// Find, insert, replace, remap and erase methods
 			//
 			
 			/*! Find a connected Id.
@@ -147,7 +183,7 @@ namespace geometry
 				\return		pair where the first element is a bool saying
 							whether the item has been found or not,
 							while the second element is an iterator to the element */
-			pair<set<UInt>::iterator,bool> find(const UInt & val);
+			pair<flatSet<UInt>::iterator,bool> find(const UInt & val);
 						
 			/*! Insert a new Id to the connected elements.
 				\param val	value to insert */
@@ -169,6 +205,15 @@ namespace geometry
 						the method tries to insert newId anyway. */
 			void replace(const UInt & oldId, const UInt & newId);
 									
+			/*!	Apply an old-to-new map to all connected Id's.
+				If the map is increasing on the Id's it keeps, as the maps
+				returned by bmesh::refresh(), the connected Id's are updated
+				in place without sorting; otherwise (e.g. for the maps
+				returned by bmesh::reorder()) they are sorted again.
+				\param old2new	old-to-new map; Id's mapped to REMOVED_ID
+								are erased */
+			void remap(const vector<UInt> & old2new);
+									
 			/*! Erase a connected element.
 				\param val	Id to erase 
 				\return		number of removed elements */
@@ -176,11 +221,23 @@ namespace geometry
 			
 			/*! Erase a connected element.
 				\param it	iterator to the element to erase */
-			void erase(set<UInt>::iterator it);
+			void erase(flatSet<UInt>::iterator it);
 			
 			/*! Clear the set with connected Id's. */
 			void clear();
 			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the item in binary format.
+				\param out	output stream */
+			void save(ostream & out) const;
+			
+			/*!	Read the item from binary format.
+				\param in	input stream */
+			void load(istream & in);
+			
 			//
 			// Common and uncommon connected
 			//
@@ -189,14 +246,14 @@ namespace geometry
 				\param g1	first graph item
 				\param g2	second graph item
 				\return		set of common Id's */
-			friend set<UInt> set_intersection(const graphItem & g1, const graphItem & g2);
+			friend flatSet<UInt> set_intersection(const graphItem & g1, const graphItem & g2);
 			
 			/*! Find the connected Id's shared by an arbitrary number of items.
 				\param g	first graph item
 				\param args	all other graph items
 				\return 	set of common Id's */
 			template<typename... Args>
-			friend set<UInt> set_intersection(const graphItem & g, Args... args);
+			friend flatSet<UInt> set_intersection(const graphItem & g, Args... args);
 			
 			/*! Find the connected Id's shared by two graph items and store them in a vector.
 				\param g1	first graph item
@@ -208,14 +265,14 @@ namespace geometry
 				\param g1	first graph item
 				\param g2	second graph item
 				\return		set of common and uncommon Id's */
-			friend set<UInt> set_union(const graphItem & g1, const graphItem & g2);
+			friend flatSet<UInt> set_union(const graphItem & g1, const graphItem & g2);
 			
 			/*! Find the connected Id's shared by at least one of an arbitrary number of items.
 				\param g	first graph item
 				\param args	all other graph items
 				\return 	set of common and uncommon Id's */
 			template<typename... Args>
-			friend set<UInt> set_union(const graphItem & g, Args... args);
+			friend flatSet<UInt> set_union(const graphItem & g, Args... args);
 			
 			/*! Extend a set of Id's by adding the connected Id's of a graphItem.
 				\param g	the graph item
@@ -232,7 +289,7 @@ namespace geometry
 				\param g1	first graph item
 				\param g2	second graph item
 				\return		set of desired Id's */
-			friend set<UInt> set_difference(const graphItem & g1, const graphItem & g2);
+			friend flatSet<UInt> set_difference(const graphItem & g1, const graphItem & g2);
 			
 			/*! Find the Id's connected to the first item but not to the second one and store them in a vector.
 				\param g1	first graph item
@@ -244,7 +301,7 @@ namespace geometry
 				\param g1	first graph item
 				\param g2	second graph item
 				\return		set of uncommon Id's */
-			friend set<UInt> set_symmetric_difference(const graphItem & g1, const graphItem & g2);
+			friend flatSet<UInt> set_symmetric_difference(const graphItem & g1, const graphItem & g2);
 			
 			/*! Find the connected Id's not shared by two undirected graph items and store them in a vector.
 				\param g1	first graph item
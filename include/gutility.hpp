@@ -9,6 +9,8 @@
 #define HH_GUTILITY_HH
 
 #include <tuple>
+#include <vector>
+#include <cstdint>
 
 #include "point.hpp"
 
@@ -170,6 +172,26 @@ namespace geometry
 			static IntersectionType intSegTri(const point3d & Q, const point3d & R,
 				const point2d & a, const point2d & b, const point2d & c, 
 				const point3d & N, const Real & D, const UInt & x, const UInt & y);
+			
+			//
+			// Space-filling curves
+			//
+			
+			/*!	Get the Morton (Z-order) code of a point, interleaving
+				the bits of its coordinates quantized on 21 bits each.
+				\param p	the point
+				\param SW	South-West point of the box the code refers to
+				\param NE	North-East point of the box the code refers to
+				\return		the code */
+			static uint64_t getMortonCode(const point3d & p, const point3d & SW,
+				const point3d & NE);
+			
+			/*!	Sort a set of points along the Morton curve spanning their
+				bounding box, so that points close in space get close
+				positions. Points with the same code keep their order.
+				\param pts	the points
+				\return		old-to-new map for the points positions */
+			static vector<UInt> getMortonOrder(const vector<point3d> & pts);
 	};
 }
 
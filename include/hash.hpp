@@ -42,9 +42,6 @@ namespace std
 	};
 			
 	/*!	Specialization for boundingBox. */
-	#ifndef __clang__
-	template<>
-	#endif
 	template<UInt N>
 	struct hash<boundingBox<N>>
 	{
@@ -57,8 +57,8 @@ namespace geometry
 		assert(id < this->oprtr->getCPointerToMesh()->getElemsListSize());
 		
 		// Extract the first vertex of the triangle
-		auto elem = this->oprtr->getCPointerToMesh()->getElem(id);
-		auto p = this->oprtr->getCPointerToMesh()->getNode(elem[0]);
+		auto & elem = this->oprtr->getCPointerToMesh()->getElem(id);
+		auto p = this->oprtr->getCPointerToMesh()->getCoor(elem[0]);
 		
 		// Compute unit normal and (signed) distance from the origin
 		// for the plane identified by the triangle
@@ -94,7 +94,7 @@ namespace geometry
 		// of the triangle
 		for (UInt j = 0; j < numElems; ++j)
 		{
-			auto elem = this->oprtr->getCPointerToMesh()->getElem(j);
+			auto & elem = this->oprtr->getCPointerToMesh()->getElem(j);
 			auto K = getKMatrix(j);
 			Qs[elem[0]] += K;
 			Qs[elem[1]] += K;
@@ -256,15 +256,43 @@ namespace geometry
 	}
 	
 	
+	template<MeshType MT>
+	INLINE array<Real,3> OnlyGeo<MT>::imp_getCostComponents(const UInt & id1, 
+		const UInt & id2, const point3d & p, const trialCollapse<Triangle,MT> & trial) const
+	{
+		return {{imp_getCost_f(id1, id2, p), 0., 0.}};
+	}
+	
+	
+	template<MeshType MT>
+	INLINE Real OnlyGeo<MT>::imp_getCost(const array<Real,3> & cmp) const
+	{
+		return cmp[0];
+	}
+	
+	
+	template<MeshType MT>
+	INLINE Real OnlyGeo<MT>::imp_getCost_f(const array<Real,3> & cmp) const
+	{
+		return cmp[0];
+	}
+	
+	
+	template<MeshType MT>
+	INLINE void OnlyGeo<MT>::imp_getMemory(memoryReport & mr) const
+	{
+		mr.Qs = Qs.capacity() * sizeof(array<Real,10>);
+	}
+	
+	
 	//
 	// Updating methods
 	//
 	
 	template<MeshType MT>
-	INLINE void OnlyGeo<MT>::imp_addCollapseInfo(const UInt & id1, const UInt & id2, 
-		const Real & val, const point3d & p)
+	INLINE void OnlyGeo<MT>::imp_addCollapseInfo(const UInt &, const UInt &, 
+		const Real &, const point3d &)
 	{
-		this->cInfoList.emplace(id1, id2, val, p);
 	}
 	
 	
@@ -274,7 +302,7 @@ namespace geometry
 		assert(this->oprtr != nullptr);
 		
 		// Extract the nodes connected to id
-		auto nodes = this->oprtr->getCPointerToConnectivity()->getNode2Node(newId).getConnected();
+		auto & nodes = this->oprtr->getCPointerToConnectivity()->getNode2Node(newId);
 		
 		// 
 		// Re-build Q matrix for the collapsing point
@@ -285,7 +313,7 @@ namespace geometry
 		
 		// Loop over all elements sharing the collapsing point,
 		// compute K and add it to Q
-		auto id_elems = this->oprtr->getCPointerToConnectivity()->getNode2Elem(newId).getConnected();
+		auto & id_elems = this->oprtr->getCPointerToConnectivity()->getNode2Elem(newId);
 		for (auto elem : id_elems)
 			Qs[newId] += getKMatrix(elem);
 		
@@ -301,7 +329,7 @@ namespace geometry
 	
 			// Loop over all elements sharing the node,
 			// compute K and add it to Q
-			auto node_elems = this->oprtr->getCPointerToConnectivity()->getNode2Elem(node).getConnected();
+			auto & node_elems = this->oprtr->getCPointerToConnectivity()->getNode2Elem(node);
 			for (auto elem : node_elems)
 				Qs[node] += getKMatrix(elem);
 		}
@@ -315,10 +343,47 @@ namespace geometry
 	}
 	
 	
+	template<MeshType MT>
+	void OnlyGeo<MT>::imp_refresh(const vector<UInt> & nodesOld2New, const vector<UInt> &)
+	{
+		utility::compact(Qs, nodesOld2New);
+	}
+	
+	
+	template<MeshType MT>
+	INLINE void OnlyGeo<MT>::imp_refreshData(const vector<UInt> &)
+	{
+	}
+	
+	
 	template<MeshType MT>
 	INLINE void OnlyGeo<MT>::imp_clear()
 	{
-		this->cInfoList.clear();
+	}
+	
+	
+	template<MeshType MT>
+	INLINE void OnlyGeo<MT>::imp_shrinkToFit()
+	{
+		Qs.shrink_to_fit();
+	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	template<MeshType MT>
+	void OnlyGeo<MT>::imp_save(ostream & out) const
+	{
+		utility::write(out, Qs);
+	}
+	
+	
+	template<MeshType MT>
+	void OnlyGeo<MT>::imp_load(istream & in)
+	{
+		utility::read(in, Qs);
 	}
 }
 
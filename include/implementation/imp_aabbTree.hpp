@@ -0,0 +1,62 @@
+/*!	\file	imp_aabbTree.hpp
+	\brief	Implementations of template members of class aabbTree. */
+
+#ifndef HH_IMPAABBTREE_HH
+#define HH_IMPAABBTREE_HH
+
+namespace geometry
+{
+	template<typename F>
+	void aabbTree::forEachOverlap(const point3d & SW, const point3d & NE, F f) const
+	{
+		auto overlap = [&](const point3d & sw, const point3d & ne)
+		{
+			return (sw[0] <= NE[0]) && (SW[0] <= ne[0]) &&
+				(sw[1] <= NE[1]) && (SW[1] <= ne[1]) &&
+				(sw[2] <= NE[2]) && (SW[2] <= ne[2]);
+		};
+
+		//
+		// Depth-first traversal
+		//
+		// Since the tree is balanced, its depth is at most
+		// the number of bits of UInt.
+
+		if (!nodes.empty())
+		{
+			array<UInt, 8 * sizeof(UInt)> stack;
+			UInt top(0), n(0);
+			while (true)
+			{
+				auto & nd = nodes[n];
+				if ((nd.SW[0] <= NE[0]) && (SW[0] <= nd.NE[0]) &&
+					(nd.SW[1] <= NE[1]) && (SW[1] <= nd.NE[1]) &&
+					(nd.SW[2] <= NE[2]) && (SW[2] <= nd.NE[2]))
+				{
+					// Go down to the left child, deferring the right one
+					if (nd.right != none)
+					{
+						stack[top++] = nd.right;
+						++n;
+						continue;
+					}
+
+					for (UInt k = nd.first; k < nd.first + nd.count; ++k)
+						if ((boxes[k].getId() != none) && overlap(boxes[k].getSW(), boxes[k].getNE()))
+							f(boxes[k]);
+				}
+
+				if (top == 0)
+					break;
+				n = stack[--top];
+			}
+		}
+
+		// Boxes not in the tree
+		for (auto & bb : extra)
+			if ((bb.getId() != none) && overlap(bb.getSW(), bb.getNE()))
+				f(bb);
+	}
+}
+
+#endif
@@ -41,8 +41,10 @@ namespace geometry
 	template<typename SHAPE, MeshType MT>
 	void bconnect<SHAPE,MT>::buildNode2Node()
 	{
-		// Clear and reserve memory
+		// Clear and reserve memory; by Euler's formula, the edges
+		// are about three times the nodes
 		edges.clear();
+		edges.reserve(3*grid.getNumNodes());
 		node2node.clear();
 		node2node.reserve(grid.getNumNodes());
 					
@@ -70,8 +72,7 @@ namespace geometry
 				node2node[id2].insert(id1);
 									
 				// Update set of edges
-				(id1 < id2) ? edges.emplace(array<UInt,2>({{id1,id2}})) :
-					edges.emplace(array<UInt,2>({{id2,id1}}));
+				edges.insert(id1, id2);
 			}
 		}
 	}
@@ -103,20 +104,63 @@ namespace geometry
 		
 	
 	template<typename SHAPE, MeshType MT>
-	pair<map<UInt,UInt>, map<UInt,UInt>> bconnect<SHAPE,MT>::refresh()
+	void bconnect<SHAPE,MT>::buildEdges()
+	{
+		// Clear the set
+		edges.clear();
+		edges.reserve(3*grid.getNumNodes());
+		
+		// Loop over all elements, as buildNode2Node() does
+		UInt id1, id2;
+		for (UInt id = 0; id < grid.getNumElems(); ++id)
+		{
+			auto & elem = grid.getElem(id);
+			for (UInt j = 0; j < N; j+=2)
+			{
+				id1 = elem[SHAPE::edgeConn[j]];
+				id2 = elem[SHAPE::edgeConn[j+1]];
+				edges.insert(id1, id2);
+			}
+		}
+	}
+		
+	
+	template<typename SHAPE, MeshType MT>
+	pair<vector<UInt>, vector<UInt>> bconnect<SHAPE,MT>::refresh(const bool & keepEdges)
 	{
 		// Refresh the mesh and get old-to-new maps for
 		// both nodes and elements Id's
 		auto old2new = grid.refresh();
 		
-		// Re-build all connections and the set of edges
-		buildNode2Node();
-		buildNode2Elem();
+		// Apply the maps to the connections
+		refresh(node2node, old2new.first, old2new.first);
+		refresh(node2elem, old2new.first, old2new.second);
+		
+		// Either re-build the set of edges or, if kept updated
+		// by the collapses, re-number it
+		if (!keepEdges)
+		{
+			buildEdges();
+			edgesOld2New.clear();
+		}
+		else
+			edgesOld2New = edges.refresh(old2new.first);
 		
 		return old2new;
 	}
 	
 	
+	template<typename SHAPE, MeshType MT>
+	pair<vector<UInt>, vector<UInt>> bconnect<SHAPE,MT>::reorder()
+	{
+		auto old2new = grid.reorder();
+		refresh(node2node, old2new.first, old2new.first);
+		refresh(node2elem, old2new.first, old2new.second);
+		edgesOld2New = edges.refresh(old2new.first);
+		return old2new;
+	}
+	
+	
 	template<typename SHAPE, MeshType MT>
 	void bconnect<SHAPE,MT>::clear()
 	{
@@ -126,6 +170,18 @@ namespace geometry
 				
 		// Clear set of edges
 		edges.clear();
+		edgesOld2New.clear();
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::shrinkToFit()
+	{
+		grid.shrinkToFit();
+		node2node.shrink_to_fit();
+		node2elem.shrink_to_fit();
+		edges.shrinkToFit();
+		edgesOld2New.shrink_to_fit();
 	}
 	
 	
@@ -442,6 +498,20 @@ namespace geometry
 	}
 	
 	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::replaceNodeInEdges(const UInt & oldId, const UInt & newId)
+	{
+		// The node-node connections of oldId are left there
+		// by replaceNodeInNode2Node(), then erase its edges...
+		for (auto id : node2node[oldId])
+			edges.erase(oldId, id);
+		
+		// ... and make sure all the edges of newId are in the set
+		for (auto id : node2node[newId])
+			edges.insert(newId, id);
+	}
+	
+	
 	//
 	// Get methods
 	//
@@ -470,38 +540,76 @@ namespace geometry
 	template<typename SHAPE, MeshType MT>
 	INLINE vector<geoElement<Line>> bconnect<SHAPE,MT>::getEdges() const
 	{
-		return vector<geoElement<Line>>(edges.cbegin(), edges.cend());
+		vector<geoElement<Line>> v;
+		v.reserve(edges.size());
+		for (UInt h = 0; h < edges.getNumHandles(); ++h)
+			if (edges.isValid(h))
+				v.emplace_back(edges.getEnds(h), h);
+		return v;
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	INLINE view<typename vector<array<UInt,2>>::const_iterator> 
+		bconnect<SHAPE,MT>::getEdgesView() const
+	{
+		auto & ends = edges.getEnds();
+		return {ends.cbegin(), ends.cend(), static_cast<UInt>(ends.size())};
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	INLINE const edgeTable & bconnect<SHAPE,MT>::getEdgeTable() const
+	{
+		return edges;
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	INLINE const vector<UInt> & bconnect<SHAPE,MT>::getEdgesOld2New() const
+	{
+		return edgesOld2New;
 	}
 	
 	
 	template<typename SHAPE, MeshType MT>
-	INLINE graphItem bconnect<SHAPE,MT>::getNode2Node(const UInt & Id) const
+	INLINE const graphItem & bconnect<SHAPE,MT>::getNode2Node(const UInt & Id) const
 	{
 		return node2node[Id];
 	}
 	
 	
 	template<typename SHAPE, MeshType MT>
-	INLINE vector<graphItem> bconnect<SHAPE,MT>::getNode2Node() const
+	INLINE const vector<graphItem> & bconnect<SHAPE,MT>::getNode2Node() const
 	{
 		return node2node;
 	}
 	
 	
 	template<typename SHAPE, MeshType MT>
-	INLINE graphItem bconnect<SHAPE,MT>::getNode2Elem(const UInt & Id) const
+	INLINE const graphItem & bconnect<SHAPE,MT>::getNode2Elem(const UInt & Id) const
 	{
 		return node2elem[Id];
 	}
 	
 	
 	template<typename SHAPE, MeshType MT>
-	INLINE vector<graphItem> bconnect<SHAPE,MT>::getNode2Elem() const
+	INLINE const vector<graphItem> & bconnect<SHAPE,MT>::getNode2Elem() const
 	{
 		return node2elem;
 	}
 	
 	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::getMemory(memoryReport & mr) const
+	{
+		grid.getMemory(mr);
+		mr.node2node = getMemory(node2node);
+		mr.node2elem = getMemory(node2elem);
+		mr.edges = edges.getMemory() + edgesOld2New.capacity() * sizeof(UInt);
+	}
+	
+	
 	//
 	// Set methods
 	//
@@ -515,6 +623,91 @@ namespace geometry
 		// (Re-)build connections
 		refresh();
 	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::save(ostream & out) const
+	{
+		grid.save(out);
+		
+		// Write edges
+		utility::write(out, edges.getEnds());
+		
+		// Write connections
+		save(out, node2node);
+		save(out, node2elem);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::load(istream & in)
+	{
+		grid.load(in);
+		
+		// Read edges, skipping the erased ones
+		vector<array<UInt,2>> ids;
+		utility::read(in, ids);
+		edges.clear();
+		edges.reserve(ids.size());
+		for (auto id : ids)
+			if (id[0] != edgeTable::none)
+				edges.insert(id[0], id[1]);
+		edgesOld2New.clear();
+		
+		// Read connections
+		load(in, node2node);
+		load(in, node2elem);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::save(ostream & out, const vector<graphItem> & v)
+	{
+		utility::write(out, static_cast<UInt>(v.size()));
+		for (const auto & item : v)
+			item.save(out);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::load(istream & in, vector<graphItem> & v)
+	{
+		UInt size;
+		utility::read(in, size);
+		v.resize(size);
+		for (auto & item : v)
+			item.load(in);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	size_t bconnect<SHAPE,MT>::getMemory(const vector<graphItem> & v)
+	{
+		size_t res((v.capacity() - v.size()) * sizeof(graphItem));
+		for (const auto & item : v)
+			res += item.getMemory();
+		return res;
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	void bconnect<SHAPE,MT>::refresh(vector<graphItem> & v, const vector<UInt> & itemsOld2New,
+		const vector<UInt> & connOld2New)
+	{
+		// Move the items to their new positions, then
+		// update their Id's and the connected Id's
+		utility::compact(v, itemsOld2New);
+		for (UInt i = 0; i < v.size(); ++i)
+		{
+			v[i].setId(i);
+			if (!connOld2New.empty())
+				v[i].remap(connOld2New);
+		}
+	}
 }
 
 #endif
@@ -32,25 +32,43 @@ namespace geometry
 	
 	
 	//
-	// Access members
+	// Get methods
 	//
 	
 	template<typename SHAPE, MeshType MT, typename D>
-	INLINE vector<collapseInfo> bcost<SHAPE,MT,D>::getCollapseInfoList() const
+	INLINE vector<point> bcost<SHAPE,MT,D>::getPointsList(const UInt & id1, 
+		const UInt & id2) const
 	{
-		return {cInfoList.cbegin(), cInfoList.cend()};
+		return static_cast<const D *>(this)->imp_getPointsList(id1, id2);
 	}
 	
 	
-	//
-	// Get methods
-	//
+	template<typename SHAPE, MeshType MT, typename D>
+	INLINE array<Real,3> bcost<SHAPE,MT,D>::getCostComponents(const UInt & id1, 
+		const UInt & id2, const point3d & p, const trialCollapse<SHAPE,MT> & trial) const
+	{
+		return static_cast<const D *>(this)->imp_getCostComponents(id1, id2, p, trial);
+	}
+	
 	
 	template<typename SHAPE, MeshType MT, typename D>
-	INLINE vector<point> bcost<SHAPE,MT,D>::getPointsList(const UInt & id1, 
-		const UInt & id2) const
+	INLINE Real bcost<SHAPE,MT,D>::getCost(const array<Real,3> & cmp)
 	{
-		return static_cast<const D *>(this)->imp_getPointsList(id1, id2);
+		return static_cast<D *>(this)->imp_getCost(cmp);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT, typename D>
+	INLINE Real bcost<SHAPE,MT,D>::getCost_f(const array<Real,3> & cmp) const
+	{
+		return static_cast<const D *>(this)->imp_getCost_f(cmp);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT, typename D>
+	INLINE void bcost<SHAPE,MT,D>::getMemory(memoryReport & mr) const
+	{
+		static_cast<const D *>(this)->imp_getMemory(mr);
 	}
 		
 	
@@ -68,26 +86,17 @@ namespace geometry
 	
 	
 	template<typename SHAPE, MeshType MT, typename D>
-	INLINE void bcost<SHAPE,MT,D>::addCollapseInfo_f(const UInt & id1, const UInt & id2, 
-		const Real & val, const point3d & p)
+	INLINE void bcost<SHAPE,MT,D>::refresh(const vector<UInt> & nodesOld2New, 
+		const vector<UInt> & elemsOld2New)
 	{
-		cInfoList.emplace(id1, id2, val, p);
+		static_cast<D *>(this)->imp_refresh(nodesOld2New, elemsOld2New);
 	}
 	
 	
 	template<typename SHAPE, MeshType MT, typename D>
-	pair<bool,Real> bcost<SHAPE,MT,D>::eraseCollapseInfo(const UInt & id1, const UInt & id2)
+	INLINE void bcost<SHAPE,MT,D>::refreshData(const vector<UInt> & dataOld2New)
 	{
-		// Find the edge and before erasing it extract the related cost
-		// Correctly handle the case the edge cannot be found
-		auto it = cInfoList.find({id1, id2});
-		if (it != cInfoList.end())
-		{
-			auto val = it->getCost();
-			cInfoList.erase(it);
-			return {true, val};
-		}
-		return {false, -1};
+		static_cast<D *>(this)->imp_refreshData(dataOld2New);
 	}
 	
 	
@@ -99,26 +108,34 @@ namespace geometry
 	
 	
 	template<typename SHAPE, MeshType MT, typename D>
-	void bcost<SHAPE,MT,D>::refreshCInfoList(map<UInt,UInt> old2new)
+	INLINE void bcost<SHAPE,MT,D>::clear()
 	{
-		// Copy cInfoList into an auxiliary container
-		unordered_set<collapseInfo> cInfoList_t(cInfoList.cbegin(), cInfoList.cend());
-		
-		// Clear cInfoList
-		cInfoList.clear();
-		
-		// Re-insert all collapseInfo's to cInfoList, applying the old-to-new
-		// map to the nodes but leaving the costs and the collapsing points unchanged
-		for (auto cInfo : cInfoList_t)
-			cInfoList.emplace(old2new[cInfo.getId1()], old2new[cInfo.getId2()],
-				cInfo.getCost(), cInfo.getCollapsingPoint()); 
+		static_cast<D *>(this)->imp_clear();
 	}
 	
 	
 	template<typename SHAPE, MeshType MT, typename D>
-	INLINE void bcost<SHAPE,MT,D>::clear()
+	INLINE void bcost<SHAPE,MT,D>::shrinkToFit()
 	{
-		static_cast<D *>(this)->imp_clear();
+		static_cast<D *>(this)->imp_shrinkToFit();
+	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	template<typename SHAPE, MeshType MT, typename D>
+	INLINE void bcost<SHAPE,MT,D>::save(ostream & out) const
+	{
+		static_cast<const D *>(this)->imp_save(out);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT, typename D>
+	INLINE void bcost<SHAPE,MT,D>::load(istream & in)
+	{
+		static_cast<D *>(this)->imp_load(in);
 	}
 }
 
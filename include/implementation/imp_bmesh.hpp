@@ -15,6 +15,7 @@
 #include <map>
 
 #include "utility.hpp"
+#include "gutility.hpp"
 
 namespace geometry
 {
@@ -37,7 +38,7 @@ namespace geometry
 	template<typename SHAPE>
 	bmesh<SHAPE>::bmesh(const vector<point> & nds, const vector<geoElement<SHAPE>> & els) :
 		numNodes(nds.size()), numElems(els.size()),
-		nodes(nds.cbegin(), nds.cend()), elems(els.cbegin(), els.cend())
+		nodes(nds), elems(els.cbegin(), els.cend())
 	{
 	}
 	
@@ -72,7 +73,7 @@ namespace geometry
 		// Initialize nodes list
 		nodes.reserve(numNodes);
 		for (UInt i = 0; i < numNodes; ++i)
-			nodes.emplace_back(nds(i,0), nds(i,1), nds(i,2), i);
+			nodes.push_back(array<Real,3>({nds(i,0), nds(i,1), nds(i,2)}));
 			
 		// Initialize elements list
 		elems.reserve(numElems);
@@ -93,21 +94,13 @@ namespace geometry
 	template<typename SHAPE>
 	bmesh<SHAPE> & bmesh<SHAPE>::operator=(const bmesh<SHAPE> & bm)
 	{
-		// Clear nodes and elements lists
-		nodes.clear();
-		elems.clear();
-		
-		// Set the new capacities
-		nodes.reserve(bm.getNumNodes());
-		elems.reserve(bm.getNumElems());
-		
-		// Copy
-		copy(bm.nodes.cbegin(), bm.nodes.cend(), nodes.begin());
-		copy(bm.elems.cbegin(), bm.elems.cend(), elems.begin());
+		// Copy nodes and elements lists
+		nodes = bm.nodes;
+		elems = bm.elems;
 		
 		// Update number of nodes and elements
-		numNodes = nodes.size();
-		numElems = elems.size();
+		numNodes = bm.numNodes;
+		numElems = bm.numElems;
 		
 		return *this;
 	}
@@ -118,8 +111,8 @@ namespace geometry
 	{
 		// Print list of nodes			
 		out << "List of " << bm.getNumNodes() << " nodes:" << endl;
-		for (auto node : bm.nodes)
-			out << node << endl;
+		for (UInt i = 0; i < bm.nodes.size(); ++i)
+			out << bm.nodes[i] << endl;
 			
 		// Print list of elements
 		out << "List of " << bm.getNumElems() << " elements:" << endl;
@@ -143,20 +136,34 @@ namespace geometry
 	
 	template<typename SHAPE>
 	INLINE vector<point> bmesh<SHAPE>::getNodes() const
+	{
+		return nodes.getNodes();
+	}
+	
+	
+	template<typename SHAPE>
+	INLINE const nodeStore & bmesh<SHAPE>::getNodeStore() const
 	{
 		return nodes;
 	}
 	
 	
 	template<typename SHAPE>
-	INLINE geoElement<SHAPE> bmesh<SHAPE>::getElem(const UInt & Id) const
+	INLINE point3d bmesh<SHAPE>::getCoor(const UInt & Id) const
+	{
+		return nodes.getCoor(Id);
+	}
+	
+	
+	template<typename SHAPE>
+	INLINE const geoElement<SHAPE> & bmesh<SHAPE>::getElem(const UInt & Id) const
 	{
 		return elems[Id];
 	}
 	
 	
 	template<typename SHAPE>
-	INLINE vector<geoElement<SHAPE>> bmesh<SHAPE>::getElems() const
+	INLINE const vector<geoElement<SHAPE>> & bmesh<SHAPE>::getElems() const
 	{
 		return elems;
 	}
@@ -193,7 +200,7 @@ namespace geometry
 	template<typename SHAPE>
 	INLINE bool bmesh<SHAPE>::isNodeActive(const UInt & Id) const
 	{
-		return nodes[Id].isActive();
+		return nodes.isActive(Id);
 	}
 	
 	
@@ -204,6 +211,14 @@ namespace geometry
 	}
 	
 	
+	template<typename SHAPE>
+	void bmesh<SHAPE>::getMemory(memoryReport & mr) const
+	{
+		mr.nodes = nodes.getMemory();
+		mr.elems = elems.capacity() * sizeof(geoElement<SHAPE>);
+	}
+	
+	
 	//
 	// Set methods
 	//
@@ -211,7 +226,7 @@ namespace geometry
 	template<typename SHAPE>
 	INLINE void bmesh<SHAPE>::setNode(const UInt & Id, const point & p)
 	{
-		nodes[Id] = p;
+		nodes.set(Id, p);
 	}
 	
 	
@@ -231,7 +246,7 @@ namespace geometry
 		numNodes = 0;
 		for (UInt i = 0; i < nodes.size(); ++i)
 		{
-			if (nodes[i].isActive())
+			if (nodes.isActive(i))
 				++numNodes;
 		}
 	}
@@ -246,7 +261,7 @@ namespace geometry
 		numNodes = 0;
 		for (UInt i = 0; i < nodes.size(); ++i)
 		{
-			if (nodes[i].isActive())
+			if (nodes.isActive(i))
 				++numNodes;
 		}
 	}
@@ -285,16 +300,16 @@ namespace geometry
 	template<typename SHAPE>
 	INLINE void bmesh<SHAPE>::setBoundary(const UInt & Id, const UInt & bound)
 	{
-		nodes[Id].setBoundary(bound);
+		nodes.setBoundary(Id, bound);
 	}
 	
 	
 	template<typename SHAPE>
 	INLINE void bmesh<SHAPE>::setNodeActive(const UInt & Id)
 	{
-		if (!(nodes[Id].isActive()))
+		if (!(nodes.isActive(Id)))
 		{
-			nodes[Id].setActive();
+			nodes.setActive(Id);
 			++numNodes;
 		}
 	}
@@ -303,9 +318,9 @@ namespace geometry
 	template<typename SHAPE>
 	INLINE void bmesh<SHAPE>::setNodeInactive(const UInt & Id)
 	{
-		if (nodes[Id].isActive())
+		if (nodes.isActive(Id))
 		{
-			nodes[Id].setInactive();
+			nodes.setInactive(Id);
 			--numNodes;
 		}
 	}
@@ -347,7 +362,7 @@ namespace geometry
 	template<typename SHAPE>
 	INLINE void bmesh<SHAPE>::insertNode(const array<Real,3> & coor, const UInt & bound)
 	{
-		nodes.emplace_back(coor, nodes.size(), bound);
+		nodes.push_back(coor, bound);
 		++numNodes;
 	}
 	
@@ -374,16 +389,10 @@ namespace geometry
 	template<typename SHAPE>
 	void bmesh<SHAPE>::eraseNode(const UInt & Id)
 	{
-		// Find the node
-		auto it = nodes.begin() + Id;
-		
 		// Before remove it, update number of nodes
-		if (it->isActive())
+		if (nodes.isActive(Id))
 			--numNodes;
-		nodes.erase(it);
-		
-		// Update id's
-		setUpNodesIds();
+		nodes.erase(Id);
 	}
 	
 	
@@ -421,50 +430,24 @@ namespace geometry
 	//
 	
 	template<typename SHAPE>
-	pair<map<UInt,UInt>, map<UInt,UInt>> bmesh<SHAPE>::refresh()
+	pair<vector<UInt>, vector<UInt>> bmesh<SHAPE>::refresh()
 	{
-		// Map from old to new nodes id's
-		map<UInt,UInt> nodes_old2new;
-		map<UInt,UInt> elems_old2new;
-		
-		// Temporary list of (active) nodes and elements
-		vector<point> tmp_nodes;
-		vector<geoElement<SHAPE>> tmp_elems;
-
-		// Reserve memory 
-		tmp_nodes.reserve(numNodes);
-		tmp_elems.reserve(numElems);
+		// Compact the nodes and get the old-to-new map
+		// for their Id's
+		auto nodes_old2new = nodes.compact();
 		
 		//
-		// Build temporary list of nodes
+		// Compact the elements in place
 		//
 		
+		// Map from old to new elements Id's
+		vector<UInt> elems_old2new(elems.size(), REMOVED_ID);
+		
 		// Counter
 		UInt count(0);
 		
-		// Loop on the nodes
-		for (UInt i = 0; i < nodes.size(); ++i)
-		{
-			if (nodes[i].isActive())
-			{
-				// Put the node in the temporary list and set the Id
-				tmp_nodes.push_back(nodes[i]);
-				tmp_nodes[count].setId(count);
-
-				// Update old-to-new map and counter
-				nodes_old2new[i] = count;
-				++count;
-			}
-		}
-		
-		//
-		// Build temporary list of elements
-		//
-		
-		// Reset counter
-		count = 0;
-		
-		// Loop on the elements
+		// Loop on the elements; since count never exceeds i,
+		// the active elements can be moved back in place
 		for (UInt i = 0; i < elems.size(); ++i)
 		{
 			if (elems[i].isActive())
@@ -477,33 +460,67 @@ namespace geometry
 				// Extract the geometrical Id
 				auto gId = elems[i].getGeoId();
 
-				// Insert in the temporary list of elements
-				tmp_elems.emplace_back(ids, count, gId);
+				// Move the element to its new position
+				elems[count] = geoElement<SHAPE>(ids, count, gId);
+				elems[count].setId(count);
 				
 				// Update old-to-new map and counter
 				elems_old2new[i] = count;
 				++count;
 			}
 		}
+		elems.erase(elems.begin() + count, elems.end());
 		
-		//
-		// Set new lists of nodes and elements
-		//
+		return {nodes_old2new, elems_old2new};
+	}
+	
+	
+	template<typename SHAPE>
+	pair<vector<UInt>, vector<UInt>> bmesh<SHAPE>::reorder()
+	{
+		// Sort the nodes
+		vector<point3d> pts;
+		pts.reserve(nodes.size());
+		for (UInt i = 0; i < nodes.size(); ++i)
+			pts.push_back(nodes.getCoor(i));
+		auto nodes_old2new = gutility::getMortonOrder(pts);
 		
-		// Nodes
-		nodes.clear();
-		nodes.reserve(numNodes);
-		copy(tmp_nodes.cbegin(), tmp_nodes.cend(), back_inserter(nodes));
+		// Sort the elements, through their barycenters
+		pts.clear();
+		pts.reserve(elems.size());
+		for (auto & elem : elems)
+		{
+			point3d bar(0.,0.,0.);
+			for (UInt j = 0; j < bmesh<SHAPE>::NV; ++j)
+				bar = bar + nodes.getCoor(elem[j]);
+			pts.push_back(bar / bmesh<SHAPE>::NV);
+		}
+		auto elems_old2new = gutility::getMortonOrder(pts);
 		
-		// Elements
-		elems.clear();
-		elems.reserve(numElems);
-		copy(tmp_elems.cbegin(), tmp_elems.cend(), back_inserter(elems));
+		// Move nodes and elements, then apply
+		// the map for nodes to the vertices
+		nodes.permute(nodes_old2new);
+		utility::compact(elems, elems_old2new);
+		for (UInt i = 0; i < elems.size(); ++i)
+		{
+			array<UInt, bmesh<SHAPE>::NV> ids;
+			for (UInt j = 0; j < bmesh<SHAPE>::NV; ++j)
+				ids[j] = nodes_old2new[elems[i][j]];
+			elems[i] = geoElement<SHAPE>(ids, i, elems[i].getGeoId());
+		}
 		
 		return {nodes_old2new, elems_old2new};
 	}
 	
 	
+	template<typename SHAPE>
+	void bmesh<SHAPE>::shrinkToFit()
+	{
+		nodes.shrinkToFit();
+		elems.shrink_to_fit();
+	}
+	
+	
 	//
 	// Read mesh from file
 	//
@@ -520,9 +537,9 @@ namespace geometry
 			getline(file,line);
 			static_cast<stringstream>(line) >> numNodes >> numElems;
 			
-			// Assert
-			assert(numNodes < MAX_NUM_NODES);
-			assert(numElems < MAX_NUM_ELEMS);
+			// Check the size of the mesh
+			if ((numNodes >= MAX_NUM_NODES) || (numElems >= MAX_NUM_ELEMS))
+				throw runtime_error(filename + " exceeds the maximum size of a mesh.");
 			
 			// Reserve memory
 			nodes.reserve(numNodes);
@@ -540,7 +557,7 @@ namespace geometry
 												>> coor[2];
 												
 				// Insert at back
-				nodes.emplace_back(coor,n);
+				nodes.push_back(coor);
 			}
 			
 			// Insert elements
@@ -597,8 +614,9 @@ namespace geometry
 			getline(file,line);
 			static_cast<stringstream>(line) >> foo >> numNodes;
 						
-			// Assert
-			assert(numNodes < MAX_NUM_NODES);
+			// Check the number of nodes
+			if (numNodes >= MAX_NUM_NODES)
+				throw runtime_error(filename + " exceeds the maximum number of nodes.");
 			
 			// Reserve memory
 			nodes.reserve(numNodes);
@@ -616,7 +634,7 @@ namespace geometry
 				{
 					// Extract coordinates and insert at back
 					ss >> coor[0] >> coor[1] >> coor[2];
-					nodes.emplace_back(coor,id);
+					nodes.push_back(coor);
 					++id;
 					
 					// To handle the case of a space before "\n"					
@@ -633,8 +651,9 @@ namespace geometry
 			getline(file,line);
 			static_cast<stringstream>(line) >> foo >> numElems;
 			
-			// Assert
-			assert(numElems < MAX_NUM_ELEMS);
+			// Check the number of elements
+			if (numElems >= MAX_NUM_ELEMS)
+				throw runtime_error(filename + " exceeds the maximum number of elements.");
 			
 			// Reserve memory
 			elems.reserve(numElems);
@@ -685,8 +704,9 @@ namespace geometry
 				>> foo_r >> foo_r >> foo_r >> foo_r >> foo_r 
 				>> numNodes;
 			
-			// Assert
-			assert(numNodes < MAX_NUM_NODES);
+			// Check the number of nodes
+			if (numNodes >= MAX_NUM_NODES)
+				throw runtime_error(filename + " exceeds the maximum number of nodes.");
 						
 			// Reserve memory
 			nodes.reserve(numNodes);
@@ -702,7 +722,7 @@ namespace geometry
 												>> coor[2];
 												
 				// Insert at back
-				nodes.emplace_back(coor,n);
+				nodes.push_back(coor);
 			}
 			
 			// Skip useless part
@@ -718,11 +738,10 @@ namespace geometry
 			// Get number of elements and reserve memory
 			getline(file,line);
 			static_cast<stringstream>(line) >> numElems;
+			if (numElems >= MAX_NUM_ELEMS)
+				throw runtime_error(filename + " exceeds the maximum number of elements.");
 			elems.reserve(numElems);
 			
-			// Assert
-			assert(numElems < MAX_NUM_ELEMS);
-			
 			// Skip useless part
 			getline(file,line);
 			getline(file,line);
@@ -800,17 +819,104 @@ namespace geometry
 	void bmesh<Quad>::print_inp(const string & filename) const;
 	
 	//
-	// Update Id's
+	// Binary input/output
 	//
 	
 	template<typename SHAPE>
-	void bmesh<SHAPE>::setUpNodesIds()
+	void bmesh<SHAPE>::save(ostream & out) const
 	{
+		utility::write(out, numNodes);
+		utility::write(out, numElems);
+		
+		// Write nodes
+		utility::write(out, static_cast<UInt>(nodes.size()));
 		for (UInt i = 0; i < nodes.size(); ++i)
-			nodes[i].setId(i);
+			savePoint(out, nodes[i]);
+			
+		// Write elements
+		utility::write(out, static_cast<UInt>(elems.size()));
+		for (auto elem : elems)
+		{
+			utility::write(out, elem.getVertices());
+			utility::write(out, elem.getId());
+			utility::write(out, elem.getIdx());
+			utility::write(out, elem.getGeoId());
+			utility::write(out, elem.isActive());
+		}
 	}
 	
-
+	
+	template<typename SHAPE>
+	void bmesh<SHAPE>::load(istream & in)
+	{
+		utility::read(in, numNodes);
+		utility::read(in, numElems);
+		
+		// Read nodes
+		UInt size;
+		utility::read(in, size);
+		nodes.clear();
+		nodes.reserve(size);
+		for (UInt i = 0; i < size; ++i)
+		{
+			point node;
+			loadPoint(in, node);
+			nodes.push_back(node);
+		}
+			
+		// Read elements
+		utility::read(in, size);
+		elems.resize(size);
+		for (auto & elem : elems)
+		{
+			array<UInt,NV> vertices;
+			UInt id, idx, geoId;
+			bool active;
+			utility::read(in, vertices);
+			utility::read(in, id);
+			utility::read(in, idx);
+			utility::read(in, geoId);
+			utility::read(in, active);
+			
+			elem = geoElement<SHAPE>(vertices, id, geoId);
+			elem.setIdx(idx);
+			if (!active)
+				elem.setInactive();
+		}
+	}
+	
+	
+	template<typename SHAPE>
+	void bmesh<SHAPE>::savePoint(ostream & out, const point & p)
+	{
+		utility::write(out, p.getCoor());
+		utility::write(out, p.getId());
+		utility::write(out, p.getBoundary());
+		utility::write(out, p.isActive());
+	}
+	
+	
+	template<typename SHAPE>
+	void bmesh<SHAPE>::loadPoint(istream & in, point & p)
+	{
+		array<Real,3> coor;
+		UInt id, boundary;
+		bool active;
+		utility::read(in, coor);
+		utility::read(in, id);
+		utility::read(in, boundary);
+		utility::read(in, active);
+		
+		p = point(coor, id, boundary);
+		if (!active)
+			p.setInactive();
+	}
+	
+	
+	//
+	// Update Id's
+	//
+	
 	template<typename SHAPE>
 	void bmesh<SHAPE>::setUpElemsIds()
 	{
@@ -116,9 +116,16 @@ namespace geometry
 	//
 	
 	template<typename SHAPE, MeshType MT>
-	INLINE pair<map<UInt,UInt>, map<UInt,UInt>> bmeshInfo<SHAPE,MT>::refresh()
+	INLINE pair<vector<UInt>, vector<UInt>> bmeshInfo<SHAPE,MT>::refresh(const bool & keepEdges)
 	{
-		return connectivity.refresh();
+		return connectivity.refresh(keepEdges);
+	}
+	
+	
+	template<typename SHAPE, MeshType MT>
+	INLINE pair<vector<UInt>, vector<UInt>> bmeshInfo<SHAPE,MT>::reorder()
+	{
+		return connectivity.reorder();
 	}
 	
 	
@@ -144,8 +151,9 @@ namespace geometry
 		(const UInt & id1, const UInt & id2) const
 	{
 		// Get nodes connected both to id1 and id2
-		auto s = set_intersection(connectivity.node2node[id1], connectivity.node2node[id2]);		
-		return {s.cbegin(), s.cend()};
+		vector<UInt> v;
+		set_intersection(connectivity.node2node[id1], connectivity.node2node[id2], v);
+		return v;
 	}
 	
 	
@@ -169,9 +177,9 @@ namespace geometry
 		(const UInt & id1, const UInt & id2) const
 	{
 		// Get elements connected both to id1 and id2
-		auto s = set_intersection(connectivity.node2elem[id1], 
-			connectivity.node2elem[id2]);
-		return vector<UInt>(s.begin(), s.end()); 
+		vector<UInt> v;
+		set_intersection(connectivity.node2elem[id1], connectivity.node2elem[id2], v);
+		return v;
 	}
 	
 	
@@ -180,8 +188,9 @@ namespace geometry
 		(const UInt & id1, const UInt & id2) const
 	{
 		// Get elements connected either to id1 or id2
-		auto s = set_union(connectivity.node2elem[id1], connectivity.node2elem[id2]);
-		return vector<UInt>(s.begin(), s.end()); 
+		vector<UInt> v;
+		set_union(connectivity.node2elem[id1], connectivity.node2elem[id2], v);
+		return v;
 	}
 	
 	
@@ -190,9 +199,9 @@ namespace geometry
 		(const UInt & id1, const UInt & id2) const
 	{
 		// Get elements connected either to id1 or id2, but not both
-		auto s = set_symmetric_difference(connectivity.node2elem[id1], 
-			connectivity.node2elem[id2]);
-		return vector<UInt>(s.begin(), s.end());
+		vector<UInt> v;
+		set_symmetric_difference(connectivity.node2elem[id1], connectivity.node2elem[id2], v);
+		return v;
 	}
 	
 	
@@ -201,12 +210,9 @@ namespace geometry
 	{
 		set<UInt> s;
 		
-		// Extract nodes connected to Id
-		auto nodes = connectivity.node2node[Id].getConnected();
-		
-		// Extract elements connected to each node,
-		// then insert them in the set
-		for (auto node : nodes)
+		// Extract elements connected to each node connected 
+		// to Id, then insert them in the set
+		for (auto node : connectivity.node2node[Id])
 			set_union(connectivity.node2elem[node], s);
 			
 		return {s.cbegin(), s.cend()};
@@ -223,7 +229,7 @@ namespace geometry
 		#endif
 			
 		// Get element 
-		auto elem = connectivity.grid.getElem(Id);
+		auto & elem = connectivity.grid.getElem(Id);
 		
 		// Get elements connected to at least one of the vertices of the element
 		auto s = set_union(connectivity.node2elem[elem[0]],
@@ -240,7 +246,7 @@ namespace geometry
 	vector<UInt> bmeshInfo<SHAPE,MT>::getElemPatch(const UInt & Id) const
 	{
 		// Get element 
-		auto elem = connectivity.grid.getElem(Id);
+		auto & elem = connectivity.grid.getElem(Id);
 		
 		// Get elements connected to at least one of the vertices of the element
 		auto s = set_union(connectivity.node2elem[elem[0]], connectivity.node2elem[elem[1]]);
@@ -270,8 +276,8 @@ namespace geometry
 		assert(Id < connectivity.grid.getElemsListSize());
 		
 		// Get interval length
-		auto elem = connectivity.grid.getElem(Id);
-		return (connectivity.grid.getNode(elem[0]) - connectivity.grid.getNode(elem[1])).norm2();
+		auto & elem = connectivity.grid.getElem(Id);
+		return (connectivity.grid.getCoor(elem[0]) - connectivity.grid.getCoor(elem[1])).norm2();
 	}
 	
 	
@@ -287,10 +293,10 @@ namespace geometry
 		assert(Id < connectivity.grid.getElemsListSize());
 				
 		// Get element vertices
-		auto elem = connectivity.grid.getElem(Id);
-		auto pA = connectivity.grid.getNode(elem[0]);
-		auto pB = connectivity.grid.getNode(elem[1]);
-		auto pC = connectivity.grid.getNode(elem[2]);
+		auto & elem = connectivity.grid.getElem(Id);
+		auto pA = connectivity.grid.getCoor(elem[0]);
+		auto pB = connectivity.grid.getCoor(elem[1]);
+		auto pC = connectivity.grid.getCoor(elem[2]);
 		
 		// Get element area
 		return 0.5 * ((pB - pA)^(pC - pA)).norm2();
@@ -309,10 +315,10 @@ namespace geometry
 		assert(Id < connectivity.grid.getElemsListSize());
 				
 		// Get the element vertices
-		auto elem = connectivity.grid.getElem(Id);
-		auto pA = connectivity.grid.getNode(elem[0]);
-		auto pB = connectivity.grid.getNode(elem[1]);
-		auto pC = connectivity.grid.getNode(elem[2]);
+		auto & elem = connectivity.grid.getElem(Id);
+		auto pA = connectivity.grid.getCoor(elem[0]);
+		auto pB = connectivity.grid.getCoor(elem[1]);
+		auto pC = connectivity.grid.getCoor(elem[2]);
 				
 		// Get element normal
 		return ((pB - pA)^(pC - pB)).normalize();
@@ -327,19 +333,17 @@ namespace geometry
 		point3d NE(aux,aux,aux);
 			
 		// Loop over all nodes and extract the maximum
-		// for each coordinate
-		auto nodes = connectivity.grid.getNodes();
-		for (auto p : nodes)
+		// for each coordinate, reading the coordinates
+		// arrays straight from the store
+		auto & nodes = connectivity.grid.getNodeStore();
+		auto x(nodes.getX()), y(nodes.getY()), z(nodes.getZ());
+		auto flags(nodes.getFlags());
+		for (UInt i = 0; i < nodes.size(); ++i)
 		{
-			if (p.isActive())
-			{
-				if (p[0] > NE[0])
-					NE[0] = p[0];
-				if (p[1] > NE[1])
-					NE[1] = p[1];
-				if (p[2] > NE[2])
-					NE[2] = p[2];
-			}
+			bool active(flags[i] & nodeStore::activeBit);
+			NE[0] = (active && (x[i] > NE[0])) ? x[i] : NE[0];
+			NE[1] = (active && (y[i] > NE[1])) ? y[i] : NE[1];
+			NE[2] = (active && (z[i] > NE[2])) ? z[i] : NE[2];
 		}
 		
 		return NE;
@@ -354,19 +358,17 @@ namespace geometry
 		point3d SW(aux,aux,aux);
 			
 		// Loop over all nodes and extract the minimum
-		// for each coordinate
-		auto nodes = connectivity.grid.getNodes();
-		for (auto p : nodes)
+		// for each coordinate, reading the coordinates
+		// arrays straight from the store
+		auto & nodes = connectivity.grid.getNodeStore();
+		auto x(nodes.getX()), y(nodes.getY()), z(nodes.getZ());
+		auto flags(nodes.getFlags());
+		for (UInt i = 0; i < nodes.size(); ++i)
 		{
-			if (p.isActive())
-			{
-				if (p[0] < SW[0])
-					SW[0] = p[0];
-				if (p[1] < SW[1])
-					SW[1] = p[1];
-				if (p[2] < SW[2])
-					SW[2] = p[2];
-			}
+			bool active(flags[i] & nodeStore::activeBit);
+			SW[0] = (active && (x[i] < SW[0])) ? x[i] : SW[0];
+			SW[1] = (active && (y[i] < SW[1])) ? y[i] : SW[1];
+			SW[2] = (active && (z[i] < SW[2])) ? z[i] : SW[2];
 		}
 		
 		return SW;
@@ -412,15 +414,15 @@ namespace geometry
 			
 		// Loop over all edges to extract the maximum
 		// length along each coordinate
-		auto edges = connectivity.getEdges();
-		for (auto edge : edges)
+		for (auto & edge : connectivity.getEdgesView())
 		{
 			// Make sure the edge exists
-			if (connectivity.grid.isNodeActive(edge[0]) && connectivity.grid.isNodeActive(edge[1]))
+			if ((edge[0] != edgeTable::none) && 
+				connectivity.grid.isNodeActive(edge[0]) && connectivity.grid.isNodeActive(edge[1]))
 			{	
 				// Extract end-points of the edge
-				auto p = connectivity.grid.getNode(edge[0]); 
-				auto q = connectivity.grid.getNode(edge[1]);
+				auto p = connectivity.grid.getCoor(edge[0]); 
+				auto q = connectivity.grid.getCoor(edge[1]);
 
 				// Update dx
 				Real pq_x = abs(p[0] - q[0]);
@@ -446,12 +448,12 @@ namespace geometry
 	template<typename SHAPE, MeshType MT>
 	point3d bmeshInfo<SHAPE,MT>::getElemBarycenter(const UInt & Id) const
 	{
-		auto elem = connectivity.grid.getElem(Id);
+		auto & elem = connectivity.grid.getElem(Id);
 		point3d p(0.,0.,0.);
 		
 		// Loop over all vertices
 		for (UInt i = 0; i < bmeshInfo<SHAPE,MT>::NV; ++i)
-			p = p + connectivity.grid.getNode(elem[i]);
+			p = p + connectivity.grid.getCoor(elem[i]);
 			
 		return (p / static_cast<Real>(bmeshInfo<SHAPE,MT>::NV));
 	}
@@ -465,8 +467,8 @@ namespace geometry
 		// Loop over all nodes
 		for (UInt i = 0; i < connectivity.grid.getNodesListSize(); ++i)
 		{
-			if (connectivity.grid.getNode(i).isActive())
-				p = p + connectivity.grid.getNode(i);
+			if (connectivity.grid.isNodeActive(i))
+				p = p + connectivity.grid.getCoor(i);
 		}
 			
 		return (p / static_cast<Real>(connectivity.grid.getNumNodes()));
@@ -0,0 +1,25 @@
+/*!	\file	imp_cartesianGrid.hpp
+	\brief	Implementations of template members of class cartesianGrid. */
+
+#ifndef HH_IMPCARTESIANGRID_HH
+#define HH_IMPCARTESIANGRID_HH
+
+#include <tuple>
+
+namespace geometry
+{
+	template<typename SHAPE, MeshType MT>
+	cartesianGrid::cartesianGrid(const bmeshInfo<SHAPE,MT> & news)
+	{
+		// Compute North-East and South-West point of the grid
+		tie(NE, SW) = news.getBoundingBoxVertices();
+
+		// Get cells size
+		cellSize = news.getCellSize();
+
+		// Update number of cells
+		updateNumCells();
+	}
+}
+
+#endif
@@ -184,22 +184,43 @@ namespace geometry
 	
 	
 	template<typename SHAPE>
-	pair<map<UInt,UInt>, map<UInt,UInt>> connect<SHAPE, MeshType::DATA>::refresh()
+	pair<vector<UInt>, vector<UInt>> connect<SHAPE, MeshType::DATA>::refresh(const bool & keepEdges)
 	{
-		// Refresh the mesh and get old-to-new maps for
-		// both nodes and elements Id's
-		auto old2new = this->grid.refresh();
+		// Refresh the mesh and the node-node and node-element
+		// connections, and get old-to-new maps for both nodes
+		// and elements Id's
+		auto old2new = bconnect<SHAPE, MeshType::DATA>::refresh(keepEdges);
 		
-		// Re-build all connections and the set of edges
-		this->buildNode2Node();
-		this->buildNode2Elem();
+		// Apply the map for elements to data-element and
+		// element-data connections
 		refreshData2Elem(old2new.second);
-		buildElem2Data();
+		bconnect<SHAPE, MeshType::DATA>::refresh(elem2data, old2new.second);
 		
 		return old2new;
 	}
 				
 	
+	template<typename SHAPE>
+	pair<vector<UInt>, vector<UInt>> connect<SHAPE, MeshType::DATA>::reorder()
+	{
+		auto old2new = bconnect<SHAPE, MeshType::DATA>::reorder();
+		refreshData2Elem(old2new.second);
+		bconnect<SHAPE, MeshType::DATA>::refresh(elem2data, old2new.second);
+		return old2new;
+	}
+	
+	
+	template<typename SHAPE>
+	vector<UInt> connect<SHAPE, MeshType::DATA>::reorderData()
+	{
+		auto old2new = this->grid.reorderData();
+		bconnect<SHAPE, MeshType::DATA>::refresh(data2elem, old2new);
+		for (auto & item : elem2data)
+			item.remap(old2new);
+		return old2new;
+	}
+	
+	
 	template<typename SHAPE>
 	void connect<SHAPE, MeshType::DATA>::clear()
 	{
@@ -209,6 +230,15 @@ namespace geometry
 	}
 	
 	
+	template<typename SHAPE>
+	void connect<SHAPE, MeshType::DATA>::shrinkToFit()
+	{
+		bconnect<SHAPE, MeshType::DATA>::shrinkToFit();
+		data2elem.shrink_to_fit();
+		elem2data.shrink_to_fit();
+	}
+	
+	
 	//
 	// Modify connections
 	//
@@ -298,33 +328,42 @@ namespace geometry
 	//
 	
 	template<typename SHAPE>
-	INLINE graphItem connect<SHAPE, MeshType::DATA>::getData2Elem(const UInt & Id) const
+	INLINE const graphItem & connect<SHAPE, MeshType::DATA>::getData2Elem(const UInt & Id) const
 	{
 		return data2elem[Id];
 	}
 	
 	
 	template<typename SHAPE>
-	INLINE vector<graphItem> connect<SHAPE, MeshType::DATA>::getData2Elem() const
+	INLINE const vector<graphItem> & connect<SHAPE, MeshType::DATA>::getData2Elem() const
 	{
 		return data2elem;
 	}
 	
 	
 	template<typename SHAPE>
-	INLINE graphItem connect<SHAPE, MeshType::DATA>::getElem2Data(const UInt & Id) const
+	INLINE const graphItem & connect<SHAPE, MeshType::DATA>::getElem2Data(const UInt & Id) const
 	{
 		return elem2data[Id];
 	}
 	
 	
 	template<typename SHAPE>
-	INLINE vector<graphItem> connect<SHAPE, MeshType::DATA>::getElem2Data() const
+	INLINE const vector<graphItem> & connect<SHAPE, MeshType::DATA>::getElem2Data() const
 	{
 		return elem2data;
 	}
 	
 	
+	template<typename SHAPE>
+	void connect<SHAPE, MeshType::DATA>::getMemory(memoryReport & mr) const
+	{
+		bconnect<SHAPE, MeshType::DATA>::getMemory(mr);
+		mr.data2elem = bconnect<SHAPE, MeshType::DATA>::getMemory(data2elem);
+		mr.elem2data = bconnect<SHAPE, MeshType::DATA>::getMemory(elem2data);
+	}
+	
+	
 	//
 	// Set methods
 	//
@@ -408,26 +447,39 @@ namespace geometry
 	}
 	
 	
+	//
+	// Binary input/output
+	//
+	
+	template<typename SHAPE>
+	void connect<SHAPE, MeshType::DATA>::save(ostream & out) const
+	{
+		bconnect<SHAPE, MeshType::DATA>::save(out);
+		bconnect<SHAPE, MeshType::DATA>::save(out, data2elem);
+		bconnect<SHAPE, MeshType::DATA>::save(out, elem2data);
+	}
+	
+	
+	template<typename SHAPE>
+	void connect<SHAPE, MeshType::DATA>::load(istream & in)
+	{
+		bconnect<SHAPE, MeshType::DATA>::load(in);
+		bconnect<SHAPE, MeshType::DATA>::load(in, data2elem);
+		bconnect<SHAPE, MeshType::DATA>::load(in, elem2data);
+	}
+	
+	
 	//
 	// Auxiliary refresh methods
 	//
 	
 	template<typename SHAPE>
-	void connect<SHAPE, MeshType::DATA>::refreshData2Elem(map<UInt,UInt> old2new)
+	void connect<SHAPE, MeshType::DATA>::refreshData2Elem(const vector<UInt> & old2new)
 	{
+		// Data are not removed, then only the connected
+		// elements need to be re-mapped
 		for (UInt i = 0; i < this->grid.getNumData(); ++i)
-		{
-			// Extract connected elements
-			auto conn = data2elem[i].getConnected();
-			
-			// Clear the datum
-			data2elem[i].clear();
-			
-			// Apply old-to-new map to connected elements
-			// and insert updated Id's
-			for (auto id : conn)
-				data2elem[i].insert(old2new[id]);
-		}
+			data2elem[i].remap(old2new);
 	}
 }
 
@@ -0,0 +1,53 @@
+/*!	\file	imp_driverOptions.hpp
+	\brief	Implementations of template members of class driverOptions. */
+
+#ifndef HH_IMPDRIVEROPTIONS_HH
+#define HH_IMPDRIVEROPTIONS_HH
+
+#include <fstream>
+
+namespace geometry
+{
+	template<MeshType MT, typename CostClass>
+	unique_ptr<simplification<Triangle,MT,CostClass>> driverOptions::getSimplifier() const
+	{
+		unique_ptr<simplification<Triangle,MT,CostClass>> simplifier;
+		if (rFile.empty())
+		{
+			simplifier.reset(new simplification<Triangle,MT,CostClass>(iFile));
+			simplifier->setQueueMode(qm);
+			simplifier->setSearchMode(sm);
+			simplifier->setAutoTuning(autoTuning);
+			simplifier->setMultipleChoice(k, seed);
+			return simplifier;
+		}
+		
+		ifstream checkpoint(rFile, ios::binary);
+		if (!checkpoint.is_open())
+		{
+			cout << "Checkpoint file " << rFile << " can not be opened. Aborted." << endl;
+			return simplifier;
+		}
+		simplifier.reset(new simplification<Triangle,MT,CostClass>(checkpoint));
+		return simplifier;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void driverOptions::run(simplification<Triangle,MT,CostClass> & simplifier) const
+	{
+		if (!cFile.empty())
+			simplifier.setCheckpoint(cFile, step);
+		if (!lods.empty())
+			simplifier.enableCollapseLog();
+		simplifier.simplify(n, fixedElem, oFile);
+		
+		// Print the intermediate meshes, e.g. output_8000.inp
+		if (!oFile.empty())
+			for (auto m : lods)
+				simplifier.getLevelOfDetail(m).print(
+					simplification<Triangle,MT,CostClass>::getSnapshotFile(oFile, m));
+	}
+}
+
+#endif
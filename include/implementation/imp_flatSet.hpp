@@ -0,0 +1,346 @@
+/*!	\file	imp_flatSet.hpp
+	\brief	Definitions of members and friend functions of class flatSet. */
+
+#ifndef HH_IMPFLATSET_HH
+#define HH_IMPFLATSET_HH
+
+#include <algorithm>
+#include <cstring>
+
+namespace geometry
+{
+	//
+	// Constructors and destructor
+	//
+
+	template<typename T, UInt N>
+	flatSet<T,N>::flatSet() :
+		sz(0), cap(N)
+	{
+	}
+
+
+	template<typename T, UInt N>
+	template<typename InputIt>
+	flatSet<T,N>::flatSet(InputIt first, InputIt last) :
+		flatSet()
+	{
+		insert(first, last);
+	}
+
+
+	template<typename T, UInt N>
+	flatSet<T,N>::flatSet(const flatSet & s) :
+		flatSet()
+	{
+		reserve(s.sz);
+		memcpy(data(), s.data(), s.sz * sizeof(T));
+		sz = s.sz;
+	}
+
+
+	template<typename T, UInt N>
+	flatSet<T,N>::flatSet(flatSet && s) noexcept :
+		flatSet()
+	{
+		*this = move(s);
+	}
+
+
+	template<typename T, UInt N>
+	flatSet<T,N>::~flatSet()
+	{
+		release();
+	}
+
+
+	//
+	// Operators
+	//
+
+	template<typename T, UInt N>
+	flatSet<T,N> & flatSet<T,N>::operator=(const flatSet & s)
+	{
+		if (this != &s)
+		{
+			sz = 0;
+			reserve(s.sz);
+			memcpy(data(), s.data(), s.sz * sizeof(T));
+			sz = s.sz;
+		}
+		return *this;
+	}
+
+
+	template<typename T, UInt N>
+	flatSet<T,N> & flatSet<T,N>::operator=(flatSet && s) noexcept
+	{
+		if (this != &s)
+		{
+			release();
+			if (s.cap > N)
+			{
+				// Steal the heap buffer
+				heap = s.heap;
+				cap = s.cap;
+				s.cap = N;
+			}
+			else
+				memcpy(buf, s.buf, s.sz * sizeof(T));
+			sz = s.sz;
+			s.sz = 0;
+		}
+		return *this;
+	}
+
+
+	template<typename U, UInt M>
+	INLINE bool operator==(const flatSet<U,M> & s1, const flatSet<U,M> & s2)
+	{
+		return (s1.sz == s2.sz) && equal(s1.cbegin(), s1.cend(), s2.cbegin());
+	}
+
+
+	template<typename U, UInt M>
+	INLINE bool operator!=(const flatSet<U,M> & s1, const flatSet<U,M> & s2)
+	{
+		return !(s1 == s2);
+	}
+
+
+	template<typename U, UInt M>
+	INLINE bool operator<(const flatSet<U,M> & s1, const flatSet<U,M> & s2)
+	{
+		return lexicographical_compare(s1.cbegin(), s1.cend(), s2.cbegin(), s2.cend());
+	}
+
+
+	//
+	// Iterators
+	//
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::iterator flatSet<T,N>::begin()
+	{
+		return data();
+	}
+
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::iterator flatSet<T,N>::end()
+	{
+		return data() + sz;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::const_iterator flatSet<T,N>::begin() const
+	{
+		return data();
+	}
+
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::const_iterator flatSet<T,N>::end() const
+	{
+		return data() + sz;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::const_iterator flatSet<T,N>::cbegin() const
+	{
+		return data();
+	}
+
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::const_iterator flatSet<T,N>::cend() const
+	{
+		return data() + sz;
+	}
+
+
+	//
+	// Get methods
+	//
+
+	template<typename T, UInt N>
+	INLINE UInt flatSet<T,N>::size() const
+	{
+		return sz;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE bool flatSet<T,N>::empty() const
+	{
+		return sz == 0;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE UInt flatSet<T,N>::capacity() const
+	{
+		return cap;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE size_t flatSet<T,N>::getHeapMemory() const
+	{
+		return cap > N ? cap * sizeof(T) : 0;
+	}
+
+
+	//
+	// Find, insert and erase methods
+	//
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::iterator flatSet<T,N>::find(const T & val)
+	{
+		auto it = lower_bound(begin(), end(), val);
+		return ((it != end()) && !(val < *it)) ? it : end();
+	}
+
+
+	template<typename T, UInt N>
+	INLINE typename flatSet<T,N>::const_iterator flatSet<T,N>::find(const T & val) const
+	{
+		auto it = lower_bound(cbegin(), cend(), val);
+		return ((it != cend()) && !(val < *it)) ? it : cend();
+	}
+
+
+	template<typename T, UInt N>
+	INLINE UInt flatSet<T,N>::count(const T & val) const
+	{
+		return find(val) != cend();
+	}
+
+
+	template<typename T, UInt N>
+	pair<typename flatSet<T,N>::iterator,bool> flatSet<T,N>::insert(const T & val)
+	{
+		auto pos = lower_bound(cbegin(), cend(), val) - cbegin();
+		if ((pos < sz) && !(val < data()[pos]))
+			return {data() + pos, false};
+
+		// Make room and shift the following values
+		if (sz == cap)
+			reserve(2*cap);
+		auto p = data() + pos;
+		memmove(p + 1, p, (sz - pos) * sizeof(T));
+		*p = val;
+		++sz;
+		return {p, true};
+	}
+
+
+	template<typename T, UInt N>
+	typename flatSet<T,N>::iterator flatSet<T,N>::insert(const_iterator hint, const T & val)
+	{
+		// Append in constant time if the hint is right
+		if ((hint == cend()) && ((sz == 0) || (data()[sz-1] < val)))
+		{
+			if (sz == cap)
+				reserve(2*cap);
+			data()[sz] = val;
+			return data() + (sz++);
+		}
+		return insert(val).first;
+	}
+
+
+	template<typename T, UInt N>
+	template<typename InputIt>
+	void flatSet<T,N>::insert(InputIt first, InputIt last)
+	{
+		// Append the new values, then sort and remove duplicates
+		auto oldSize = sz;
+		for (; first != last; ++first)
+		{
+			if (sz == cap)
+				reserve(2*cap);
+			data()[sz++] = *first;
+		}
+		if (!is_sorted(begin() + oldSize, end()))
+			sort(begin() + oldSize, end());
+		inplace_merge(begin(), begin() + oldSize, end());
+		sz = unique(begin(), end()) - begin();
+	}
+
+
+	template<typename T, UInt N>
+	UInt flatSet<T,N>::erase(const T & val)
+	{
+		auto it = find(val);
+		if (it == end())
+			return 0;
+		erase(it);
+		return 1;
+	}
+
+
+	template<typename T, UInt N>
+	typename flatSet<T,N>::iterator flatSet<T,N>::erase(const_iterator it)
+	{
+		auto p = begin() + (it - cbegin());
+		memmove(p, p + 1, (end() - p - 1) * sizeof(T));
+		--sz;
+		return p;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE void flatSet<T,N>::clear()
+	{
+		sz = 0;
+	}
+
+
+	template<typename T, UInt N>
+	void flatSet<T,N>::reserve(const UInt & n)
+	{
+		if (n <= cap)
+			return;
+
+		// Move the values to a larger heap buffer
+		auto p = new T[n];
+		memcpy(p, data(), sz * sizeof(T));
+		if (cap > N)
+			delete[] heap;
+		heap = p;
+		cap = n;
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	template<typename T, UInt N>
+	INLINE T * flatSet<T,N>::data()
+	{
+		return cap > N ? heap : buf;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE const T * flatSet<T,N>::data() const
+	{
+		return cap > N ? heap : buf;
+	}
+
+
+	template<typename T, UInt N>
+	INLINE void flatSet<T,N>::release()
+	{
+		if (cap > N)
+			delete[] heap;
+		cap = N;
+	}
+}
+
+#endif
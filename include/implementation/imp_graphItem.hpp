@@ -9,28 +9,28 @@
 namespace geometry
 {
 	template<typename... Args>
-	set<UInt> set_intersection(const graphItem & g, Args... args)
+	flatSet<UInt> set_intersection(const graphItem & g, Args... args)
 	{
 		// Find the Id's shared by args
 		auto s = set_intersection(args...);
 		
 		// Make the intersection with g
-		set<UInt> res;
-		set_intersection(g.conn.cbegin(), g.conn.cend(), s.begin(), s.end(), inserter(res, res.begin()));
+		flatSet<UInt> res;
+		set_intersection(g.conn.cbegin(), g.conn.cend(), s.begin(), s.end(), inserter(res, res.end()));
 		
 		return res;
 	}
 	
 	
 	template<typename... Args>
-	set<UInt> set_union(const graphItem & g, Args... args)
+	flatSet<UInt> set_union(const graphItem & g, Args... args)
 	{
 		// Find the Id's shared by at least one of args
 		auto s = set_union(args...);
 		
 		// Make the union with g
-		set<UInt> res;
-		set_union(g.conn.cbegin(), g.conn.cend(), s.begin(), s.end(), inserter(res, res.begin()));
+		flatSet<UInt> res;
+		set_union(g.conn.cbegin(), g.conn.cend(), s.begin(), s.end(), inserter(res, res.end()));
 		
 		return res;
 	}
@@ -57,8 +57,8 @@ namespace geometry
 		// Fill data points list with points coinciding 
 		// with the nodes and associated to a null datum
 		data.reserve(this->nodes.size());
-		for (auto node : this->nodes)
-			data.emplace_back(node);
+		for (UInt i = 0; i < this->nodes.size(); ++i)
+			data.emplace_back(this->nodes[i]);
 	}
 	
 	
@@ -88,8 +88,8 @@ namespace geometry
 		if (data.empty())
 		{
 			data.reserve(this->nodes.size());
-			for (auto node : this->nodes)
-				data.emplace_back(node);
+			for (UInt i = 0; i < this->nodes.size(); ++i)
+				data.emplace_back(this->nodes[i]);
 		}
 	}
 	
@@ -119,8 +119,8 @@ namespace geometry
 		// Fill data points list with points coinciding 
 		// with the nodes and associated to a null datum
 		data.reserve(this->numNodes);
-		for (auto node : this->nodes)
-			data.emplace_back(node);
+		for (UInt i = 0; i < this->nodes.size(); ++i)
+			data.emplace_back(this->nodes[i]);
 	}
 	
 	
@@ -180,8 +180,8 @@ namespace geometry
 		// Update list of data points
 		data.clear();
 		data.reserve(this->nodes.size());
-		for (auto node : this->nodes)
-			data.emplace_back(node);
+		for (UInt i = 0; i < this->nodes.size(); ++i)
+			data.emplace_back(this->nodes[i]);
 			
 		return *this;
 	}
@@ -197,8 +197,8 @@ namespace geometry
 		// Update list of data points
 		data.clear();
 		data.reserve(this->nodes.size());
-		for (auto node : this->nodes)
-			data.emplace_back(node);
+		for (UInt i = 0; i < this->nodes.size(); ++i)
+			data.emplace_back(this->nodes[i]);
 		
 		return *this;
 	}
@@ -224,7 +224,7 @@ namespace geometry
 	//
 	
 	template<typename SHAPE>
-	INLINE dataPoint mesh<SHAPE, MeshType::DATA>::getData(const UInt & Id) const
+	INLINE const dataPoint & mesh<SHAPE, MeshType::DATA>::getData(const UInt & Id) const
 	{
 		return data[Id];
 	}
@@ -237,6 +237,14 @@ namespace geometry
 	}
 	
 	
+	template<typename SHAPE>
+	void mesh<SHAPE, MeshType::DATA>::getMemory(memoryReport & mr) const
+	{
+		bmesh<SHAPE>::getMemory(mr);
+		mr.data = data.capacity() * sizeof(dataPoint);
+	}
+	
+	
 	//
 	// Set methods
 	//
@@ -319,6 +327,64 @@ namespace geometry
 	}
 	
 	
+	template<typename SHAPE>
+	void mesh<SHAPE, MeshType::DATA>::shrinkToFit()
+	{
+		bmesh<SHAPE>::shrinkToFit();
+		data.shrink_to_fit();
+	}
+	
+	
+	template<typename SHAPE>
+	vector<UInt> mesh<SHAPE, MeshType::DATA>::reorderData()
+	{
+		vector<point3d> pts(data.cbegin(), data.cend());
+		auto old2new = gutility::getMortonOrder(pts);
+		utility::compact(data, old2new);
+		setUpDataIds();
+		return old2new;
+	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	template<typename SHAPE>
+	void mesh<SHAPE, MeshType::DATA>::save(ostream & out) const
+	{
+		bmesh<SHAPE>::save(out);
+		
+		// Write data points
+		utility::write(out, static_cast<UInt>(data.size()));
+		for (auto datum : data)
+		{
+			this->savePoint(out, datum);
+			utility::write(out, datum.getDatum());
+		}
+	}
+	
+	
+	template<typename SHAPE>
+	void mesh<SHAPE, MeshType::DATA>::load(istream & in)
+	{
+		bmesh<SHAPE>::load(in);
+		
+		// Read data points
+		UInt size;
+		utility::read(in, size);
+		data.resize(size);
+		for (auto & datum : data)
+		{
+			point p;
+			Real val;
+			this->loadPoint(in, p);
+			utility::read(in, val);
+			datum = dataPoint(p, val);
+		}
+	}
+	
+	
 	//
 	// Update Id's
 	//
@@ -209,7 +209,7 @@ namespace geometry
 		Real Nt = 0.;
 		
 		// Loop over all data associated with the triangle
-		auto data = this->connectivity.getElem2Data(Id).getConnected();
+		auto & data = this->connectivity.getElem2Data(Id);
 		for (auto datum : data)
 		{
 			// Extract number of elements the datum is associated with
@@ -5,6 +5,14 @@
 #define HH_IMPSIMPLIFICATION_HH
 
 #include <unordered_set>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <typeinfo>
+#include <stdexcept>
 #ifdef NDEBUG
 #include <chrono>
 #endif
@@ -19,8 +27,13 @@ namespace geometry
 	simplification<Triangle, MT, CostClass>::simplification
 		(const string & file) :
 		gridOperation(file), costObj(&gridOperation), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
@@ -30,8 +43,13 @@ namespace geometry
 	simplification<Triangle, MT, CostClass>::simplification
 		(const string & file, const Real & wgeo, const Real & wdis, const Real & wequ) :
 		gridOperation(file), costObj(&gridOperation, wgeo, wdis, wequ), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
@@ -42,8 +60,13 @@ namespace geometry
 		(const string & file, const vector<Real> & val, 
 		const Real & wgeo, const Real & wdis, const Real & wequ) :
 		gridOperation(file, val), costObj(&gridOperation, wgeo, wdis, wequ), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
@@ -53,8 +76,13 @@ namespace geometry
 	simplification<Triangle, MT, CostClass>::simplification
 		(const MatrixXd & nds, const MatrixXi & els) :
 		gridOperation(nds, els), costObj(&gridOperation), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
@@ -65,8 +93,13 @@ namespace geometry
 		(const MatrixXd & nds, const MatrixXi & els,
 		const Real & wgeo, const Real & wdis, const Real & wequ) :
 		gridOperation(nds, els), costObj(&gridOperation, wgeo, wdis, wequ), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
@@ -77,8 +110,13 @@ namespace geometry
 		(const MatrixXd & nds, const MatrixXi & els, const MatrixXd & loc,
 		const Real & wgeo, const Real & wdis, const Real & wequ) :
 		gridOperation(nds, els, loc), costObj(&gridOperation, wgeo, wdis, wequ), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
@@ -89,11 +127,36 @@ namespace geometry
 		(const MatrixXd & nds, const MatrixXi & els, const MatrixXd & loc, const VectorXd & val,
 		const Real & wgeo, const Real & wdis, const Real & wequ) :
 		gridOperation(nds, els, loc, val), costObj(&gridOperation, wgeo, wdis, wequ), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
 		structData(gridOperation), intrs(gridOperation.getPointerToMesh()), 
-		dontTouch(true), dontTouchId(0)
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
 	{
 		initialize();
 	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	simplification<Triangle, MT, CostClass>::simplification(istream & in) :
+		costObj(&gridOperation), 
+		collapsingSet(&gridOperation.getCPointerToConnectivity()->getEdgeTable()),
+		structData(gridOperation.getPointerToMesh()), 
+		intrs(gridOperation.getPointerToMesh()), 
+		dontTouch(true), dontTouchId(0), collapsingSetReady(false),
+		numThreads(thread::hardware_concurrency()), numChoices(0), seed(0),
+		numRecomputations(0), numRingRecomputations(0), ringStats(false), logEnabled(false),
+		checkpointStep(0), memoryBudget(0), memoryStep(0), numCompactions(0),
+		reordering(false), resumed(false)
+	{
+		// Important control on coherence between the inputs
+		static_assert(std::is_base_of<bcost<Triangle, MT, CostClass>, CostClass>::value,
+			"CostClass must be coherent with the mesh type.");
+			
+		load(in);
+	}
 		
 	
 	//
@@ -103,89 +166,321 @@ namespace geometry
 	template<MeshType MT, typename CostClass>
 	void simplification<Triangle, MT, CostClass>::setupCollapsingSet()
 	{
-		// Extract edges
-		auto edges = gridOperation.getCPointerToConnectivity()->getEdges();
+		// Extract edges, skipping the erased ones
+		auto edges = gridOperation.getCPointerToConnectivity()->getEdgesView();
+		vector<pair<UInt,UInt>> ids;
+		ids.reserve(edges.size());
+		for (auto & edge : edges)
+			if (edge[0] != edgeTable::none)
+				ids.emplace_back(edge[0], edge[1]);
 	
-		// Loop on the edges list and for each edge take the cost
-		// information and add it to the lists
-		#ifdef NDEBUG
-			UInt barWidth(40), numEdges(edges.size()), counter(0);
-		#endif
-		for (auto edge : edges) 
-		{
-			getCost_f(edge[0], edge[1]);
-			
-			#ifdef NDEBUG
-				// Update progress bar
-				++counter;
-				Real progress(counter / (static_cast<Real>(numEdges)));
-				cout << "Setup                         [";
-				UInt pos(barWidth * progress);
-				for (UInt i = 0; i < barWidth; ++i) 
-				{
-					if (i < pos) 
-						cout << "=";
-					else if (i == pos) 
-						cout << ">";
-					else 
-						cout << " ";
-				}
-				cout << "] " << UInt(progress * 100.0) << " %\r";
-				cout.flush();
-			#endif
-		}
-		#ifdef NDEBUG
-			cout << endl;
-		#endif
+		// Compute the cost information for all edges and 
+		// add them to the queue at once
+		array<Real,3> minCmp;
+		collapsingSet.insert(getCollapsingEdges(ids, true, &minCmp));
+		collapsingSetReady = true;
+		
+		// Let the CostClass object accumulate the minima over
+		// all the collapsing points tried, as a serial setup does
+		costObj.getCost(minCmp);
 	}
 	
 	
 	template<MeshType MT, typename CostClass>
 	void simplification<Triangle, MT, CostClass>::rebuildCollapsingSet()
 	{
-		// Clear the list of collapseInfo's
+		// Reset the CostClass object
 		costObj.clear();
 		 
-		// Copy current collapsingEdge's list to a temporary one
-		// and clear collapsingEdge's list
-		set<collapsingEdge> tmp_collapsingSet(collapsingSet.cbegin(), 
-			collapsingSet.cend());
+		// Copy current edges to a temporary list and clear the queue
+		auto tmp_collapsingSet = collapsingSet.getEdges();
 		collapsingSet.clear();
+		vector<pair<UInt,UInt>> ids;
+		ids.reserve(tmp_collapsingSet.size());
+		for (auto edge : tmp_collapsingSet)
+			ids.emplace_back(edge.getId1(), edge.getId2());
 	
-		// Loop on the edges list and for each edge take the cost
-		// information and add it to a temporary list
-		for (auto edge : tmp_collapsingSet) 
-			getCost_f(edge.getId1(), edge.getId2()); 
+		// Compute the cost information for all edges and 
+		// add them to the queue at once
+		array<Real,3> minCmp;
+		collapsingSet.insert(getCollapsingEdges(ids, false, &minCmp));
+		
+		// Let the CostClass object accumulate the minima over
+		// all the collapsing points tried, as a serial rebuild does
+		costObj.getCost(minCmp);
 	}
 	
 	
 	template<MeshType MT, typename CostClass>
-	void simplification<Triangle, MT, CostClass>::initialize()
+	void simplification<Triangle, MT, CostClass>::rescaleCollapsingSet()
+	{
+		// Reset the CostClass object
+		costObj.clear();
+		
+		// Re-evaluate the costs from the stored components, 
+		// then restore the heap property at once
+		collapsingSet.rekey([this](const collapsingEdge & cEdge)
+			{ return costObj.getCost_f(cEdge.getComponents()); });
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	vector<collapsingEdge> simplification<Triangle, MT, CostClass>::getCollapsingEdges
+		(const vector<pair<UInt,UInt>> & edges, const bool & progress, 
+		array<Real,3> * minCmp) const
 	{
+		// Each slot is written by exactly one thread,
+		// so no synchronization is needed on the results
+		vector<collapsingEdge> cEdges(edges.size());
+		vector<char> found(edges.size(), 0);
+		
+		// The edges are handed out in chunks: a thread
+		// takes the next chunk as soon as it is done
+		// with the previous one
+		static constexpr UInt chunkSize = 64;
+		atomic<UInt> next(0), done(0);
+		
+		// No more threads than chunks are employed; each thread 
+		// keeps its own minima of the cost components
+		UInt nt(max<UInt>(min<UInt>(numThreads, (edges.size() + chunkSize - 1) / chunkSize), 1));
+		vector<array<Real,3>> minima(nt, {{numeric_limits<Real>::max(),
+			numeric_limits<Real>::max(), numeric_limits<Real>::max()}});
+		
+		// The calling thread is the one with index zero
+		auto work = [&](const UInt t)
+		{
+			#ifdef NDEBUG
+				UInt barWidth(40), numEdges(edges.size());
+			#endif
+			for (UInt first = next.fetch_add(chunkSize); first < edges.size(); 
+				first = next.fetch_add(chunkSize))
+			{
+				UInt last(min<UInt>(first + chunkSize, edges.size()));
+				for (UInt i = first; i < last; ++i)
+					found[i] = getCollapsingEdge(edges[i].first, edges[i].second, cEdges[i],
+						minCmp ? &minima[t] : nullptr);
+				done += last - first;
+				
+				// Update progress bar; only the calling thread prints
+				if ((t != 0) || !progress)
+					continue;
+				#ifdef NDEBUG
+					Real pr(done / (static_cast<Real>(numEdges)));
+					cout << "Setup                         [";
+					UInt pos(barWidth * pr);
+					for (UInt i = 0; i < barWidth; ++i) 
+					{
+						if (i < pos) 
+							cout << "=";
+						else if (i == pos) 
+							cout << ">";
+						else 
+							cout << " ";
+					}
+					cout << "] " << UInt(pr * 100.0) << " %\r";
+					cout.flush();
+				#endif
+			}
+		};
+		
+		// Launch the workers, then let the calling thread work as well
+		vector<thread> workers;
+		for (UInt t = 1; t < nt; ++t)
+			workers.emplace_back(work, t);
+		work(0);
+		for (auto & w : workers)
+			w.join();
 		#ifdef NDEBUG
-			using namespace std::chrono;
-			high_resolution_clock::time_point start, stop;
+			if (progress)
+				cout << endl;
 		#endif
 		
+		// Gather the minima; being minima, they 
+		// do not depend on the number of threads
+		if (minCmp)
+		{
+			*minCmp = minima[0];
+			for (auto & m : minima)
+				for (UInt i = 0; i < 3; ++i)
+					(*minCmp)[i] = min((*minCmp)[i], m[i]);
+		}
+			
+		// Keep only the edges which can be collapsed,
+		// preserving the input order
+		UInt j(0);
+		for (UInt i = 0; i < edges.size(); ++i)
+			if (found[i])
+				cEdges[j++] = cEdges[i];
+		cEdges.resize(j);
+		
+		return cEdges;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	bool simplification<Triangle, MT, CostClass>::getRandomCollapsingEdge
+		(mt19937 & engine, collapsingEdge & cEdge) const
+	{
+		auto grid = gridOperation.getCPointerToMesh();
+		auto conn = gridOperation.getCPointerToConnectivity();
+		uniform_int_distribution<UInt> nodeDist(0, grid->getNodesListSize()-1);
+		
+		bool found(false);
+		for (UInt i = 0; i < numChoices; ++i)
+		{
+			// Sample an active node...
+			UInt id1;
+			do
+				id1 = nodeDist(engine);
+			while (!grid->isNodeActive(id1));
+			
+			// ... and one of its neighbours
+			auto & nodes = conn->getNode2Node(id1);
+			if (nodes.size() == 0)
+				continue;
+			uniform_int_distribution<UInt> neighbourDist(0, nodes.size()-1);
+			UInt id2(nodes[neighbourDist(engine)]);
+			
+			// Compute the cost and possibly keep the edge
+			collapsingEdge candidate;
+			if (getCollapsingEdge(min(id1,id2), max(id1,id2), candidate) &&
+				(!found || (candidate < cEdge)))
+			{
+				cEdge = candidate;
+				found = true;
+			}
+		}
+		
+		return found;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::getCloseElems(const vector<UInt> & elems,
+		vector<UInt> & res) const
+	{
+		res.clear();
+		if (elems.empty())
+			return;
+		
+		// Bounding box of the whole patch, built upon
+		// the current position of the nodes
+		auto box = structData.getBoundingBox(elems[0]);
+		point3d SW(box.getSW()), NE(box.getNE());
+		for (auto elem : elems)
+		{
+			auto bb = structData.getBoundingBox(elem);
+			for (UInt j = 0; j < 3; ++j)
+			{
+				SW[j] = min(SW[j], bb.getSW()[j]);
+				NE[j] = max(NE[j], bb.getNE()[j]);
+			}
+		}
+		
+		// A single query for the whole patch
+		structData.getNeighbouringElements(bbox3d(SW, NE), {}, {}, res);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::getDirtyEdges(const UInt & id1,
+		const vector<UInt> & closeElems, const vector<UInt> & dataElems, 
+		edgeTable & invEdges) const
+	{
+		auto grid = gridOperation.getCPointerToMesh();
+		auto conn = gridOperation.getCPointerToConnectivity();
+		
+		//
+		// Extract the nodes whose incident edges must be re-computed
+		//
+		
+		// The collapsing node and the nodes connected to it:
+		// their Q matrices and incident triangles have changed
+		unordered_set<UInt> ring;
+		ring.insert(id1);
+		auto & id1Conn = conn->getNode2Node(id1);
+		ring.insert(id1Conn.begin(), id1Conn.end());
+		vector<UInt> nodes(ring.cbegin(), ring.cend());
+		
+		// The vertices of the elements which may intersect the patch,
+		// either before or after the collapse: the self-intersection
+		// test for the collapse of their edges may give a different
+		// result. These are taken however far from the collapsing node,
+		// otherwise the verdicts cached in the queue would go stale
+		for (auto elem : closeElems)
+			for (auto vertex : grid->getElem(elem).getVertices())
+				if (grid->isNodeActive(vertex))
+					nodes.push_back(vertex);
+		
+		// The vertices of the elements whose quantity of information
+		// has changed
+		for (auto elem : dataElems)
+			for (auto vertex : grid->getElem(elem).getVertices())
+				if (grid->isNodeActive(vertex))
+					nodes.push_back(vertex);
+		
+		//
+		// Save the edges incident to these nodes
+		//
+		// A node may have been taken more than once, then the
+		// duplicates are dropped first
+		
+		sort(nodes.begin(), nodes.end());
+		nodes.erase(unique(nodes.begin(), nodes.end()), nodes.end());
+		for (auto node_i : nodes)
+		{
+			auto & iConn = conn->getNode2Node(node_i);
+			for (auto node_j : iConn)
+				invEdges.insert(node_i, node_j);
+		}
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::getRingEdges(const UInt & id,
+		const UInt & numRings, edgeTable & edges) const
+	{
+		auto conn = gridOperation.getCPointerToConnectivity();
+		
+		// Extract the nodes within numRings rings, ring by ring
+		unordered_set<UInt> nodes{id};
+		vector<UInt> front{id};
+		for (UInt r = 0; r < numRings; ++r)
+		{
+			vector<UInt> next;
+			for (auto node_i : front)
+			{
+				auto & iConn = conn->getNode2Node(node_i);
+				for (auto node_j : iConn)
+					if (nodes.insert(node_j).second)
+						next.push_back(node_j);
+			}
+			front.swap(next);
+		}
+		
+		// Save the edges incident to these nodes
+		for (auto node_i : nodes)
+		{
+			auto & iConn = conn->getNode2Node(node_i);
+			for (auto node_j : iConn)
+				edges.insert(node_i, node_j);
+		}
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::initialize()
+	{
 		// Important control on coherence between the inputs:
 		// error if the CostClass supports distributed data but the
 		// mesh is purely geometrical
 		static_assert(std::is_base_of<bcost<Triangle, MT, CostClass>, CostClass>::value,
 			"CostClass must be coherent with the mesh type.");
 
-		// Create the set of collapsingEdge's ordered by cost
-		#ifndef NDEBUG
-			cout << "Initialize list of edges ordered by the associated collapsing cost ... ";
-			setupCollapsingSet();
-			cout << "done" << endl;
-		#else
-			start = high_resolution_clock::now();
-			setupCollapsingSet();
-			stop = high_resolution_clock::now();
-			auto dif_collapsingSet = duration_cast<milliseconds>(stop-start).count();
-			cout << "Setup for the simplification process completed in " << dif_collapsingSet/1000 << " seconds." << endl;
-		#endif
-
+		// The set of collapsingEdge's ordered by cost is created
+		// by simplify(), since it is not needed by the multiple-choice
+		// scheduler
+		
 		// Define the fixed element
 		findDontTouchId();
 	}
@@ -193,41 +488,214 @@ namespace geometry
 	
 	template<MeshType MT, typename CostClass>
 	void simplification<Triangle, MT, CostClass>::refreshCollapsingSet
-		(map<UInt,UInt> old2new)
+		(const vector<UInt> & old2new)
 	{
-		// Copy collapsingSet into an auxiliary container
-		set<collapsingEdge> collapsingSet_t(collapsingSet.cbegin(), collapsingSet.cend());
-		
-		// Clear collapsingSet
-		collapsingSet.clear();
-		
-		// Re-insert all collapsingEdge's to collapsingSet, applying the old-to-new
-		// map to the nodes but leaving the costs and the collapsing points unchanged
-		for (auto cEdge : collapsingSet_t)
-			collapsingSet.emplace(old2new[cEdge.getId1()], old2new[cEdge.getId2()],
-				cEdge.getCost(), cEdge.getCollapsingPoint()); 
+		// Apply the old-to-new map to the nodes but leave
+		// the costs and the collapsing points unchanged
+		collapsingSet.refresh(old2new);
 	}
 	
 	
 	template<MeshType MT, typename CostClass>
 	void simplification<Triangle, MT, CostClass>::refresh()
 	{
-		// Remove inactive nodes and elements from grid
-		gridOperation.getPointerToMesh()->refresh();
+		// Remove inactive nodes and elements from grid and
+		// apply the old-to-new maps to the connectivity; the
+		// set of edges is re-numbered, since the queue and the
+		// CostClass object refer to its handles
+		auto old2new = gridOperation.refresh(true);
+		
+		// Apply the maps to the state of the CostClass object
+		// and to collapsingSet, rather than re-computing them
+		costObj.refresh(old2new.first, old2new.second);
+		refreshCollapsingSet(old2new.first);
 		
-		// Re-build connectivity
-		gridOperation.getPointerToConnectivity()->refresh();
+		// Update fixed element
+		dontTouchId = old2new.second[dontTouchId];
 		
-		// Possibly update CostClass object and re-build
-		// set of collapsingEdge's
-		costObj.setMeshOperation(&gridOperation);
-		setupCollapsingSet();
+		// Possibly re-order the mesh; the collapse log
+		// refers to the Id's of the original mesh
+		if (reordering && !logEnabled)
+			reorder();
 		
 		// Update structured data
 		structData.setMesh(gridOperation);
+	}
+	
+	
+	//
+	// Get methods
+	//
+	
+	template<MeshType MT, typename CostClass>
+	INLINE const mesh<Triangle,MT> * simplification<Triangle, MT, CostClass>::
+		getCPointerToMesh() const
+	{
+		return this->gridOperation.getCPointerToMesh();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE const connect<Triangle,MT> * simplification<Triangle, MT, CostClass>::
+		getCPointerToConnectivity() const
+	{
+		return this->gridOperation.getCPointerToConnectivity();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE const bmeshOperation<Triangle,MT> * simplification<Triangle, MT, CostClass>::
+		getCPointerToMeshOperator() const
+	{
+		return &this->gridOperation;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE QueueMode simplification<Triangle, MT, CostClass>::getQueueMode() const
+	{
+		return collapsingSet.getMode();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE SearchMode simplification<Triangle, MT, CostClass>::getSearchMode() const
+	{
+		return structData.getSearchMode();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE bool simplification<Triangle, MT, CostClass>::isAutoTuning() const
+	{
+		return structData.isAutoTuning();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getNumThreads() const
+	{
+		return numThreads;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getNumChoices() const
+	{
+		return numChoices;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getSeed() const
+	{
+		return seed;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE string simplification<Triangle, MT, CostClass>::getCheckpointFile() const
+	{
+		return checkpointFile;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getCheckpointStep() const
+	{
+		return checkpointStep;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getNumRecomputations() const
+	{
+		return numRecomputations;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE long simplification<Triangle, MT, CostClass>::getNumSavedRecomputations() const
+	{
+		return static_cast<long>(numRingRecomputations) - static_cast<long>(numRecomputations);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE bool simplification<Triangle, MT, CostClass>::getRingStatistics() const
+	{
+		return ringStats;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	UInt simplification<Triangle, MT, CostClass>::getNumStaleEdges() const
+	{
+		UInt numStale(0);
+		collapsingEdge cEdge;
+		for (auto & edge : gridOperation.getCPointerToConnectivity()->getEdgesView())
+			if ((edge[0] != edgeTable::none) &&
+				(getCollapsingEdge(edge[0], edge[1], cEdge) != 
+				collapsingSet.find(edge[0], edge[1])))
+				++numStale;
+		return numStale;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE size_t simplification<Triangle, MT, CostClass>::getMemoryBudget() const
+	{
+		return memoryBudget;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getMemoryStep() const
+	{
+		return memoryStep;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE UInt simplification<Triangle, MT, CostClass>::getNumCompactions() const
+	{
+		return numCompactions;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE bool simplification<Triangle, MT, CostClass>::getReordering() const
+	{
+		return reordering;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	memoryReport simplification<Triangle, MT, CostClass>::memoryUsage() const
+	{
+		// Mesh and connections
+		memoryReport mr;
+		gridOperation.getCPointerToConnectivity()->getMemory(mr);
+		
+		// Structured data, queue and CostClass object
+		mr.boxes = structData.getMemory();
+		mr.collapsingSet = collapsingSet.getMemory();
+		costObj.getMemory(mr);
+		
+		// Collapse log, with the copy of the original mesh
+		mr.log = collapseLog.capacity() * sizeof(vertexSplit);
+		for (const auto & vs : collapseLog)
+			mr.log += vs.getElemsToRemove().capacity() * sizeof(UInt) +
+				vs.getElemsToRedirect().capacity() * sizeof(UInt) +
+				vs.getMovedData().capacity() * sizeof(pair<UInt,point3d>);
+		if (logOrigin)
+		{
+			memoryReport origin;
+			logOrigin->getMemory(origin);
+			mr.log += origin.nodes + origin.elems + origin.data;
+		}
 		
-		// Possibly update fixed element
-		findDontTouchId();
+		return mr;
 	}
 	
 	
@@ -244,6 +712,7 @@ namespace geometry
 		// Possibly update CostClass object and re-build
 		// set of collapsingEdge's
 		costObj.setMeshOperation(&gridOperation);
+		collapsingSet.clear();
 		setupCollapsingSet();
 		
 		// Update structured data
@@ -255,6 +724,83 @@ namespace geometry
 		// Possibly find fixed element
 		findDontTouchId();
 	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::setQueueMode
+		(const QueueMode & qm, const Real & sb)
+	{
+		collapsingSet.setStaleBound(sb);
+		collapsingSet.setMode(qm);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::setSearchMode
+		(const SearchMode & sm, const Real & mg)
+	{
+		structData.setSearchMode(sm, mg);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::setAutoTuning
+		(const bool & at, const Real & minOcc, const Real & maxOvf)
+	{
+		structData.setAutoTuning(at, minOcc, maxOvf);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::setNumThreads(const UInt & nt)
+	{
+		numThreads = (nt > 0) ? nt : thread::hardware_concurrency();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::setMultipleChoice
+		(const UInt & k, const UInt & s)
+	{
+		numChoices = k;
+		seed = s;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::setCheckpoint
+		(const string & file, const UInt & step)
+	{
+		checkpointFile = file;
+		checkpointStep = step;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::setMemoryBudget
+		(const size_t & bytes, const UInt & step)
+	{
+		memoryBudget = bytes;
+		memoryStep = max(step, static_cast<UInt>(1));
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::setReordering(const bool & flag)
+	{
+		reordering = flag;
+		
+		// Re-order the mesh right away
+		if (reordering)
+			refresh();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::setRingStatistics(const bool & flag)
+	{
+		ringStats = flag;
+	}
 
 
 	//
@@ -265,227 +811,21 @@ namespace geometry
 	void simplification<Triangle, MT, CostClass>::
 		getCost(const UInt & id1, const UInt & id2)
 	{
-		// First make sure the fixed element is not involved
-		if (dontTouch)
-			if ((id1 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[0]) ||
-				(id1 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[1]) ||
-				(id1 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[2]) ||
-				(id2 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[0]) ||
-				(id2 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[1]) ||
-				(id2 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[2]))
-				return;
-				
-		//
-		// Get potentially valid points
-		//
-		
-		auto pointsList = costObj.getPointsList(id1, id2);
-		if (pointsList.empty())
-			return;
-			
-		// Declare "local" multi-set of collapsingEdge
-		// It stores the collapse information for each 
-		// potentially valid collapsing points
-		multiset<collapsingEdge> collapsingSet_l;
-				
-		//
-		// Extract elements and data involved in the collapse
-		//
-		
-		auto invElems = gridOperation.getElemsInvolvedInEdgeCollapsing(id1,id2);
-		auto toRemove = gridOperation.getElemsOnEdge(id1,id2);
-		auto toKeep = gridOperation.getElemsModifiedInEdgeCollapsing(id1,id2);
-		auto toMove = gridOperation.getDataModifiedInEdgeCollapsing(invElems);
-			
-		// Furthermore, check that the number of elements insisting 
-		// on the edge is exactly two
-		if (toRemove.size() != 2)
-			return;
-		
-		// Get normals to the elements involved in the collapse
-		vector<point3d> oldNormals;
-		oldNormals.reserve(toKeep.size());
-		for (auto elem : toKeep)
-			oldNormals.emplace_back(gridOperation.getNormal(elem));
-			
-		//
-		// Update connections
-		//
-		
-		// Store old id1 
-		auto P(gridOperation.getCPointerToMesh()->getNode(id1));
-		
-		// Update node-node, node-element and element-node connections
-		auto oldConnections = gridOperation.getPointerToConnectivity()
-			->applyEdgeCollapse(id2, id1, toRemove, toKeep);	
-		
-		//	
-		// No edges sharing more than two nodes
-		//
-		
-		auto nodes = gridOperation.getCPointerToConnectivity()->getNode2Node(id1).getConnected();
-		for (auto node : nodes)
-		{
-			auto shared = gridOperation.getNodesOnEdge(id1, node);
-			if (shared.size() != 2)
-			{
-				// Restore connections
-				gridOperation.getPointerToConnectivity()
-					->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-				// Restore list of nodes
-				gridOperation.getPointerToMesh()->setNode(id1, P);
-				
-				return;
-			}
-		}	
-															
-		//
-		// Get the cheapest collapsing point
-		//
-		// Since checking for grid self-intersections is expensive,
-		// these checks will be performed only when the cheapest  
-		// collapsing point has been identified
-												
-		for (UInt i = 0; i < pointsList.size(); ++i)
-		{
-			//
-			// Set collapsing point
-			//
-		
-			// Change coordinates and boundary flag of id1
-			gridOperation.getPointerToMesh()->setNode(id1, pointsList[i]);
-										
-			// Project data points and update data-element 
-			// and element-data connections
-			auto oldData = gridOperation.project(toMove, toKeep);
-			gridOperation.getPointerToConnectivity()->eraseElemInData2Elem(toRemove);
-			
-			//
-			// Check collapse validity (except for grid self-intersections)
-			//
-			
-			bool valid(true);
-						
-			for (UInt j = 0; j < toKeep.size() && valid; ++j)
-			{
-				// No degenerate triangles
-				valid = (gridOperation.getTriArea(toKeep[j]) > TOLL);
-				
-				// No triangle inversions
-				valid = valid && (oldNormals[j] * gridOperation.getNormal(toKeep[j]) > TOLL);
-				
-				// No empty triangles
-				valid = valid && !(gridOperation.isEmpty(toKeep[j]));
-			}
-			
-			//
-			// Get cost associated with edge collapse and update local collapsingEdge
-			//
-			
-			if (valid)
-			{
-				auto cost = costObj.getCost(id1, id2, pointsList[i], toKeep, toMove);
-				collapsingSet_l.emplace(id1, id2, cost, pointsList[i]);
-			}
-			
-			//
-			// Restore data-element and element-data connections
-			//
-			
-			gridOperation.undo(toMove, oldData);
-			gridOperation.getPointerToConnectivity()->insertElemInData2Elem(toRemove);
-		}
-			
-		//
-		// If no valid points have been found, restore and return
-		//
-		
-		if (collapsingSet_l.empty())
-		{
-			// Restore connections
-			gridOperation.getPointerToConnectivity()
-				->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-			// Restore list of nodes
-			gridOperation.getPointerToMesh()->setNode(id1, P);
-			
+		// Compute the cost information, keeping track of the minima 
+		// of the cost components over all the collapsing points tried
+		collapsingEdge cEdge;
+		array<Real,3> minCmp = {{numeric_limits<Real>::max(),
+			numeric_limits<Real>::max(), numeric_limits<Real>::max()}};
+		bool found(getCollapsingEdge(id1, id2, cEdge, &minCmp));
+		
+		// Let the CostClass object accumulate the minima, 
+		// then possibly update the queue
+		costObj.getCost(minCmp);
+		if (!found)
 			return;
-		}
-							
-		//
-		// Check for grids self-intersections
-		//
-		// Start from the cheapest collapsing point: if this does not lead to
-		// self-intersections, add it to collapsingEdge; otherwise,
-		// consider the second less expensive point and so on and so forth
-		
-		#ifdef ENABLE_SELF_INTERSECTIONS
-			// Restore connections
-			gridOperation.getPointerToConnectivity()
-				->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-			// Restore list of nodes
-			gridOperation.getPointerToMesh()->setNode(id1, P);
-			
-			// Update collapseInfo's and collapsingEdge's lists
-			costObj.addCollapseInfo(id1, id2, collapsingSet_l.cbegin()->getCost(),
-				collapsingSet_l.cbegin()->getCollapsingPoint());
-			collapsingSet.emplace(id1, id2, collapsingSet_l.cbegin()->getCost(),
-				collapsingSet_l.cbegin()->getCollapsingPoint());
-		#else
-			for (auto it = collapsingSet_l.cbegin(); it != collapsingSet_l.cend(); ++it)
-			{
-				// Set collapsing point
-				gridOperation.getPointerToMesh()->setNode(id1, it->getCollapsingPoint());
-				
-				// Update structured data
-				structData.update_f(toKeep);
-				
-				// Test self-intersections
-				bool valid(true);
-				for (auto it1 = toKeep.cbegin(); it1 != toKeep.cend() && valid; ++it1)
-				{
-					auto elems = structData.getNeighbouringElements(*it1);
-					for (auto it2 = elems.cbegin(); it2 != elems.cend() && valid; ++it2)
-						valid = valid && !(intrs.intersect(*it1, *it2));
-				}
-				
-				// Possibly update collapseInfo's and collapsingEdge's lists
-				if (valid)
-				{
-					// Restore connections
-					gridOperation.getPointerToConnectivity()
-						->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-					// Restore list of nodes
-					gridOperation.getPointerToMesh()->setNode(id1, P);
-					
-					// Restore structured data
-					structData.update_f(toKeep);
-					
-					// Update collapseInfo's and collapsingEdge's lists
-					costObj.addCollapseInfo(id1, id2, it->getCost(), it->getCollapsingPoint());
-					collapsingSet.emplace(id1, id2, it->getCost(), it->getCollapsingPoint());
-						
-					return;
-				}
-			}
-			
-			//
-			// No collapsing point turned out to be valid, so just restore everything
-			//
-			
-			// Restore connections
-			gridOperation.getPointerToConnectivity()
-				->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-	
-			// Restore list of nodes
-			gridOperation.getPointerToMesh()->setNode(id1, P);
-			
-			// Restore structured data
-			structData.update_f(toKeep);
-		#endif
+		costObj.addCollapseInfo(id1, id2, cEdge.getCost(), cEdge.getCollapsingPoint());
+		collapsingSet.emplace(id1, id2, cEdge.getCost(), cEdge.getCollapsingPoint(),
+			cEdge.getComponents());
 	}
 	
 
@@ -506,6 +846,19 @@ namespace geometry
 	template<MeshType MT, typename CostClass>
 	void simplification<Triangle, MT, CostClass>::
 		getCost_f(const UInt & id1, const UInt & id2)
+	{
+		// Compute the cost information and possibly update the queue
+		collapsingEdge cEdge;
+		if (getCollapsingEdge(id1, id2, cEdge))
+			collapsingSet.emplace(id1, id2, cEdge.getCost(), cEdge.getCollapsingPoint(),
+				cEdge.getComponents());
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	bool simplification<Triangle, MT, CostClass>::
+		getCollapsingEdge(const UInt & id1, const UInt & id2, collapsingEdge & cEdge,
+		array<Real,3> * minCmp) const
 	{
 		// First make sure the fixed element is not involved
 		if (dontTouch)
@@ -515,7 +868,7 @@ namespace geometry
 				(id2 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[0]) ||
 				(id2 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[1]) ||
 				(id2 == gridOperation.getCPointerToMesh()->getElem(dontTouchId)[2]))
-				return;
+				return false;
 				
 		//
 		// Get potentially valid points
@@ -523,7 +876,7 @@ namespace geometry
 		
 		auto pointsList = costObj.getPointsList(id1, id2);
 		if (pointsList.empty())
-			return;
+			return false;
 			
 		// Declare "local" multi-set of collapsingEdge
 		// It stores the collapse information for each 
@@ -533,54 +886,15 @@ namespace geometry
 		//
 		// Extract elements and data involved in the collapse
 		//
+		// The collapse is tried on a local copy of the involved
+		// elements, so that the mesh is never modified
 		
-		auto invElems = gridOperation.getElemsInvolvedInEdgeCollapsing(id1,id2);
-		auto toRemove = gridOperation.getElemsOnEdge(id1,id2);
-		auto toKeep = gridOperation.getElemsModifiedInEdgeCollapsing(id1,id2);
-		auto toMove = gridOperation.getDataModifiedInEdgeCollapsing(invElems);
-			
-		// Furthermore, check that the number of elements insisting 
-		// on the edge is exactly two
-		if (toRemove.size() != 2)
-			return;
-		
-		// Get normals to the elements involved in the collapse
-		vector<point3d> oldNormals;
-		oldNormals.reserve(toKeep.size());
-		for (auto elem : toKeep)
-			oldNormals.emplace_back(gridOperation.getNormal(elem));
-			
-		//
-		// Update connections
-		//
-		
-		// Store old id1 
-		auto P(gridOperation.getCPointerToMesh()->getNode(id1));
-		
-		// Update node-node, node-element and element-node connections
-		auto oldConnections = gridOperation.getPointerToConnectivity()
-			->applyEdgeCollapse(id2, id1, toRemove, toKeep);	
-		
-		//	
-		// No edges sharing more than two nodes
-		//
-		
-		auto nodes = gridOperation.getCPointerToConnectivity()->getNode2Node(id1).getConnected();
-		for (auto node : nodes)
-		{
-			auto shared = gridOperation.getNodesOnEdge(id1, node);
-			if (shared.size() != 2)
-			{
-				// Restore connections
-				gridOperation.getPointerToConnectivity()
-					->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
+		trialCollapse<Triangle,MT> trial(gridOperation, id1, id2);
 			
-				// Restore list of nodes
-				gridOperation.getPointerToMesh()->setNode(id1, P);
-				
-				return;
-			}
-		}	
+		// Check that the number of elements insisting on the edge
+		// is exactly two and no edges would share more than two nodes
+		if (!trial.isFeasible())
+			return false;
 															
 		//
 		// Get the cheapest collapsing point
@@ -591,35 +905,17 @@ namespace geometry
 												
 		for (UInt i = 0; i < pointsList.size(); ++i)
 		{
-			//
 			// Set collapsing point
-			//
-		
-			// Change coordinates and boundary flag of id1
-			gridOperation.getPointerToMesh()->setNode(id1, pointsList[i]);
-										
-			// Project data points and update data-element 
-			// and element-data connections
-			auto oldData = gridOperation.project(toMove, toKeep);
-			gridOperation.getPointerToConnectivity()->eraseElemInData2Elem(toRemove);
+			trial.setCollapsingPoint(pointsList[i]);
 			
 			//
 			// Check collapse validity (except for grid self-intersections)
 			//
 			
-			bool valid(true);
-						
-			for (UInt j = 0; j < toKeep.size() && valid; ++j)
-			{
-				// No degenerate triangles
-				valid = (gridOperation.getTriArea(toKeep[j]) > TOLL);
-				
-				// No triangle inversions
-				valid = valid && (oldNormals[j] * gridOperation.getNormal(toKeep[j]) > TOLL);
-				
-				// No empty triangles
-				valid = valid && !(gridOperation.isEmpty(toKeep[j]));
-			}
+			// No degenerate or inverted triangles
+			bool valid(trial.isValid());
+			// Project data points
+			valid = valid && trial.project();
 			
 			//
 			// Get cost associated with edge collapse and update local collapsingEdge
@@ -627,33 +923,23 @@ namespace geometry
 			
 			if (valid)
 			{
-				auto cost = costObj.getCost(id1, id2, pointsList[i], toKeep, toMove);
-				collapsingSet_l.emplace(id1, id2, cost, pointsList[i]);
+				auto cmp = costObj.getCostComponents(id1, id2, pointsList[i], trial);
+				auto cost = costObj.getCost_f(cmp);
+				collapsingSet_l.emplace(id1, id2, cost, pointsList[i], cmp);
+				
+				// Keep track of the minima, as getCost() does
+				if (minCmp)
+					for (UInt j = 0; j < 3; ++j)
+						(*minCmp)[j] = min((*minCmp)[j], cmp[j]);
 			}
-			
-			//
-			// Restore data-element and element-data connections
-			//
-			
-			gridOperation.undo(toMove, oldData);
-			gridOperation.getPointerToConnectivity()->insertElemInData2Elem(toRemove);
 		}
 			
 		//
-		// If no valid points have been found, restore and return
+		// If no valid points have been found, return
 		//
 		
 		if (collapsingSet_l.empty())
-		{
-			// Restore connections
-			gridOperation.getPointerToConnectivity()
-				->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-			// Restore list of nodes
-			gridOperation.getPointerToMesh()->setNode(id1, P);
-			
-			return;
-		}
+			return false;
 							
 		//
 		// Check for grids self-intersections
@@ -663,70 +949,23 @@ namespace geometry
 		// consider the second less expensive point and so on and so forth
 		
 		#ifdef ENABLE_SELF_INTERSECTIONS
-			// Restore connections
-			gridOperation.getPointerToConnectivity()
-				->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-			// Restore list of nodes
-			gridOperation.getPointerToMesh()->setNode(id1, P);
-			
-			// Update collapseInfo's and collapsingEdge's lists
-			costObj.addCollapseInfo_f(id1, id2, collapsingSet_l.cbegin()->getCost(),
-				collapsingSet_l.cbegin()->getCollapsingPoint());
-			collapsingSet.emplace(id1, id2, collapsingSet_l.cbegin()->getCost(),
-				collapsingSet_l.cbegin()->getCollapsingPoint());
+			// Take the cheapest point
+			cEdge = *(collapsingSet_l.cbegin());
+			return true;
 		#else
 			for (auto it = collapsingSet_l.cbegin(); it != collapsingSet_l.cend(); ++it)
 			{
 				// Set collapsing point
-				gridOperation.getPointerToMesh()->setNode(id1, it->getCollapsingPoint());
-				
-				// Update structured data
-				structData.update_f(toKeep);
-				
-				// Test self-intersections
-				bool valid(true);
-				for (auto it1 = toKeep.cbegin(); it1 != toKeep.cend() && valid; ++it1)
-				{
-					auto elems = structData.getNeighbouringElements(*it1);
-					for (auto it2 = elems.cbegin(); it2 != elems.cend() && valid; ++it2)
-						valid = valid && !(intrs.intersect(*it1, *it2));
-				}
+				trial.setCollapsingPoint(it->getCollapsingPoint());
 				
-				// Possibly update collapseInfo's and collapsingEdge's lists
-				if (valid)
+				// Test self-intersections and possibly take the point
+				if (!trial.intersect(structData))
 				{
-					// Restore connections
-					gridOperation.getPointerToConnectivity()
-						->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-			
-					// Restore list of nodes
-					gridOperation.getPointerToMesh()->setNode(id1, P);
-					
-					// Restore structured data
-					structData.update_f(toKeep);
-					
-					// Update collapseInfo's and collapsingEdge's lists
-					costObj.addCollapseInfo_f(id1, id2, it->getCost(), it->getCollapsingPoint());
-					collapsingSet.emplace(id1, id2, it->getCost(), it->getCollapsingPoint());
-						
-					return;
+					cEdge = *it;
+					return true;
 				}
 			}
-					
-			//
-			// No collapsing point turned out to be valid, so just restore everything
-			//
-			
-			// Restore connections
-			gridOperation.getPointerToConnectivity()
-				->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove); 
-	
-			// Restore list of nodes
-			gridOperation.getPointerToMesh()->setNode(id1, P);
-			
-			// Restore structured data
-			structData.update_f(toKeep);
+			return false;
 		#endif
 	}
 	
@@ -734,15 +973,17 @@ namespace geometry
 	// Specialization for grids without distributed data
 	// This method requires a specialization for each purely geometric cost class 
 	template<>
-	void simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>>::
-		getCost_f(const UInt & id1, const UInt & id2);
+	bool simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>>::
+		getCollapsingEdge(const UInt & id1, const UInt & id2, collapsingEdge & cEdge,
+		array<Real,3> * minCmp) const;
 		
 		
 	// Specialization for grids with distributed data and a purely geometric
 	// cost function
 	template<>
-	void simplification<Triangle, MeshType::DATA, OnlyGeo<MeshType::DATA>>::
-		getCost_f(const UInt & id1, const UInt & id2);
+	bool simplification<Triangle, MeshType::DATA, OnlyGeo<MeshType::DATA>>::
+		getCollapsingEdge(const UInt & id1, const UInt & id2, collapsingEdge & cEdge,
+		array<Real,3> * minCmp) const;
 	
 	
 	template<MeshType MT, typename CostClass>
@@ -757,11 +998,23 @@ namespace geometry
 		auto toRemove = gridOperation.getElemsOnEdge(id1,id2);
 		auto toKeep = gridOperation.getElemsModifiedInEdgeCollapsing(id1,id2);
 		auto toMove = gridOperation.getDataModifiedInEdgeCollapsing(invElems);
+		auto toStay = gridOperation.getDataOnEdge(toRemove, toMove);
+		
+		// Extract the elements close to the patch before the collapse:
+		// the self-intersection test for their edges may have failed
+		// because of the old position of the patch
+		vector<UInt> closeElems, newCloseElems;
+		#ifndef ENABLE_SELF_INTERSECTIONS
+			getCloseElems(invElems, closeElems);
+		#endif
 				
 		//
 		// Update mesh and connections
 		//
 		
+		// Possibly record the collapse
+		logCollapse(id1, id2, cPoint, toRemove, toKeep);
+		
 		// Set node id1 as collapsing point
 		gridOperation.getPointerToMesh()->setNode(id1, cPoint);
 		
@@ -776,6 +1029,18 @@ namespace geometry
 		// and element-data connections
 		gridOperation.project(toMove, toKeep);
 		gridOperation.getPointerToConnectivity()->eraseElemInData2Elem(toRemove);
+		logMovedData(toMove);
+		
+		// Extract the elements whose quantity of information has changed,
+		// i.e. the elements connected to the data which lay on the edge
+		// but have not been moved
+		set<UInt> dataElems;
+		for (auto datum : toStay)
+		{
+			auto & elems = gridOperation.getCPointerToConnectivity()
+				->getData2Elem(datum);
+			dataElems.insert(elems.begin(), elems.end());
+		}
 		
 		// 
 		// Update CostClass object and structured data
@@ -791,76 +1056,61 @@ namespace geometry
 		#endif
 		
 		// 
-		// Remove from collapseInfo's and collapsingEdge's lists
-		// the edges previously connected to id2
+		// Remove from the queue the edges previously
+		// connected to id2
 		//
 		
-		auto id2Conn = gridOperation.getCPointerToConnectivity()->getNode2Node(id2).getConnected();
+		auto & id2Conn = gridOperation.getCPointerToConnectivity()->getNode2Node(id2);
 		for (auto conn : id2Conn)
 		{
-			auto costPair = costObj.eraseCollapseInfo(id2, conn);
-			if (costPair.first)
-				id2 < conn ? collapsingSet.erase({id2, conn, costPair.second}) :
-					collapsingSet.erase({conn, id2, costPair.second});
+			collapsingSet.erase(id2, conn);
 		}
+		
+		// Update the set of edges, which the queue and
+		// the CostClass object refer to by handle
+		gridOperation.getPointerToConnectivity()->replaceNodeInEdges(id2, id1);
 			
 		//
 		// Extract edges whose cost must be re-computed
 		//
-		// These edges are the ones which shared at least a vertex 
-		// with the triangles in the extended patch of the collapsing node
+		// The edges within the 2-ring of the collapsing node,
+		// i.e. those picked by the ring-based rule, are possibly 
+		// counted for the sake of comparison
 		
-		unordered_set<pair<UInt,UInt>> invEdges;
-		
-		// Get node-node connections for collapsing node, ...
-		auto id1Conn = gridOperation.getCPointerToConnectivity()
-			->getNode2Node(id1).getConnected();
-		// ... for each node get the node-node connections...
-		for (auto node_i : id1Conn)
+		#ifndef ENABLE_SELF_INTERSECTIONS
+			getCloseElems(toKeep, newCloseElems);
+			closeElems.insert(closeElems.end(), newCloseElems.cbegin(), newCloseElems.cend());
+		#endif
+		edgeTable invEdges;
+		getDirtyEdges(id1, closeElems, {dataElems.cbegin(), dataElems.cend()}, invEdges);
+		numRecomputations += invEdges.size();
+		if (ringStats)
 		{
-			auto iConn = gridOperation.getCPointerToConnectivity()
-				->getNode2Node(node_i).getConnected();
-			// ... and also for these nodes get node-node connections
-			for (auto node_j : iConn)
-			{
-				auto jConn = gridOperation.getCPointerToConnectivity()
-					->getNode2Node(node_j).getConnected();
-					
-				// Finally, save the edge
-				for (auto node_k : jConn)
-				{
-					(node_k > node_j) ? invEdges.emplace(node_j, node_k) :
-						invEdges.emplace(node_k, node_j);
-				}
-			}
+			edgeTable ringEdges;
+			getRingEdges(id1, 2, ringEdges);
+			numRingRecomputations += ringEdges.size();
 		}
 					
 		//
 		// Re-compute cost for involved edges
 		//
-		// First erase old costs from lists of collapseInfo's and
-		// collapsingEdge's, then insert updated values
+		// First erase old costs from the queue, then insert updated values
 		
-		for (auto edge : invEdges)
+		for (auto & edge : invEdges.getEnds())
 		{
-			// Remove edge from collapseInfo's list and get cost
-			auto costPair = costObj.eraseCollapseInfo(edge.first, edge.second);
-			
-			// Remove edge from collapsingEdge's list
-			if (costPair.first)
-				collapsingSet.erase({edge.first, edge.second, costPair.second});
+			// Remove edge from the queue
+			collapsingSet.erase(edge[0], edge[1]);
 			
-			// Compute new cost and possibly add it to collapseInfo's
-			// and collapsingEdge's lists
-			getCost(edge.first, edge.second);
+			// Compute new cost and possibly add it to the queue
+			getCost(edge[0], edge[1]);
 		}
 		
 		//
-		// Check if the costs must be re-computed
+		// Check if the costs must be re-normalized
 		//
 		
 		if (costObj.toUpdate())
-			rebuildCollapsingSet();
+			rescaleCollapsingSet();
 	}
 	
 	
@@ -873,125 +1123,53 @@ namespace geometry
 	
 	template<MeshType MT, typename CostClass>
 	void simplification<Triangle, MT, CostClass>::
-		update(const vector<UInt> & id1, const vector<UInt> & id2, const vector<point3d> & cPoint)
-	{
-		for (UInt i = 0; i < id1.size(); ++i)
-		{
-			//
-			// Extract elements and data involved in the collapse
-			//
-		
-			auto invElems = gridOperation.getElemsInvolvedInEdgeCollapsing(id1[i],id2[i]);
-			auto toRemove = gridOperation.getElemsOnEdge(id1[i],id2[i]);
-			auto toKeep = gridOperation.getElemsModifiedInEdgeCollapsing(id1[i],id2[i]);
-			auto toMove = gridOperation.getDataModifiedInEdgeCollapsing(invElems);
-		
-			//
-			// Update mesh and connections
-			//
-		
-			// Set node id1 as collapsing point
-			gridOperation.getPointerToMesh()->setNode(id1[i], cPoint[i]);
-		
-			// Set node id2 inactive
-			gridOperation.getPointerToMesh()->setNodeInactive(id2[i]);
-					
-			// Update element-node, node-node and node-element connections
-			gridOperation.getPointerToConnectivity()
-				->applyEdgeCollapse(id2[i], id1[i], toRemove, toKeep);
-			
-			// Project involved data points and update data-element
-			// and element-data connections
-			gridOperation.project(toMove, toKeep);
-			gridOperation.getPointerToConnectivity()->eraseElemInData2Elem(toRemove);
-		
-			// 
-			// Update CostClass object and structured data
-			//
-		
-			costObj.update(id1[i], id2[i], toRemove);
-			#ifndef ENABLE_SELF_INTERSECTIONS
-				structData.update(toKeep);
-			#endif
+		collapse(const UInt & id1, const UInt & id2, const point3d & cPoint)
+	{
+		//
+		// Extract elements and data involved in the collapse
+		//
 		
-			// 
-			// Remove from collapseInfo's and collapsingEdge's lists
-			// the edges previously connected to id2
-			//
+		auto invElems = gridOperation.getElemsInvolvedInEdgeCollapsing(id1,id2);
+		auto toRemove = gridOperation.getElemsOnEdge(id1,id2);
+		auto toKeep = gridOperation.getElemsModifiedInEdgeCollapsing(id1,id2);
+		auto toMove = gridOperation.getDataModifiedInEdgeCollapsing(invElems);
+				
+		//
+		// Update mesh and connections
+		//
 		
-			auto id2Conn = gridOperation.getCPointerToConnectivity()->getNode2Node(id2[i]).getConnected();
-			for (auto conn : id2Conn)
-			{
-				auto costPair = costObj.eraseCollapseInfo(id2[i], conn);
-				if (costPair.first)
-					id2[i] < conn ? collapsingSet.erase({id2[i], conn, costPair.second}) :
-						collapsingSet.erase({conn, id2[i], costPair.second});
-			}
-			
-			//
-			// Extract edges whose cost must be re-computed
-			//
-			// These edges are the ones which shared at least a vertex 
-			// with the triangles in the extended patch of the collapsing node
+		// Possibly record the collapse
+		logCollapse(id1, id2, cPoint, toRemove, toKeep);
 		
-			unordered_set<pair<UInt,UInt>> invEdges;
+		// Set node id1 as collapsing point
+		gridOperation.getPointerToMesh()->setNode(id1, cPoint);
 		
-			// Get node-node connections for collapsing node, ...
-			auto id1Conn = gridOperation.getCPointerToConnectivity()
-				->getNode2Node(id1[i]).getConnected();
-			// ... for each node get the node-node connections...
-			for (auto node_i : id1Conn)
-			{
-				auto iConn = gridOperation.getCPointerToConnectivity()
-					->getNode2Node(node_i).getConnected();
-				// ... and also for these nodes get node-node connections
-				for (auto node_j : iConn)
-				{
-					auto jConn = gridOperation.getCPointerToConnectivity()
-						->getNode2Node(node_j).getConnected();
-					
-					// Finally, save the edge
-					for (auto node_k : jConn)
-					{
-						(node_k > node_j) ? invEdges.emplace(node_j, node_k) :
-							invEdges.emplace(node_k, node_j);
-					}
-				}
-			}
+		// Set node id2 inactive
+		gridOperation.getPointerToMesh()->setNodeInactive(id2);
 					
-			//
-			// Re-compute cost for involved edges
-			//
-			// First erase old costs from lists of collapseInfo's and
-			// collapsingEdge's, then insert updated values
-		
-			for (auto edge : invEdges)
-			{
-				// Remove edge from collapseInfo's list and get cost
-				auto costPair = costObj.eraseCollapseInfo(edge.first, edge.second);
-			
-				// Remove edge from collapsingEdge's list
-				if (costPair.first)
-					collapsingSet.erase({edge.first, edge.second, costPair.second});
+		// Update element-node, node-node and node-element connections
+		gridOperation.getPointerToConnectivity()
+			->applyEdgeCollapse(id2, id1, toRemove, toKeep);
 			
-				// Compute new cost and possibly add it to collapseInfo's
-				// and collapsingEdge's lists
-				getCost(edge.first, edge.second);
-			}
-		}
+		// Project involved data points and update data-element
+		// and element-data connections
+		gridOperation.project(toMove, toKeep);
+		gridOperation.getPointerToConnectivity()->eraseElemInData2Elem(toRemove);
+		logMovedData(toMove);
 		
-		//
-		// Check if the costs must be re-computed
+		// 
+		// Update CostClass object and structured data
 		//
 		
+		costObj.update(id1, id2, toRemove);
+		gridOperation.getPointerToConnectivity()->replaceNodeInEdges(id2, id1);
 		#ifndef ENABLE_SELF_INTERSECTIONS
+			structData.update(toKeep);
+			
 			// Possibly, refresh structured data
 			if (structData.toRefresh())
 				structData.refresh(gridOperation);
 		#endif
-		
-		if (costObj.toUpdate())
-			rebuildCollapsingSet();
 	}
 	
 	
@@ -999,7 +1177,16 @@ namespace geometry
 	// This method requires a specialization for each purely geometric cost class
 	template<>
 	void simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>>::
-		update(const vector<UInt> & id1, const vector<UInt> & id2, const vector<point3d> & cPoint);
+		collapse(const UInt & id1, const UInt & id2, const point3d & cPoint);
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::
+		update(const vector<UInt> & id1, const vector<UInt> & id2, const vector<point3d> & cPoint)
+	{
+		for (UInt i = 0; i < id1.size(); ++i)
+			update(id1[i], id2[i], cPoint[i]);
+	}
 		
 
 	//
@@ -1068,22 +1255,382 @@ namespace geometry
 			}
 		}
 	}
+	
+	
+	//
+	// Methods for handling the collapse log
+	//
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::enableCollapseLog()
+	{
+		logEnabled = true;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::disableCollapseLog()
+	{
+		logEnabled = false;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE const vector<vertexSplit> & simplification<Triangle, MT, CostClass>::
+		getCollapseLog() const
+	{
+		return collapseLog;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	mesh<Triangle,MT> simplification<Triangle, MT, CostClass>::
+		getLevelOfDetail(const UInt & numNodes) const
+	{
+		if (logOrigin == nullptr)
+			return mesh<Triangle,MT>();
+			
+		// Each collapse removes exactly one node
+		UInt numCollapses(0);
+		if (numNodes < logOrigin->getNumNodes())
+			numCollapses = min<UInt>(logOrigin->getNumNodes() - numNodes, collapseLog.size());
+		
+		//
+		// Re-play the collapses on a copy of the original mesh
+		//
+		// The connectivity is not needed, since each record
+		// lists the elements and the data points it affects
+		
+		mesh<Triangle,MT> grid(*logOrigin);
+		for (UInt i = 0; i < numCollapses; ++i)
+		{
+			auto & vs = collapseLog[i];
+			grid.setNode(vs.getId1(), vs.getCollapsingPoint());
+			grid.setNodeInactive(vs.getId2());
+			for (auto elem : vs.getElemsToRedirect())
+				grid.replaceVertex(elem, vs.getId2(), vs.getId1());
+			for (auto elem : vs.getElemsToRemove())
+				grid.setElemInactive(elem);
+			applyMovedData(grid, vs);
+		}
+		
+		// Remove inactive nodes and elements
+		grid.refresh();
+		
+		return grid;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::logCollapse(const UInt & id1, 
+		const UInt & id2, const point3d & cPoint, const vector<UInt> & toRemove, 
+		const vector<UInt> & toKeep)
+	{
+		if (!logEnabled)
+			return;
+			
+		// Among the elements to keep, only those sharing id2
+		// will have a vertex replaced
+		vector<UInt> toRedirect;
+		toRedirect.reserve(toKeep.size());
+		for (auto elem : toKeep)
+		{
+			auto & vertices = gridOperation.getCPointerToMesh()->getElem(elem);
+			if ((vertices[0] == id2) || (vertices[1] == id2) || (vertices[2] == id2))
+				toRedirect.push_back(elem);
+		}
+		
+		collapseLog.emplace_back(id1, id2, cPoint, toRemove, toRedirect);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::logMovedData(const vector<UInt> & toMove)
+	{
+		if (!logEnabled)
+			return;
+			
+		for (auto datum : toMove)
+			collapseLog.back().addMovedData(datum, 
+				gridOperation.getCPointerToMesh()->getData(datum));
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::applyMovedData
+		(mesh<Triangle,MeshType::GEO> &, const vertexSplit &)
+	{
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::applyMovedData
+		(mesh<Triangle,MeshType::DATA> & grid, const vertexSplit & vs)
+	{
+		for (auto & datum : vs.getMovedData())
+			grid.setData(datum.first, datum.second);
+	}
 
 
+	//
+	// Checkpointing
+	//
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::save(ostream & out) const
+	{
+		// Header, to detect a checkpoint written for another class
+		string tag("simplification<" + to_string(static_cast<UInt>(MT)) + "," 
+			+ typeid(CostClass).name() + ">");
+		utility::write(out, vector<char>(tag.cbegin(), tag.cend()));
+		
+		// Mesh, connections and CostClass object
+		gridOperation.getCPointerToConnectivity()->save(out);
+		costObj.save(out);
+		
+		// Cartesian grid and search mode for the structured data; the grid
+		// is not re-computed from the mesh since the latter has already
+		// been simplified
+		auto & cg = structData.getCartesianGrid();
+		utility::write(out, cg.getNE().getCoor());
+		utility::write(out, cg.getSW().getCoor());
+		utility::write(out, cg.getCellSize());
+		utility::write(out, structData.getSearchMode());
+		utility::write(out, structData.getTree().getMaxGrowth());
+		utility::write(out, structData.isAutoTuning());
+		utility::write(out, structData.getMinOccupancy());
+		utility::write(out, structData.getMaxOverflow());
+		
+		// Fixed element and settings
+		utility::write(out, dontTouch);
+		utility::write(out, dontTouchId);
+		utility::write(out, collapsingSetReady);
+		utility::write(out, numChoices);
+		utility::write(out, seed);
+		utility::write(out, numRecomputations);
+		utility::write(out, numRingRecomputations);
+		utility::write(out, ringStats);
+		utility::write(out, logEnabled);
+		utility::write(out, checkpointStep);
+		utility::write(out, vector<char>(checkpointFile.cbegin(), checkpointFile.cend()));
+		utility::write(out, memoryBudget);
+		utility::write(out, memoryStep);
+		utility::write(out, reordering);
+		
+		// Random engine
+		ostringstream oss;
+		oss << engine;
+		auto state = oss.str();
+		utility::write(out, vector<char>(state.cbegin(), state.cend()));
+		
+		// Queue of collapsingEdge's
+		utility::write(out, collapsingSet.getMode());
+		utility::write(out, collapsingSet.getStaleBound());
+		auto cEdges = collapsingSet.getEdges();
+		utility::write(out, static_cast<UInt>(cEdges.size()));
+		for (auto cEdge : cEdges)
+		{
+			utility::write(out, cEdge.getId1());
+			utility::write(out, cEdge.getId2());
+			utility::write(out, cEdge.getCost());
+			utility::write(out, cEdge.getCollapsingPoint().getCoor());
+			utility::write(out, cEdge.getComponents());
+		}
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::load(istream & in)
+	{
+		// Check header
+		string tag("simplification<" + to_string(static_cast<UInt>(MT)) + "," 
+			+ typeid(CostClass).name() + ">");
+		vector<char> chars;
+		utility::read(in, chars);
+		if (string(chars.cbegin(), chars.cend()) != tag)
+			throw runtime_error("Checkpoint not written for " + tag + ".");
+		
+		// Mesh, connections and CostClass object
+		gridOperation.getPointerToConnectivity()->load(in);
+		costObj.load(in);
+		
+		// Cartesian grid and search mode for the
+		// structured data, then the bounding boxes
+		array<Real,3> ne, sw, dl;
+		utility::read(in, ne);
+		utility::read(in, sw);
+		utility::read(in, dl);
+		SearchMode sm;
+		Real mg, minOcc, maxOvf;
+		bool at;
+		utility::read(in, sm);
+		utility::read(in, mg);
+		utility::read(in, at);
+		utility::read(in, minOcc);
+		utility::read(in, maxOvf);
+		structData.setSearchMode(sm, mg);
+		structData.setAutoTuning(at, minOcc, maxOvf);
+		structData.setCartesianGrid(cartesianGrid(point3d(ne), point3d(sw), dl));
+		
+		// Fixed element and settings
+		utility::read(in, dontTouch);
+		utility::read(in, dontTouchId);
+		utility::read(in, collapsingSetReady);
+		utility::read(in, numChoices);
+		utility::read(in, seed);
+		utility::read(in, numRecomputations);
+		utility::read(in, numRingRecomputations);
+		utility::read(in, ringStats);
+		utility::read(in, logEnabled);
+		utility::read(in, checkpointStep);
+		utility::read(in, chars);
+		checkpointFile.assign(chars.cbegin(), chars.cend());
+		utility::read(in, memoryBudget);
+		utility::read(in, memoryStep);
+		utility::read(in, reordering);
+		
+		// Random engine
+		utility::read(in, chars);
+		istringstream iss(string(chars.cbegin(), chars.cend()));
+		iss >> engine;
+		
+		// Queue of collapsingEdge's
+		QueueMode qm;
+		Real sb;
+		utility::read(in, qm);
+		utility::read(in, sb);
+		collapsingSet.clear();
+		collapsingSet.setMode(qm);
+		collapsingSet.setStaleBound(sb);
+		UInt size;
+		utility::read(in, size);
+		vector<collapsingEdge> cEdges;
+		cEdges.reserve(size);
+		for (UInt i = 0; i < size; ++i)
+		{
+			UInt id1, id2;
+			Real cost;
+			array<Real,3> p, cmp;
+			utility::read(in, id1);
+			utility::read(in, id2);
+			utility::read(in, cost);
+			utility::read(in, p);
+			utility::read(in, cmp);
+			cEdges.emplace_back(id1, id2, cost, point3d(p), cmp);
+		}
+		collapsingSet.insert(cEdges);
+		
+		resumed = true;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::saveCheckpoint() const
+	{
+		// Write to a temporary file first, so that an interruption
+		// while writing does not spoil the previous checkpoint
+		string tmp(checkpointFile + ".tmp");
+		{
+			ofstream out(tmp, ios::binary);
+			if (!out.is_open())
+				throw runtime_error(tmp + " can not be opened.");
+			save(out);
+		}
+		if (rename(tmp.c_str(), checkpointFile.c_str()))
+			throw runtime_error(checkpointFile + " can not be written.");
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::shrinkToFit()
+	{
+		gridOperation.getPointerToConnectivity()->shrinkToFit();
+		costObj.shrinkToFit();
+		structData.shrinkToFit();
+		collapsingSet.shrinkToFit();
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::compact()
+	{
+		// Refresh the mesh and apply the maps to all other
+		// components, as refresh() does
+		auto old2new = gridOperation.refresh(true);
+		costObj.refresh(old2new.first, old2new.second);
+		refreshCollapsingSet(old2new.first);
+		dontTouchId = old2new.second[dontTouchId];
+		if (reordering)
+			reorder();
+		
+		// Re-build the bounding boxes on the current global grid
+		structData.rebuild();
+		
+		shrinkToFit();
+		++numCompactions;
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::reorder()
+	{
+		// Re-order nodes and elements and apply the maps
+		// to all other components, as refresh() does
+		auto old2new = gridOperation.reorder();
+		costObj.refresh(old2new.first, old2new.second);
+		refreshCollapsingSet(old2new.first);
+		dontTouchId = old2new.second[dontTouchId];
+		
+		// Re-order the data points, if any
+		reorderData(gridOperation.getPointerToConnectivity());
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	INLINE void simplification<Triangle, MT, CostClass>::reorderData
+		(connect<Triangle,MeshType::GEO> *)
+	{
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::reorderData
+		(connect<Triangle,MeshType::DATA> * conn)
+	{
+		costObj.refreshData(conn->reorderData());
+	}
+	
+	
 	//
 	// Methods which make the simplification
 	//
 	
 	template<MeshType MT, typename CostClass>
-	void simplification<Triangle, MT, CostClass>::simplify(const UInt & numNodesMax,
+	INLINE void simplification<Triangle, MT, CostClass>::simplify(const UInt & numNodesMax,
+		const bool & enableDontTouch, const string & file)
+	{
+		simplify(vector<UInt>{numNodesMax}, enableDontTouch, file);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::simplify(const vector<UInt> & numNodesMax,
 		const bool & enableDontTouch, const string & file)
-	{				
+	{
+		// Sort the targets in descending order, dropping duplicates
+		vector<UInt> targets(numNodesMax);
+		sort(targets.begin(), targets.end(), greater<UInt>());
+		targets.erase(unique(targets.begin(), targets.end()), targets.end());
+		if (targets.empty())
+			return;
+		auto numNodesEnd(targets.back());
+		
 		// Check if the current number of nodes is below the threshold
 		auto numNodesStart(gridOperation.getCPointerToMesh()->getNumNodes());
-		if (numNodesMax >= numNodesStart)
+		if (numNodesEnd >= numNodesStart)
 		{
 			cout << "The number of mesh points is " << gridOperation.getCPointerToMesh()->getNumNodes()
-				<< ", already below the given threshold " << numNodesMax << "." << endl;
+				<< ", already below the given threshold " << numNodesEnd << "." << endl;
 			return;
 		}
 						
@@ -1095,45 +1642,134 @@ namespace geometry
 				
 		#ifdef NDEBUG
 		using namespace std::chrono;
+		#endif
+		
+		// Create the set of collapsingEdge's ordered by cost,
+		// unless already done or not needed; the multiple-choice
+		// scheduler does not keep it up-to-date, so drop it
+		if (numChoices > 0)
+		{
+			collapsingSet.clear();
+			collapsingSetReady = false;
+		}
+		else if (!collapsingSetReady)
+		{
+			#ifndef NDEBUG
+				cout << "Initialize list of edges ordered by the associated collapsing cost ... ";
+				setupCollapsingSet();
+				cout << "done" << endl;
+			#else
+				high_resolution_clock::time_point start = high_resolution_clock::now();
+				setupCollapsingSet();
+				high_resolution_clock::time_point stop = high_resolution_clock::now();
+				auto dif_collapsingSet = duration_cast<milliseconds>(stop-start).count();
+				cout << "Setup for the simplification process completed in " << dif_collapsingSet/1000 << " seconds." << endl;
+			#endif
+		}
+				
+		#ifdef NDEBUG
 		high_resolution_clock::time_point start = high_resolution_clock::now();
 		#endif
+		
+		// Re-seed the random engine for the multiple-choice scheduler
+		// and reset the counters of the cost re-computations, unless
+		// going on from a checkpoint
+		if (!resumed)
+		{
+			engine.seed(seed);
+			numRecomputations = 0;
+			numRingRecomputations = 0;
+		}
+		numCompactions = 0;
+		structData.resetStatistics();
+		
+		// Number of consecutive iterations without valid edges
+		UInt numFailures(0);
+		
+		// Possibly keep a copy of the mesh and reset the collapse log
+		collapseLog.clear();
+		logOrigin.reset(logEnabled ? 
+			new mesh<Triangle,MT>(*(gridOperation.getCPointerToMesh())) : nullptr);
+		if (logEnabled)
+			collapseLog.reserve(numNodesStart - numNodesEnd);
 
+		// Next target to reach; all but the last one give a snapshot.
+		// The snapshots for the targets reached before the checkpoint
+		// have already been taken
+		UInt nextTarget(0);
+		if (resumed)
+			for ( ; (nextTarget + 1 < targets.size()) && 
+				(numNodesStart <= targets[nextTarget]); ++nextTarget);
+		resumed = false;
+		
+		// The targets above the current number of nodes can not be
+		// reached, then no snapshot is taken for them
+		for ( ; (nextTarget + 1 < targets.size()) && 
+			(numNodesStart < targets[nextTarget]); ++nextTarget)
+			cout << "The number of mesh points is " << numNodesStart
+				<< ", already below the target " << targets[nextTarget] 
+				<< ": no snapshot is taken." << endl;
+		
+		// Number of nodes at the last checkpoint and at
+		// the last check of the memory
+		UInt numNodesCheckpoint(numNodesStart), numNodesMemory(numNodesStart);
+		
 		// Iterative collapse until numNodeMax is reached
 		#ifdef NDEBUG
 			UInt barWidth(35);
 		#endif
-		while (gridOperation.getCPointerToMesh()->getNumNodes() > numNodesMax)
+		while (gridOperation.getCPointerToMesh()->getNumNodes() > numNodesEnd)
 		{
-			if (collapsingSet.size() > 0)
+			// Possibly take the snapshots for the targets reached
+			for ( ; (nextTarget + 1 < targets.size()) && 
+				(gridOperation.getCPointerToMesh()->getNumNodes() <= targets[nextTarget]); ++nextTarget)
+				printSnapshot(file, targets[nextTarget]);
+			
+			// Possibly write a checkpoint
+			if ((checkpointStep > 0) && 
+				(numNodesCheckpoint - gridOperation.getCPointerToMesh()->getNumNodes() >= checkpointStep))
+			{
+				saveCheckpoint();
+				numNodesCheckpoint = gridOperation.getCPointerToMesh()->getNumNodes();
+			}
+			
+			// Possibly compact the mesh to stay within the memory cap;
+			// the collapse log refers to the Id's of the original mesh
+			if ((memoryBudget > 0) && !logEnabled &&
+				(numNodesMemory - gridOperation.getCPointerToMesh()->getNumNodes() >= memoryStep))
+			{
+				if (memoryUsage().total() > memoryBudget)
+					compact();
+				numNodesMemory = gridOperation.getCPointerToMesh()->getNumNodes();
+			}
+				
+			if (numChoices > 0)
+			{
+				// Take the cheapest edge among numChoices random edges
+				collapsingEdge cEdge;
+				if (getRandomCollapsingEdge(engine, cEdge))
+				{
+					numFailures = 0;
+					collapse(cEdge.getId1(), cEdge.getId2(), cEdge.getCollapsingPoint());
+				}
+				else if (++numFailures > gridOperation.getCPointerToMesh()->getNumNodes())
+				{
+					// No valid edges found for too long, then stop
+					cout << endl << "The process stopped prematurely since no valid edges have been found.";
+					break;
+				}
+			}
+			else if (collapsingSet.size() > 0)
 			{
 				// Take the first valid collapsing edge with the minimum cost
-				auto minCostEdge = collapsingSet.cbegin();
-				auto id1 = minCostEdge->getId1();
-				auto id2 = minCostEdge->getId2();
-				auto cPoint = minCostEdge->getCollapsingPoint();
+				auto minCostEdge = collapsingSet.top();
+				auto id1 = minCostEdge.getId1();
+				auto id2 = minCostEdge.getId2();
+				auto cPoint = minCostEdge.getCollapsingPoint();
 						
 				// Update the mesh, the connectivities, the structured data, CostClass object
 				// Re-compute cost for involved edges
 				update(id1, id2, cPoint);
-			
-				#ifdef NDEBUG
-					// Update progress bar
-					Real progress((numNodesStart - gridOperation.getCPointerToMesh()->getNumNodes())
-						/ (static_cast<Real>(numNodesStart - numNodesMax)));
-					cout << "Simplification process        [";
-					UInt pos(barWidth * progress);
-					for (UInt i = 0; i < barWidth; ++i) 
-					{
-						if (i < pos) 
-							cout << "=";
-						else if (i == pos) 
-							cout << ">";
-						else 
-							cout << " ";
-					}
-					cout << "] " << UInt(progress * 100.0) << " %\r";
-					cout.flush();
-				#endif
 			}
 			else
 			{
@@ -1141,6 +1777,25 @@ namespace geometry
 				cout << endl << "The process stopped prematurely since there are no valid edges left.";
 				break;
 			}
+			
+			#ifdef NDEBUG
+				// Update progress bar
+				Real progress((numNodesStart - gridOperation.getCPointerToMesh()->getNumNodes())
+					/ (static_cast<Real>(numNodesStart - numNodesEnd)));
+				cout << "Simplification process        [";
+				UInt pos(barWidth * progress);
+				for (UInt i = 0; i < barWidth; ++i) 
+				{
+					if (i < pos) 
+						cout << "=";
+					else if (i == pos) 
+						cout << ">";
+					else 
+						cout << " ";
+				}
+				cout << "] " << UInt(progress * 100.0) << " %\r";
+				cout.flush();
+			#endif
 		}
 		#ifdef NDEBUG
 		cout << endl;
@@ -1149,13 +1804,13 @@ namespace geometry
 		#endif
 		
 		//
-		// Refresh the mesh, the connections, cInfoList, collapsingSet and fixed element
+		// Refresh the mesh, the connections, the cost state,
+		// collapsingSet, structured data and fixed element
 		//
 		
-		auto old2new = gridOperation.refresh();
-		costObj.refreshCInfoList(old2new.first);
-		refreshCollapsingSet(old2new.first);
-		dontTouchId = old2new.second[dontTouchId];
+		refresh();
+		if (memoryBudget > 0)
+			shrinkToFit();
 		
 		//
 		// Print ...
@@ -1167,12 +1822,58 @@ namespace geometry
 		#endif
 		cout << "The mesh size passed from " << numNodesStart << " to " << 
 			gridOperation.getCPointerToMesh()->getNumNodes() << " nodes." << endl;
+		if ((numChoices == 0) && ringStats)
+			cout << numRecomputations << " edge costs re-computed, "
+				<< getNumSavedRecomputations() << " re-computations saved." << endl;
+		else if (numChoices == 0)
+			cout << numRecomputations << " edge costs re-computed." << endl;
+		if (numCompactions > 0)
+			cout << "The mesh has been compacted " << numCompactions
+				<< " times to stay within the memory cap." << endl;
+		if ((structData.getSearchMode() == SearchMode::BVH) &&
+			(structData.getTree().getNumRebuilds() > 0))
+			cout << "Subtrees of the search tree re-built " 
+				<< structData.getTree().getNumRebuilds() << " times." << endl;
+		if ((structData.getSearchMode() == SearchMode::GRID) && (structData.getNumRebins() > 0))
+			cout << "The search grid has been re-binned " 
+				<< structData.getNumRebins() << " times." << endl;
+		if (structData.getNumQueries() > 0)
+			cout << structData.getNumQueries() << " search queries, examining "
+				<< static_cast<Real>(structData.getNumCandidates()) / structData.getNumQueries()
+				<< " elements on average." << endl;
 		
 		// ... to file
 		if (!(file.empty()))
-			gridOperation.getPointerToMesh()->print(file);
+			gridOperation.getPointerToMesh()->print(targets.size() == 1 ? 
+				file : getSnapshotFile(file, numNodesEnd));
 			//gridOperation.printMesh(file);
 	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	string simplification<Triangle, MT, CostClass>::getSnapshotFile(const string & file, 
+		const UInt & numNodes)
+	{
+		auto ext = file.find_last_of('.');
+		if ((ext == string::npos) || (file.find_first_of('/', ext) != string::npos))
+			return file + "_" + to_string(numNodes);
+		return file.substr(0, ext) + "_" + to_string(numNodes) + file.substr(ext);
+	}
+	
+	
+	template<MeshType MT, typename CostClass>
+	void simplification<Triangle, MT, CostClass>::printSnapshot(const string & file, 
+		const UInt & numNodes) const
+	{
+		if (file.empty())
+			return;
+			
+		// Only the copy gets refreshed, so that the Id's
+		// in the live mesh are preserved
+		mesh<Triangle,MT> grid(*(gridOperation.getCPointerToMesh()));
+		grid.refresh();
+		grid.print(getSnapshotFile(file, numNodes));
+	}
 }
 
 #endif
@@ -1,56 +1,178 @@
 /*!	\file	imp_structuredData.hpp
 	\brief	Implementations of members of class structuredData. */
-	
+
 #ifndef HH_IMPSTRUCTUREDDATA_HH
 #define HH_IMPSTRUCTUREDDATA_HH
 
 #include <algorithm>
-
-#include "searchPoint.hpp"
+#include <cstdint>
 
 namespace geometry
 {
+	template<typename SHAPE>
+	constexpr UInt structuredData<SHAPE>::none;
+
+
+	//
+	// Counters of the queries
+	//
+
+	template<typename SHAPE>
+	structuredData<SHAPE>::queryCounter::queryCounter() :
+		numQueries(0), numCandidates(0)
+	{
+	}
+
+
+	template<typename SHAPE>
+	structuredData<SHAPE>::queryCounter::queryCounter(const queryCounter & qc) :
+		numQueries(qc.numQueries.load()), numCandidates(qc.numCandidates.load())
+	{
+	}
+
+
+	template<typename SHAPE>
+	typename structuredData<SHAPE>::queryCounter & 
+		structuredData<SHAPE>::queryCounter::operator=(const queryCounter & qc)
+	{
+		numQueries = qc.numQueries.load();
+		numCandidates = qc.numCandidates.load();
+		return *this;
+	}
+
+
+	template<typename SHAPE>
+	INLINE void structuredData<SHAPE>::queryCounter::add(const size_t & n)
+	{
+		numQueries.fetch_add(1, memory_order_relaxed);
+		numCandidates.fetch_add(n, memory_order_relaxed);
+	}
+
+
 	//
 	// Constructors
 	//
-	
+
 	template<typename SHAPE>
 	structuredData<SHAPE>::structuredData(bmesh<SHAPE> * pg) :
-		grid(pg), torefresh(false)
+		grid(pg), hashing(false), shift(0), numBuckets(0), autoTuning(false), 
+		minOccupancy(2.), maxOverflow(0.001), numFilled(0), numRebins(0), 
+		mode(SearchMode::GRID), torefresh(false)
 	{
 		// Build bounding boxes
 		if (grid != nullptr)
 			refresh(bmeshInfo<SHAPE>(*grid));
 	}
-	
-	
+
+
 	template<typename SHAPE>
 	template<MeshType MT>
 	structuredData<SHAPE>::structuredData(bmeshInfo<SHAPE,MT> & news) :
-		grid(news.getPointerToMesh()), torefresh(false)
+		grid(news.getPointerToMesh()), hashing(false), shift(0), numBuckets(0), 
+		autoTuning(false), minOccupancy(2.), maxOverflow(0.001), numFilled(0), 
+		numRebins(0), mode(SearchMode::GRID), torefresh(false)
 	{
 		// Build bounding boxes
 		refresh(news);
 	}
-	
-	
+
+
 	//
 	// Operators
 	//
-	
+
 	template<typename S>
 	ostream & operator<<(ostream & out, const structuredData<S> & sd)
 	{
-		for (auto it = sd.boxes.cbegin(); it != sd.boxes.cend(); ++it)
-			out << *it << endl;
+		for (auto & bb : sd.getBoundingBox())
+			out << bb << endl;
 		return out;
 	}
-	
-	
+
+
 	//
 	// Get methods
 	//
-	
+
+	template<typename SHAPE>
+	INLINE const cartesianGrid & structuredData<SHAPE>::getCartesianGrid() const
+	{
+		return cells;
+	}
+
+
+	template<typename SHAPE>
+	INLINE SearchMode structuredData<SHAPE>::getSearchMode() const
+	{
+		return mode;
+	}
+
+
+	template<typename SHAPE>
+	INLINE const aabbTree & structuredData<SHAPE>::getTree() const
+	{
+		return tree;
+	}
+
+
+	template<typename SHAPE>
+	INLINE bool structuredData<SHAPE>::isAutoTuning() const
+	{
+		return autoTuning;
+	}
+
+
+	template<typename SHAPE>
+	INLINE Real structuredData<SHAPE>::getMinOccupancy() const
+	{
+		return minOccupancy;
+	}
+
+
+	template<typename SHAPE>
+	INLINE Real structuredData<SHAPE>::getMaxOverflow() const
+	{
+		return maxOverflow;
+	}
+
+
+	template<typename SHAPE>
+	INLINE Real structuredData<SHAPE>::getOccupancy() const
+	{
+		if (numFilled == 0)
+			return 0.;
+		return static_cast<Real>(grid->getNumElems() - getNumOversized()) / numFilled;
+	}
+
+
+	template<typename SHAPE>
+	INLINE UInt structuredData<SHAPE>::getNumOversized() const
+	{
+		return bucketSize.empty() ? 0 : bucketSize.back();
+	}
+
+
+	template<typename SHAPE>
+	INLINE UInt structuredData<SHAPE>::getNumRebins() const
+	{
+		return numRebins;
+	}
+
+
+	template<typename SHAPE>
+	INLINE size_t structuredData<SHAPE>::getNumQueries() const
+	{
+		return counter.numQueries.load();
+	}
+
+
+	template<typename SHAPE>
+	INLINE size_t structuredData<SHAPE>::getNumCandidates() const
+	{
+		return counter.numCandidates.load();
+	}
+
+
 	template<typename SHAPE>
 	bbox3d structuredData<SHAPE>::getBoundingBox(const UInt & Id) const
 	{
@@ -59,188 +181,394 @@ namespace geometry
 			"provided only for triangular and quadrilateral grids.");
 		return {};
 	}
-	
-	
+
+
 	// Declare specialization for triangular grids
 	template<>
 	bbox3d structuredData<Triangle>::getBoundingBox(const UInt & Id) const;
-	
-	
+
+
 	// Declare specialization for quadrilateral grids
 	template<>
 	bbox3d structuredData<Quad>::getBoundingBox(const UInt & Id) const;
-		
-	
+
+
 	template<typename SHAPE>
-	INLINE unordered_multiset<bbox3d> structuredData<SHAPE>::getBoundingBox() const
+	vector<bbox3d> structuredData<SHAPE>::getBoundingBox() const
 	{
-		return boxes;
+		if (mode == SearchMode::BVH)
+			return tree.getBoundingBox();
+
+		vector<bbox3d> res;
+		res.reserve(boxes.size() + overflow.size());
+		for (auto & bb : boxes)
+			if (bb.getId() != none)
+				res.push_back(bb);
+		for (auto & bb : overflow)
+			if (bb.getId() != none)
+				res.push_back(bb);
+		return res;
 	}
-	
-	
+
+
 	template<typename SHAPE>
-	vector<UInt> structuredData<SHAPE>::getNeighbouringElements(const UInt & Id) const
+	INLINE vector<UInt> structuredData<SHAPE>::getNeighbouringElements(const UInt & Id) const
+	{
+		vector<UInt> res;
+		getNeighbouringElements(Id, res);
+		return res;
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::getNeighbouringElements(const UInt & Id,
+		vector<UInt> & res) const
 	{
 		// Implementation provide only for triangular and quadrilateral grids
 		static_assert(((SHAPE::numVertices == 3) || (SHAPE::numVertices == 4)),
 			"getIntersectingBoundingBoxes(), then the entire class, "
 			"provided only for triangular and quadrilateral grids.");
-			
-		//
-		// Create bounding box around the element and extract
-		// North-West and South-West points, also as searchPoint
+
+		// Create bounding box around the element
 		//
 		// As for getBoundingBox(): it is probably faster (or at least easier)
-		// to re-build the bounding box rather than extracting it from boxes	
-		
+		// to re-build the bounding box rather than extracting it from boxes
 		auto box = getBoundingBox(Id);
-		auto p_NE = box.getNE();
-		auto p_SW = box.getSW();
-		searchPoint sp_NE(p_NE);
-		searchPoint sp_SW(p_SW);
-				
+
 		//
 		// Find intersecting boxes
 		//
 		// We scan all the cells intersecting the reference box
 		// plus an extra layer. This should ensure that all
 		// possible intersecting elements are taken into account
-		// since an element cannot span more than one cell.
-					
-		unordered_set<UInt> res;
-		
-		// Determine indices range
-		UInt i_start = (sp_SW[0] == 0) ? 0 : sp_SW[0]-1;
-		UInt i_stop = sp_NE[0]+1;
-		UInt j_start = (sp_SW[1] == 0) ? 0 : sp_SW[1]-1;
-		UInt j_stop = sp_NE[1]+1;
-		UInt k_start = (sp_SW[2] == 0) ? 0 : sp_SW[2]-1;
-		UInt k_stop = sp_NE[2]+1;
-						
-		for (UInt i = i_start; i <= i_stop; ++i)
-			for (UInt j = j_start; j <= j_stop; ++j)
-				for (UInt k = k_start; k <= k_stop; ++k)
-				{
-					// Compute scalar index
-					UInt idx(i + j * bbox3d::getNumCells(0) + 
-						k * bbox3d::getNumCells(0) * bbox3d::getNumCells(1));
-												
-					// Extract all boxes having that index
-					auto range = boxes.equal_range(idx);
-					
-					// Out of these boxes, keep only the active ones 
-					// actually intersecting the reference bounding box							
-					for (auto it = range.first; it != range.second; ++it)
-						if (grid->isElemActive(it->getId()) && doIntersect(box, *it))
-							res.insert(it->getId());
-				}
-		
-		// Remove Id of reference element from the set,
-		// then convert to a vector
-		return {res.cbegin(), res.cend()};
-	}
-	
-	
-	template<typename SHAPE>
-	vector<UInt> structuredData<SHAPE>::getNeighbouringElements(const point3d & P) const
+		// since an element cannot span more than one cell;
+		// the boxes larger than the cells are all scanned.
+		// Each box is stored once, so no Id is repeated.
+
+		res.clear();
+		size_t numCandidates(0);
+		auto visit = [&](const bbox3d & bb)
+		{
+			// Keep only the active boxes actually
+			// intersecting the reference bounding box
+			++numCandidates;
+			if (grid->isElemActive(bb.getId()) && doIntersect(box, bb))
+				res.push_back(bb.getId());
+		};
+
+		if (mode == SearchMode::BVH)
+			tree.forEachOverlap(box.getSW(), box.getNE(), visit);
+		else
+		{
+			auto range = getCellsRange(box.getSW(), box.getNE());
+			UInt n0(cells.getNumCells(0)), n01(n0 * cells.getNumCells(1));
+			for (UInt k = range[4]; k <= range[5]; ++k)
+				for (UInt j = range[2]; j <= range[3]; ++j)
+					for (UInt i = range[0]; i <= range[1]; ++i)
+						forEachBox(i + j*n0 + k*n01, visit);
+			forEachOversized(visit);
+		}
+		counter.add(numCandidates);
+	}
+
+
+	template<typename SHAPE>
+	INLINE vector<UInt> structuredData<SHAPE>::getNeighbouringElements(const bbox3d & box,
+		const vector<UInt> & toSkip, const vector<bbox3d> & toAdd) const
+	{
+		vector<UInt> res;
+		getNeighbouringElements(box, toSkip, toAdd, res);
+		return res;
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::getNeighbouringElements(const bbox3d & box,
+		const vector<UInt> & toSkip, const vector<bbox3d> & toAdd,
+		vector<UInt> & res) const
 	{
 		// Implementation provide only for triangular and quadrilateral grids
 		static_assert(((SHAPE::numVertices == 3) || (SHAPE::numVertices == 4)),
 			"getIntersectingBoundingBoxes(), then the entire class, "
 			"provided only for triangular and quadrilateral grids.");
-			
-		// Compute indices for the point within the structure		
-		searchPoint sp_P(P);
-						
+
+		//
+		// Find intersecting boxes
+		//
+		// The same cells scanned by getNeighbouringElements(const UInt &)
+		// are scanned; the additional boxes are considered if they
+		// fall within one of these cells, as if they were stored
+		// in the structure. In BVH mode, all the additional boxes
+		// are considered.
+
+		res.clear();
+		size_t numCandidates(toAdd.size());
+		auto visit = [&](const bbox3d & bb)
+		{
+			// Keep only the active and not skipped boxes
+			// actually intersecting the reference box;
+			// the cheaper box test is done first
+			++numCandidates;
+			if (grid->isElemActive(bb.getId()) && doIntersect(box, bb) &&
+				(find(toSkip.cbegin(), toSkip.cend(), bb.getId()) == toSkip.cend()))
+				res.push_back(bb.getId());
+		};
+
+		if (mode == SearchMode::BVH)
+		{
+			tree.forEachOverlap(box.getSW(), box.getNE(), visit);
+			for (auto & bb : toAdd)
+				if (grid->isElemActive(bb.getId()) && doIntersect(box, bb))
+					res.push_back(bb.getId());
+			counter.add(numCandidates);
+			return;
+		}
+
+		auto range = getCellsRange(box.getSW(), box.getNE());
+		UInt n0(cells.getNumCells(0)), n01(n0 * cells.getNumCells(1));
+		for (UInt k = range[4]; k <= range[5]; ++k)
+			for (UInt j = range[2]; j <= range[3]; ++j)
+				for (UInt i = range[0]; i <= range[1]; ++i)
+					forEachBox(i + j*n0 + k*n01, visit);
+		forEachOversized(visit);
+
+		// Do the same for the additional boxes
+		for (auto & bb : toAdd)
+		{
+			auto c = cells.getCells(0.5*(bb.getNE() + bb.getSW()));
+			if ((isOversized(bb, cells) || ((range[0] <= c[0]) && (c[0] <= range[1]) && 
+				(range[2] <= c[1]) && (c[1] <= range[3]) && (range[4] <= c[2]) && (c[2] <= range[5]))) && 
+				grid->isElemActive(bb.getId()) && doIntersect(box, bb))
+				res.push_back(bb.getId());
+		}
+		counter.add(numCandidates);
+	}
+
+
+	template<typename SHAPE>
+	INLINE vector<UInt> structuredData<SHAPE>::getNeighbouringElements(const point3d & P) const
+	{
+		vector<UInt> res;
+		getNeighbouringElements(P, res);
+		return res;
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::getNeighbouringElements(const point3d & P,
+		vector<UInt> & res) const
+	{
+		// Implementation provide only for triangular and quadrilateral grids
+		static_assert(((SHAPE::numVertices == 3) || (SHAPE::numVertices == 4)),
+			"getIntersectingBoundingBoxes(), then the entire class, "
+			"provided only for triangular and quadrilateral grids.");
+
 		//
 		// Find triangles the point may belong to
 		//
 		// We return all the triangles associated with the cell P
-		// falls within, plus an extra layer. This should ensure 
-		// that all elements which P may belong to are taken into 
+		// falls within, plus an extra layer. This should ensure
+		// that all elements which P may belong to are taken into
 		// account since an element cannot span more than one cell.
-					
-		unordered_set<UInt> res;
-		
-		// Determine indices range
-		UInt i_start = (sp_P[0] == 0) ? 0 : sp_P[0]-1;
-		UInt i_stop = sp_P[0]+1;
-		UInt j_start = (sp_P[1] == 0) ? 0 : sp_P[1]-1;
-		UInt j_stop = sp_P[1]+1;
-		UInt k_start = (sp_P[2] == 0) ? 0 : sp_P[2]-1;
-		UInt k_stop = sp_P[2]+1;
-						
-		for (UInt i = i_start; i <= i_stop; ++i)
-			for (UInt j = j_start; j <= j_stop; ++j)
-				for (UInt k = k_start; k <= k_stop; ++k)
-				{
-					// Compute scalar index
-					UInt idx(i + j * bbox3d::getNumCells(0) + 
-						k * bbox3d::getNumCells(0) * bbox3d::getNumCells(1));
-												
-					// Extract all boxes having that index
-					auto range = boxes.equal_range(idx);
-					
-					// Extract boxes Id's						
-					for (auto it = range.first; it != range.second; ++it)
-						if (grid->isElemActive(it->getId()))
-							res.insert(it->getId());
-				}
-		
-		return {res.cbegin(), res.cend()};
-	}
-	
-	
+		// In BVH mode, and for the boxes larger than the cells, the 
+		// elements whose box is closer than the size of a cell are
+		// returned.
+
+		res.clear();
+		size_t numCandidates(0);
+		point3d dl(cells.getCellSize());
+		if (mode == SearchMode::BVH)
+		{
+			tree.forEachOverlap(P - dl, P + dl, [&](const bbox3d & bb)
+			{
+				++numCandidates;
+				if (grid->isElemActive(bb.getId()))
+					res.push_back(bb.getId());
+			});
+			counter.add(numCandidates);
+			return;
+		}
+
+		auto range = getCellsRange(P, P);
+		UInt n0(cells.getNumCells(0)), n01(n0 * cells.getNumCells(1));
+		for (UInt k = range[4]; k <= range[5]; ++k)
+			for (UInt j = range[2]; j <= range[3]; ++j)
+				for (UInt i = range[0]; i <= range[1]; ++i)
+					forEachBox(i + j*n0 + k*n01, [&](const bbox3d & bb)
+					{
+						++numCandidates;
+						if (grid->isElemActive(bb.getId()))
+							res.push_back(bb.getId());
+					});
+		forEachOversized([&](const bbox3d & bb)
+		{
+			++numCandidates;
+			auto SW(bb.getSW()), NE(bb.getNE());
+			if (grid->isElemActive(bb.getId()) &&
+				(SW[0] <= P[0] + dl[0]) && (P[0] - dl[0] <= NE[0]) &&
+				(SW[1] <= P[1] + dl[1]) && (P[1] - dl[1] <= NE[1]) &&
+				(SW[2] <= P[2] + dl[2]) && (P[2] - dl[2] <= NE[2]))
+				res.push_back(bb.getId());
+		});
+		counter.add(numCandidates);
+	}
+
+
+	template<typename SHAPE>
+	INLINE size_t structuredData<SHAPE>::getMemory() const
+	{
+		return (boxes.capacity() + overflow.capacity()) * sizeof(bbox3d) +
+			(bucketStart.capacity() + overflowHead.capacity() + overflowNext.capacity() + 
+			location.capacity() + bucketSize.capacity()) * sizeof(UInt) +
+			tree.getMemory();
+	}
+
+
 	//
 	// Set methods
 	//
-	
+
 	template<typename SHAPE>
 	void structuredData<SHAPE>::setMesh(bmesh<SHAPE> * pg)
 	{
 		// Set the mesh
 		grid = pg;
-		
+
 		// (Re-)build bounding boxes
 		refresh(bmeshInfo<SHAPE>(*grid));
 	}
-	
-	
+
+
 	template<typename SHAPE>
 	template<MeshType MT>
 	void structuredData<SHAPE>::setMesh(bmeshInfo<SHAPE,MT> & news)
 	{
 		// Set the mesh
 		grid = news.getPointerToMesh();
-		
+
 		// (Re-)build bounding boxes
 		refresh(news);
 	}
-	
-	
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::setCartesianGrid(const cartesianGrid & cg)
+	{
+		// Set the grid
+		cells = cg;
+
+		// Re-build bounding boxes
+		torefresh = false;
+		rebuild();
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::setSearchMode(const SearchMode & sm, const Real & mg)
+	{
+		tree.setMaxGrowth(mg);
+		if (sm == mode)
+			return;
+
+		// Release the memory of the current structure
+		mode = sm;
+		if (mode == SearchMode::BVH)
+		{
+			vector<bbox3d>().swap(boxes);
+			vector<UInt>().swap(bucketStart);
+			vector<bbox3d>().swap(overflow);
+			vector<UInt>().swap(overflowHead);
+			vector<UInt>().swap(overflowNext);
+			vector<UInt>().swap(location);
+			vector<UInt>().swap(bucketSize);
+			numFilled = 0;
+		}
+		else
+			tree = aabbTree(mg);
+
+		// Re-build bounding boxes
+		torefresh = false;
+		if (grid != nullptr)
+			rebuild();
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::setAutoTuning(const bool & at, const Real & minOcc,
+		const Real & maxOvf)
+	{
+		minOccupancy = minOcc;
+		maxOverflow = maxOvf;
+		if (at == autoTuning)
+			return;
+
+		autoTuning = at;
+		if ((grid == nullptr) || (mode != SearchMode::GRID) || boxes.empty())
+			return;
+
+		//
+		// Re-build the grid, either tuned or with the cells as large 
+		// as the largest box, i.e. as the longest edge along each direction
+		//
+
+		if (autoTuning)
+			cells = getTunedGrid(cells.getNE(), cells.getSW());
+		else
+		{
+			array<Real,3> dl = {{0., 0., 0.}};
+			for (auto & bb : getBoundingBox())
+				for (UInt i = 0; i < 3; ++i)
+					dl[i] = max(dl[i], bb.getNE()[i] - bb.getSW()[i]);
+			cells = cartesianGrid(cells.getNE(), cells.getSW(), dl);
+		}
+		torefresh = false;
+		rebuild();
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::resetStatistics()
+	{
+		numRebins = 0;
+		counter = queryCounter();
+	}
+
+
 	//
 	// Modify set of bounding boxes
 	//
-	
+
 	template<typename SHAPE>
 	void structuredData<SHAPE>::erase(const vector<UInt> & ids)
 	{
+		if (mode == SearchMode::BVH)
+		{
+			for (auto id : ids)
+				tree.erase(id);
+			tree.refit();
+			return;
+		}
+
 		for (auto id : ids)
 		{
-			// Extract element index
-			auto idx = grid->getElem(id).getIdx();
-			
-			// Extract all elements having that index...
-			auto range = boxes.equal_range(idx);
-			
-			// ... Then find and remove the desired one
-			auto it = find_if(range.first, range.second,
-				[id](const bbox3d & bb){ return bb.getId() == id; });
-			boxes.erase(it);
+			if ((id >= location.size()) || (location[id] == none))
+				continue;
+
+			// Mark the box as erased
+			auto loc = location[id];
+			auto & old = (loc < boxes.size()) ? boxes[loc] : overflow[loc - boxes.size()];
+			if (autoTuning)
+			{
+				auto b = getBucket(old);
+				if ((--bucketSize[b] == 0) && (b < numBuckets))
+					--numFilled;
+			}
+			old.setId(none);
+			location[id] = none;
 		}
 	}
-	
-	
+
+
 	template<typename SHAPE>
 	void structuredData<SHAPE>::update(const vector<UInt> & ids)
 	{
@@ -248,150 +576,383 @@ namespace geometry
 			"update(), then the entire class, "
 			"provided only for triangular and quadrilateral grids.");
 	}
-	
-	
+
+
 	// Declare specialization for triangular grids
 	template<>
 	void structuredData<Triangle>::update(const vector<UInt> & ids);
-	
-	
+
+
 	// Declare specialization for quadrilateral grids
 	template<>
 	void structuredData<Quad>::update(const vector<UInt> & ids);
-	
-	
+
+
 	template<typename SHAPE>
 	void structuredData<SHAPE>::update_f(const vector<UInt> & ids)
 	{
-		static_assert(((SHAPE::numVertices == 3) || (SHAPE::numVertices == 4)),
-			"update(), then the entire class, "
-			"provided only for triangular and quadrilateral grids.");
+		for (auto id : ids)
+		{
+			auto bb = getBoundingBox(id);
+			bb.setId(id);
+			place(bb);
+		}
+		if (mode == SearchMode::BVH)
+			tree.refit();
 	}
-	
-	
-	// Declare specialization for triangular grids
-	template<>
-	void structuredData<Triangle>::update_f(const vector<UInt> & ids);
-	
-	
-	// Declare specialization for quadrilateral grids
-	template<>
-	void structuredData<Quad>::update_f(const vector<UInt> & ids);
-	
-	
+
+
 	template<typename SHAPE>
-	INLINE void structuredData<SHAPE>::update(const vector<UInt> & toRemove, 
+	INLINE void structuredData<SHAPE>::update(const vector<UInt> & toRemove,
 		const vector<UInt> & toKeep)
 	{
 		erase(toRemove);
 		update(toKeep);
 	}
-	
-	
+
+
 	template<typename SHAPE>
-	INLINE void structuredData<SHAPE>::update_f(const vector<UInt> & toRemove, 
+	INLINE void structuredData<SHAPE>::update_f(const vector<UInt> & toRemove,
 		const vector<UInt> & toKeep)
 	{
 		erase(toRemove);
 		update_f(toKeep);
 	}
-	
-	
+
+
 	//
 	// Refresh methods
 	//
-	
+
 	template<typename SHAPE>
 	INLINE bool structuredData<SHAPE>::toRefresh() const
 	{
-		return torefresh;
+		if (mode == SearchMode::BVH)
+			return tree.toRebuild();
+		if (!autoTuning)
+			return torefresh;
+
+		// Too many boxes larger than the cells, or too few
+		// boxes per cell; a single cell can not be coarsened
+		auto numOversized(getNumOversized());
+		return torefresh || (numOversized > maxOverflow * grid->getNumElems()) ||
+			((numFilled > 1) && (grid->getNumElems() - numOversized < minOccupancy * numFilled));
 	}
-	
+
+
 	template<typename SHAPE>
-	template<MeshType MT>
-	void structuredData<SHAPE>::refresh(const bmeshInfo<SHAPE,MT> & news)
+	void structuredData<SHAPE>::rebuild()
 	{
-		static_assert(((SHAPE::numVertices == 3) || (SHAPE::numVertices == 4)),
-			"refresh(), then the entire class, provided only for triangular "
-			"and quadrilateral grids.");
+		// Create the bounding box surrounding each active element
+		vector<bbox3d> all;
+		all.reserve(grid->getNumElems());
+		for (UInt id = 0; id < grid->getElemsListSize(); ++id)
+			if (grid->isElemActive(id))
+			{
+				all.push_back(getBoundingBox(id));
+				all.back().setId(id);
+			}
+
+		if (mode == SearchMode::BVH)
+		{
+			for (auto & bb : all)
+				grid->setIdx(bb.getId(), bb.getIdx());
+			tree.build(all);
+		}
+		else
+			sortBoxes(all);
 	}
-	
-	
-	// Specialization for triangular grids 
-	template<>
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::shrinkToFit()
+	{
+		if (mode == SearchMode::BVH)
+		{
+			tree.shrinkToFit();
+			return;
+		}
+
+		sortBoxes(getBoundingBox());
+		boxes.shrink_to_fit();
+		bucketStart.shrink_to_fit();
+		overflow.shrink_to_fit();
+		overflowHead.shrink_to_fit();
+		overflowNext.shrink_to_fit();
+		location.shrink_to_fit();
+	}
+
+
+	template<typename SHAPE>
 	template<MeshType MT>
-	void structuredData<Triangle>::refresh(const bmeshInfo<Triangle,MT> & news)
+	void structuredData<SHAPE>::refresh(const bmeshInfo<SHAPE,MT> & news)
 	{
-		// Reset torefresh flag
+		// Count the re-bins, then reset torefresh flag
+		if ((mode == SearchMode::GRID) && toRefresh())
+			++numRebins;
 		torefresh = false;
-		
+
 		//
-		// Set static members of class searchPoint 
-		// and bbox3d (i.e. boundingBox<3>)
+		// Build the Cartesian grid surrounding the mesh
 		//
-		
-		searchPoint::setup(news);
-		bbox3d::setup(news);
-		
+
+		if (autoTuning && (mode == SearchMode::GRID))
+		{
+			auto vertices = news.getBoundingBoxVertices();
+			cells = getTunedGrid(vertices.first, vertices.second);
+		}
+		else
+			cells = cartesianGrid(news);
+
 		//
 		// Create the bounding box surrounding each element
 		//
-		
-		boxes.clear();
+
+		rebuild();
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	template<typename SHAPE>
+	INLINE UInt structuredData<SHAPE>::getBucket(const UInt & idx) const
+	{
+		return hashing ?
+			static_cast<UInt>((static_cast<uint64_t>(idx) * 0x9E3779B97F4A7C15ull) >> shift) : idx;
+	}
+
+
+	template<typename SHAPE>
+	INLINE UInt structuredData<SHAPE>::getBucket(const bbox3d & bb) const
+	{
+		return isOversized(bb, cells) ? numBuckets : getBucket(bb.getIdx());
+	}
+
+
+	template<typename SHAPE>
+	INLINE bool structuredData<SHAPE>::isOversized(const bbox3d & bb,
+		const cartesianGrid & cg) const
+	{
+		// An element whose box is no larger than two cells can not
+		// overlap a box whose barycenter lies two cells away
+		return autoTuning && 
+			((bb.getNE()[0] - bb.getSW()[0] > 2. * cg.getCellSize(0)) ||
+			(bb.getNE()[1] - bb.getSW()[1] > 2. * cg.getCellSize(1)) ||
+			(bb.getNE()[2] - bb.getSW()[2] > 2. * cg.getCellSize(2)));
+	}
+
+
+	template<typename SHAPE>
+	cartesianGrid structuredData<SHAPE>::getTunedGrid(const point3d & pne,
+		const point3d & psw) const
+	{
+		// Create the bounding box surrounding each active element
+		vector<bbox3d> all;
+		all.reserve(grid->getNumElems());
 		for (UInt id = 0; id < grid->getElemsListSize(); ++id)
-		{
 			if (grid->isElemActive(id))
+				all.push_back(getBoundingBox(id));
+		if (all.empty())
+			return cartesianGrid(pne, psw, cells.getCellSize());
+
+		//
+		// Smallest cells such that at most a quarter of the allowed
+		// overflow is larger than the cells along each direction
+		//
+
+		auto k = static_cast<UInt>((1. - maxOverflow / 12.) * (all.size() - 1));
+		auto length = max(max(pne[0] - psw[0], pne[1] - psw[1]), pne[2] - psw[2]);
+		array<Real,3> dl;
+		vector<Real> extent(all.size());
+		for (UInt i = 0; i < 3; ++i)
+		{
+			for (UInt n = 0; n < all.size(); ++n)
+				extent[n] = all[n].getNE()[i] - all[n].getSW()[i];
+			nth_element(extent.begin(), extent.begin() + k, extent.end());
+			dl[i] = max(0.5 * extent[k], 1.e-3 * length);
+		}
+
+		//
+		// Enlarge the cells until the non-empty ones hold,
+		// on average, twice the minimum occupancy
+		//
+
+		cartesianGrid cg(pne, psw, dl);
+		vector<UInt> idx;
+		idx.reserve(all.size());
+		while (cg.getTotalNumCells() > 1)
+		{
+			idx.clear();
+			for (auto & bb : all)
+				if (!isOversized(bb, cg))
+					idx.push_back(cg.getIdx(bb));
+			sort(idx.begin(), idx.end());
+			auto numCells = unique(idx.begin(), idx.end()) - idx.begin();
+			if (idx.size() >= 2. * minOccupancy * numCells)
+				break;
+
+			for (auto & d : dl)
+				d *= 1.26;
+			cg = cartesianGrid(pne, psw, dl);
+		}
+		return cg;
+	}
+
+
+	template<typename SHAPE>
+	INLINE array<UInt,6> structuredData<SHAPE>::getCellsRange(const point3d & SW,
+		const point3d & NE) const
+	{
+		array<UInt,6> range;
+		for (UInt i = 0; i < 3; ++i)
+		{
+			auto first = cells.getCell(SW[i], i);
+			range[2*i] = (first == 0) ? 0 : first - 1;
+			range[2*i+1] = min(cells.getCell(NE[i], i) + 1, cells.getNumCells(i) - 1);
+		}
+		return range;
+	}
+
+
+	template<typename SHAPE>
+	template<typename F>
+	INLINE void structuredData<SHAPE>::forEachBox(const UInt & idx, F f) const
+	{
+		auto b = getBucket(idx);
+
+		// Sorted boxes; with hashing, the bucket may
+		// also store the boxes of other cells
+		for (UInt n = bucketStart[b]; n < bucketStart[b+1]; ++n)
+			if ((boxes[n].getIdx() == idx) && (boxes[n].getId() != none))
+				f(boxes[n]);
+
+		// Overflow
+		for (UInt n = overflowHead[b]; n != none; n = overflowNext[n])
+			if ((overflow[n].getIdx() == idx) && (overflow[n].getId() != none))
+				f(overflow[n]);
+	}
+
+
+	template<typename SHAPE>
+	template<typename F>
+	INLINE void structuredData<SHAPE>::forEachOversized(F f) const
+	{
+		if (!autoTuning)
+			return;
+
+		for (UInt n = bucketStart[numBuckets]; n < bucketStart[numBuckets+1]; ++n)
+			if (boxes[n].getId() != none)
+				f(boxes[n]);
+		for (UInt n = overflowHead[numBuckets]; n != none; n = overflowNext[n])
+			if (overflow[n].getId() != none)
+				f(overflow[n]);
+	}
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::place(const bbox3d & bb)
+	{
+		auto id = bb.getId();
+		if (mode == SearchMode::BVH)
+		{
+			tree.replace(bb);
+			grid->setIdx(id, bb.getIdx());
+			return;
+		}
+
+		if (id >= location.size())
+			location.resize(id + 1, none);
+
+		// Overwrite the old box if it lies in the same bucket
+		auto b = getBucket(bb);
+		auto loc = location[id];
+		if (loc != none)
+		{
+			auto & old = (loc < boxes.size()) ? boxes[loc] : overflow[loc - boxes.size()];
+			auto oldb = getBucket(old);
+			if (oldb == b)
 			{
-				// Extract element
-				auto elem = grid->getElem(id);
-			
-				// Build bounding box
-				auto it = boxes.emplace(id, grid->getNode(elem[0]), 
-					grid->getNode(elem[1]), grid->getNode(elem[2]));
-				
-				// Set element index
-				grid->setIdx(id, it->getIdx());
+				old = bb;
+				grid->setIdx(id, bb.getIdx());
+				return;
 			}
+			old.setId(none);
+			if (autoTuning && (--bucketSize[oldb] == 0) && (oldb < numBuckets))
+				--numFilled;
 		}
+
+		// Append to the overflow of the new bucket
+		location[id] = boxes.size() + overflow.size();
+		overflowNext.push_back(overflowHead[b]);
+		overflowHead[b] = overflow.size();
+		overflow.push_back(bb);
+		grid->setIdx(id, bb.getIdx());
+		if (autoTuning && (bucketSize[b]++ == 0) && (b < numBuckets))
+			++numFilled;
+
+		// Sort again when the overflow lists get too long
+		if (8 * overflow.size() > boxes.size() + 1024)
+			sortBoxes(getBoundingBox());
 	}
-	
-	
-	// Specialization for quadrilateral grids 
-	template<>
-	template<MeshType MT>
-	void structuredData<Quad>::refresh(const bmeshInfo<Quad,MT> & news)
+
+
+	template<typename SHAPE>
+	void structuredData<SHAPE>::sortBoxes(const vector<bbox3d> & all)
 	{
-		// Reset torefresh flag
-		torefresh = false;
-		
 		//
-		// Set static members of class searchPoint 
-		// and bbox3d (i.e. boundingBox<3>)
+		// Choose the number of buckets: one per cell, unless
+		// the cells outnumber the boxes
 		//
-		
-		searchPoint::setup(news);
-		bbox3d::setup(news);
-		
-		//
-		// Create the bounding box surrounding each element
-		//
-		
-		boxes.clear();
-		for (UInt id = 0; id < grid->getElemsListSize(); ++id)
+
+		UInt numCells(cells.getTotalNumCells());
+		numBuckets = numCells;
+		hashing = numCells > 2 * all.size() + 16;
+		if (hashing)
 		{
-			if (grid->isElemActive(id))
+			numBuckets = 16;
+			shift = 60;
+			while (numBuckets < all.size())
 			{
-				// Extract element
-				auto elem = grid->getElem(id);
-			
-				// Build bounding box
-				auto it = boxes.emplace(id, grid->getNode(elem[0]), 
-					grid->getNode(elem[1]), grid->getNode(elem[2]), grid->getNode(elem[3]));
-				
-				// Set element index
-				grid->setIdx(id, it->getIdx());
+				numBuckets *= 2;
+				--shift;
 			}
 		}
+
+		//
+		// Counting sort; the boxes larger than the
+		// cells go into the last bucket
+		//
+
+		bucketStart.assign(numBuckets + 2, 0);
+		for (auto & bb : all)
+			++bucketStart[getBucket(bb) + 1];
+		if (autoTuning)
+		{
+			bucketSize.assign(bucketStart.cbegin() + 1, bucketStart.cend());
+			numFilled = numBuckets - count(bucketSize.cbegin(), bucketSize.cend() - 1, 0);
+		}
+		else
+			bucketSize.clear();
+		for (UInt b = 0; b <= numBuckets; ++b)
+			bucketStart[b+1] += bucketStart[b];
+
+		boxes.resize(all.size());
+		location.assign(grid->getElemsListSize(), none);
+		vector<UInt> pos(bucketStart.cbegin(), bucketStart.cend() - 1);
+		for (auto & bb : all)
+		{
+			auto n = pos[getBucket(bb)]++;
+			boxes[n] = bb;
+			location[bb.getId()] = n;
+			grid->setIdx(bb.getId(), bb.getIdx());
+		}
+
+		// Empty overflow
+		overflow.clear();
+		overflowNext.clear();
+		overflowHead.assign(numBuckets + 1, none);
 	}
 }
 
@@ -0,0 +1,422 @@
+/*!	\file	imp_trialCollapse.hpp
+	\brief	Implementations of members of class trialCollapse. */
+
+#ifndef HH_IMPTRIALCOLLAPSE_HH
+#define HH_IMPTRIALCOLLAPSE_HH
+
+#include <algorithm>
+#include <iterator>
+
+namespace geometry
+{
+	//
+	// Constructors
+	//
+
+	template<MeshType MT>
+	trialCollapse<Triangle, MT>::trialCollapse(const bmeshOperation<Triangle,MT> & bmo,
+		const UInt & a, const UInt & b) :
+		oprtr(&bmo), id1(a), id2(b), cPoint(bmo.getCPointerToMesh()->getCoor(a)),
+		feasible(false), toRemove(bmo.getElemsOnEdge(a,b)),
+		toKeep(bmo.getElemsModifiedInEdgeCollapsing(a,b)), dataReady(false)
+	{
+		// Check that the number of elements insisting
+		// on the edge is exactly two
+		if (toRemove.size() != 2)
+			return;
+
+		//
+		// No edges sharing more than two nodes
+		//
+		// After the collapse, id1 would be connected to all nodes
+		// previously connected either to id1 or id2
+
+		auto conn = oprtr->getCPointerToConnectivity();
+		vector<UInt> nodes;
+		set_union(conn->getNode2Node(id1), conn->getNode2Node(id2), nodes);
+		nodes.erase(remove_if(nodes.begin(), nodes.end(), 
+			[&](const UInt & node){ return (node == id1) || (node == id2); }), nodes.end());
+		for (auto node : nodes)
+		{
+			// Count the involved nodes connected to node,
+			// merging the two ascending-ordered lists
+			UInt numCommon(0);
+			auto it = nodes.cbegin();
+			for (auto neighbour : conn->getNode2Node(node))
+			{
+				it = lower_bound(it, nodes.cend(), neighbour);
+				if (it == nodes.cend())
+					break;
+				if (*it == neighbour)
+					++numCommon;
+			}
+			if (numCommon != 2)
+				return;
+		}
+
+		feasible = true;
+
+		//
+		// Build the local patch
+		//
+
+		vertices.reserve(toKeep.size());
+		oldNormals.reserve(toKeep.size());
+		for (auto elem : toKeep)
+		{
+			auto & vert = oprtr->getCPointerToMesh()->getElem(elem);
+			array<UInt,3> v{{vert[0], vert[1], vert[2]}};
+			replace(v.begin(), v.end(), id2, id1);
+			vertices.push_back(v);
+			oldNormals.emplace_back(oprtr->getNormal(elem));
+		}
+	}
+
+
+	//
+	// Get methods
+	//
+
+	template<MeshType MT>
+	INLINE bool trialCollapse<Triangle, MT>::isFeasible() const
+	{
+		return feasible;
+	}
+
+
+	template<MeshType MT>
+	INLINE const vector<UInt> & trialCollapse<Triangle, MT>::getElemsToRemove() const
+	{
+		return toRemove;
+	}
+
+
+	template<MeshType MT>
+	INLINE const vector<UInt> & trialCollapse<Triangle, MT>::getElemsToKeep() const
+	{
+		return toKeep;
+	}
+
+
+	template<MeshType MT>
+	INLINE point3d trialCollapse<Triangle, MT>::getCollapsingPoint() const
+	{
+		return cPoint;
+	}
+
+
+	template<MeshType MT>
+	INLINE const vector<UInt> & trialCollapse<Triangle, MT>::getDataToMove() const
+	{
+		return toMove;
+	}
+
+
+	template<MeshType MT>
+	INLINE const vector<point3d> & trialCollapse<Triangle, MT>::getProjectedData() const
+	{
+		return movedData;
+	}
+
+
+	template<MeshType MT>
+	INLINE const vector<Real> & trialCollapse<Triangle, MT>::getQuantityOfInformation() const
+	{
+		return qoi;
+	}
+
+
+	//
+	// Trial methods
+	//
+
+	template<MeshType MT>
+	INLINE void trialCollapse<Triangle, MT>::setCollapsingPoint(const point3d & p)
+	{
+		// Round the point as the mesh would store it, so that
+		// the trial matches the collapse eventually applied
+		cPoint = point3d(static_cast<Coord>(p[0]), static_cast<Coord>(p[1]), 
+			static_cast<Coord>(p[2]));
+	}
+
+
+	template<MeshType MT>
+	bool trialCollapse<Triangle, MT>::isValid() const
+	{
+		for (UInt i = 0; i < toKeep.size(); ++i)
+		{
+			auto A(getNode(vertices[i][0]));
+			auto B(getNode(vertices[i][1]));
+			auto C(getNode(vertices[i][2]));
+
+			// No degenerate triangles
+			if (!(0.5 * ((B - A)^(C - A)).norm2() > TOLL))
+				return false;
+
+			// No triangle inversions
+			if (!(oldNormals[i] * ((B - A)^(C - B)).normalize() > TOLL))
+				return false;
+		}
+
+		return true;
+	}
+
+
+	template<MeshType MT>
+	bool trialCollapse<Triangle, MT>::project()
+	{
+		if (!dataReady)
+			setupData();
+
+		//
+		// Project the data points
+		//
+
+		vector<point3d> P;
+		P.reserve(toMove.size());
+		for (auto datum : toMove)
+			P.emplace_back(oprtr->getCPointerToMesh()->getData(datum));
+
+		vector<point3d> A, B, C;
+		A.reserve(toKeep.size());
+		B.reserve(toKeep.size());
+		C.reserve(toKeep.size());
+		for (auto & v : vertices)
+		{
+			A.push_back(getNode(v[0]));
+			B.push_back(getNode(v[1]));
+			C.push_back(getNode(v[2]));
+		}
+
+		auto prj = projection<Triangle>::project(P, A, B, C);
+
+		//
+		// Get new data-element connections
+		//
+		// Consistently with projection<Triangle>::getNewData2Elem(),
+		// the datum is associated with the elements sharing the
+		// edge or the vertex it falls on
+
+		data2Elem.clear();
+		data2ElemBegin.assign(1, 0);
+		movedData.clear();
+		movedData.reserve(toMove.size());
+		for (auto & t : prj)
+		{
+			auto & v = vertices[get<1>(t)];
+			auto pos = get<2>(t);
+
+			if (pos == 0)
+				data2Elem.push_back(toKeep[get<1>(t)]);
+			else if (pos < 4)
+			{
+				getNode2Elem(v[pos-1], elemsBuffer1);
+				getNode2Elem(v[pos % 3], elemsBuffer2);
+				set_intersection(elemsBuffer1.cbegin(), elemsBuffer1.cend(), 
+					elemsBuffer2.cbegin(), elemsBuffer2.cend(), back_inserter(data2Elem));
+			}
+			else
+			{
+				getNode2Elem(v[pos-4], elemsBuffer1);
+				data2Elem.insert(data2Elem.end(), elemsBuffer1.cbegin(), elemsBuffer1.cend());
+			}
+			data2ElemBegin.push_back(data2Elem.size());
+
+			movedData.push_back(get<0>(t));
+		}
+
+		//
+		// Compute quantity of information
+		//
+		// Data are visited in ascending order of Id, as in
+		// meshInfo<SHAPE, MeshType::DATA>::getQuantityOfInformation();
+		// since both the fixed and the projected data points are 
+		// sorted, the two lists are merged on the fly
+
+		bool empty(false);
+		qoi.assign(toKeep.size(), 0.);
+		for (UInt i = 0; i < toKeep.size(); ++i)
+		{
+			auto add = [&](const UInt & patch)
+			{
+				if (patch == 1)
+					qoi[i] += 1.;
+				else
+					qoi[i] += 1./patch;
+			};
+
+			auto fixed = fixedData[i].cbegin();
+			bool found(!fixedData[i].empty());
+			for (UInt j = 0; j < toMove.size(); ++j)
+			{
+				auto first = data2Elem.cbegin() + data2ElemBegin[j];
+				auto last = data2Elem.cbegin() + data2ElemBegin[j+1];
+				if (find(first, last, toKeep[i]) == last)
+					continue;
+
+				for ( ; (fixed != fixedData[i].cend()) && (fixed->first < toMove[j]); ++fixed)
+					add(fixed->second);
+				add(last - first);
+				found = true;
+			}
+			for ( ; fixed != fixedData[i].cend(); ++fixed)
+				add(fixed->second);
+
+			empty = empty || !found;
+		}
+
+		return !empty;
+	}
+
+
+	template<MeshType MT>
+	bool trialCollapse<Triangle, MT>::intersect(const structuredData<Triangle> & sd) const
+	{
+		if (toKeep.empty())
+			return false;
+
+		//
+		// Build the bounding boxes for the elements of the patch
+		//
+
+		vector<bbox3d> boxes;
+		boxes.reserve(toKeep.size());
+		for (UInt i = 0; i < toKeep.size(); ++i)
+			boxes.emplace_back(toKeep[i], getNode(vertices[i][0]),
+				getNode(vertices[i][1]), getNode(vertices[i][2]));
+
+		// Bounding box of the whole patch
+		point3d SW(boxes[0].getSW()), NE(boxes[0].getNE());
+		for (auto & bb : boxes)
+			for (UInt j = 0; j < 3; ++j)
+			{
+				SW[j] = min(SW[j], bb.getSW()[j]);
+				NE[j] = max(NE[j], bb.getNE()[j]);
+			}
+
+		// Stored bounding boxes for the elements of the patch
+		// are out-of-date, while the elements on the edge are gone
+		vector<UInt> toSkip(toRemove);
+		toSkip.insert(toSkip.end(), toKeep.cbegin(), toKeep.cend());
+
+		//
+		// Find the elements close to the patch
+		//
+		// The structured data is searched once for the whole patch;
+		// each element found is then tested only against the elements
+		// of the patch whose bounding box it intersects, which are
+		// the same elements a search around each of them would give
+
+		vector<UInt> elems;
+		sd.getNeighbouringElements(bbox3d(SW, NE), toSkip, boxes, elems);
+
+		vector<array<point3d,3>> coor;
+		vector<bbox3d> elemBoxes;
+		coor.reserve(elems.size());
+		elemBoxes.reserve(elems.size());
+		for (auto elem : elems)
+		{
+			// Extract the vertices of the neighbouring element,
+			// taking the collapse into account
+			auto it = find(toKeep.cbegin(), toKeep.cend(), elem);
+			if (it != toKeep.cend())
+			{
+				auto & v = vertices[it - toKeep.cbegin()];
+				coor.push_back({{getNode(v[0]), getNode(v[1]), getNode(v[2])}});
+			}
+			else
+			{
+				auto & v = oprtr->getCPointerToMesh()->getElem(elem);
+				coor.push_back({{oprtr->getCPointerToMesh()->getCoor(v[0]),
+					oprtr->getCPointerToMesh()->getCoor(v[1]),
+					oprtr->getCPointerToMesh()->getCoor(v[2])}});
+			}
+			elemBoxes.emplace_back(elem, coor.back()[0], coor.back()[1], coor.back()[2]);
+		}
+
+		//
+		// Test self-intersections
+		//
+
+		triangleBatch batch;
+		batch.reserve(elems.size());
+		vector<uint64_t> mask;
+		for (UInt i = 0; i < toKeep.size(); ++i)
+		{
+			// Gather the neighbouring elements, then test them all at once
+			batch.clear();
+			for (UInt j = 0; j < elems.size(); ++j)
+				if ((elems[j] != toKeep[i]) && doIntersect(boxes[i], elemBoxes[j]))
+					batch.push_back(coor[j][0], coor[j][1], coor[j][2]);
+
+			intersection<Triangle>::intersect(getNode(vertices[i][0]),
+				getNode(vertices[i][1]), getNode(vertices[i][2]), batch, mask);
+			for (auto word : mask)
+				if (word)
+					return true;
+		}
+
+		return false;
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	template<MeshType MT>
+	INLINE point3d trialCollapse<Triangle, MT>::getNode(const UInt & Id) const
+	{
+		if (Id == id1)
+			return cPoint;
+		return oprtr->getCPointerToMesh()->getCoor(Id);
+	}
+
+
+	template<MeshType MT>
+	void trialCollapse<Triangle, MT>::getNode2Elem(const UInt & Id, vector<UInt> & elems) const
+	{
+		auto conn = oprtr->getCPointerToConnectivity();
+
+		// After the collapse, id1 would be connected to all elements
+		// previously connected either to id1 or id2
+		if (Id == id1)
+			set_union(conn->getNode2Elem(id1), conn->getNode2Elem(id2), elems);
+		else
+			elems.assign(conn->getNode2Elem(Id).begin(), conn->getNode2Elem(Id).end());
+
+		// The elements on the edge are gone
+		elems.erase(remove_if(elems.begin(), elems.end(), [&](const UInt & elem)
+			{ return find(toRemove.cbegin(), toRemove.cend(), elem) != toRemove.cend(); }),
+			elems.end());
+	}
+
+
+	template<MeshType MT>
+	void trialCollapse<Triangle, MT>::setupData()
+	{
+		dataReady = true;
+
+		// Data points whose connected elements are all involved in the collapse
+		auto invElems = oprtr->getElemsInvolvedInEdgeCollapsing(id1, id2);
+		toMove = oprtr->getDataModifiedInEdgeCollapsing(invElems);
+
+		// For each element to keep, the other data points are kept,
+		// while losing the connections with the elements on the edge
+		auto conn = oprtr->getCPointerToConnectivity();
+		fixedData.resize(toKeep.size());
+		for (UInt i = 0; i < toKeep.size(); ++i)
+			for (auto datum : conn->getElem2Data(toKeep[i]))
+				if (!binary_search(toMove.cbegin(), toMove.cend(), datum))
+				{
+					auto & elems = conn->getData2Elem(datum);
+					UInt patch(0);
+					for (auto elem : elems)
+						if (find(toRemove.cbegin(), toRemove.cend(), elem) == toRemove.cend())
+							++patch;
+					fixedData[i].emplace_back(datum, patch);
+				}
+	}
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*!	\file	imp_utility.hpp
+	\brief	Implementations of template members of class utility. */
+	
+#ifndef HH_IMPUTILITY_HH
+#define HH_IMPUTILITY_HH
+
+#include <type_traits>
+#include <stdexcept>
+
+namespace geometry
+{
+	template<typename T>
+	void utility::compact(vector<T> & v, const vector<UInt> & old2new)
+	{
+		// Check whether the map preserves the order
+		UInt count(0);
+		bool inPlace(true);
+		for (UInt i = 0; i < v.size(); ++i)
+			if (old2new[i] != REMOVED_ID)
+			{
+				inPlace = inPlace && (old2new[i] == count);
+				++count;
+			}
+		
+		if (inPlace)
+		{
+			count = 0;
+			for (UInt i = 0; i < v.size(); ++i)
+				if (old2new[i] != REMOVED_ID)
+					v[count++] = move(v[i]);
+			v.erase(v.begin() + count, v.end());
+		}
+		else
+		{
+			vector<T> w(count);
+			for (UInt i = 0; i < v.size(); ++i)
+				if (old2new[i] != REMOVED_ID)
+					w[old2new[i]] = move(v[i]);
+			v.swap(w);
+		}
+	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	template<typename T>
+	void utility::write(ostream & out, const T & val)
+	{
+		static_assert(is_trivially_copyable<T>::value,
+			"write() provided only for trivially copyable types.");
+		out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+	}
+	
+	
+	template<typename T>
+	void utility::write(ostream & out, const vector<T> & v)
+	{
+		static_assert(is_trivially_copyable<T>::value,
+			"write() provided only for vectors of trivially copyable types.");
+		UInt size(v.size());
+		write(out, size);
+		out.write(reinterpret_cast<const char *>(v.data()), size * sizeof(T));
+	}
+	
+	
+	template<typename T>
+	void utility::read(istream & in, T & val)
+	{
+		static_assert(is_trivially_copyable<T>::value,
+			"read() provided only for trivially copyable types.");
+		if (!in.read(reinterpret_cast<char *>(&val), sizeof(T)))
+			throw runtime_error("Unexpected end of checkpoint.");
+	}
+	
+	
+	template<typename T>
+	void utility::read(istream & in, vector<T> & v)
+	{
+		static_assert(is_trivially_copyable<T>::value,
+			"read() provided only for vectors of trivially copyable types.");
+		UInt size;
+		read(in, size);
+		v.resize(size);
+		if (!in.read(reinterpret_cast<char *>(v.data()), size * sizeof(T)))
+			throw runtime_error("Unexpected end of checkpoint.");
+	}
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*!	\file	imp_view.hpp
+	\brief	Definitions of members of class view. */
+
+#ifndef HH_IMPVIEW_HH
+#define HH_IMPVIEW_HH
+
+namespace geometry
+{
+	//
+	// Constructor
+	//
+
+	template<typename Iterator>
+	view<Iterator>::view(Iterator f, Iterator l, const UInt & n) :
+		first(f), last(l), sz(n)
+	{
+	}
+
+
+	//
+	// Access methods
+	//
+
+	template<typename Iterator>
+	INLINE Iterator view<Iterator>::begin() const
+	{
+		return first;
+	}
+
+
+	template<typename Iterator>
+	INLINE Iterator view<Iterator>::end() const
+	{
+		return last;
+	}
+
+
+	template<typename Iterator>
+	INLINE UInt view<Iterator>::size() const
+	{
+		return sz;
+	}
+
+
+	template<typename Iterator>
+	INLINE bool view<Iterator>::empty() const
+	{
+		return sz == 0;
+	}
+}
+
+#endif
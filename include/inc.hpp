@@ -4,6 +4,9 @@
 #ifndef HH_INC_HH
 #define HH_INC_HH
 
+#include <limits>
+#include <cstdint>
+
 #include "Eigen/Dense"
 
 namespace geometry
@@ -26,18 +29,49 @@ namespace geometry
 	/*! Tolerance. */
 	#define TOLL 1e-15
 	
-	/*! Maximum number of nodes a mesh class can store. */
-	#define MAX_NUM_NODES 1e8
+	/*! Maximum number of nodes and elements a mesh class can store.
+		The sizes read from a mesh file are checked against these limits,
+		so that a corrupted header is caught before any memory is reserved.
+		With 32-bit indices the limits stay well below REMOVED_ID; they are
+		raised when LARGE_INDICES is defined. */
+	#ifdef LARGE_INDICES
+		#define MAX_NUM_NODES 1e11
+		#define MAX_NUM_ELEMS 2e11
+	#else
+		#define MAX_NUM_NODES 1e9
+		#define MAX_NUM_ELEMS 2e9
+	#endif
 	
-	/*! Maximum number of elements a mesh class can store. */
-	#define MAX_NUM_ELEMS 1e8
+	/*! Image of a removed node or element in the old-to-new
+		maps returned by the refresh methods. */
+	#define REMOVED_ID numeric_limits<UInt>::max()
 		
 	//
 	// Aliases
 	//
 	
-	using UInt = unsigned int;
+	/*! Type of Id's and counters. By default, indices are 32-bit wide,
+		i.e. a mesh may store up to about four billion nodes and elements;
+		define LARGE_INDICES to use 64-bit indices for larger meshes. */
+	#ifdef LARGE_INDICES
+		using UInt = uint64_t;
+	#else
+		using UInt = unsigned int;
+	#endif
+	
+	/*! Type of floating-point computations. */
 	using Real = double;
+	
+	/*! Type of the coordinates of the nodes as stored in a mesh.
+		Define SINGLE_PRECISION_COORDINATES to store the coordinates in
+		single precision, so to halve the memory they take and the bandwidth
+		needed to scan them; they are still converted to Real when read, 
+		so that all computations (e.g. quadrics) are carried out in Real. */
+	#ifdef SINGLE_PRECISION_COORDINATES
+		using Coord = float;
+	#else
+		using Coord = Real;
+	#endif
 
 	//
 	// Namespaces
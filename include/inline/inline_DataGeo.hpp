@@ -77,7 +77,6 @@ namespace geometry
 	INLINE void DataGeo::imp_clear()
 	{
 		to_update = false;
-		this->cInfoList.clear();
 	} 
 }
 
@@ -0,0 +1,68 @@
+/*!	\file	inline_aabbTree.hpp
+	\brief	Implementations of inlined members of class aabbTree. */
+
+#ifndef HH_INLINEAABBTREE_HH
+#define HH_INLINEAABBTREE_HH
+
+namespace geometry
+{
+	//
+	// Get methods
+	//
+
+	INLINE UInt aabbTree::size() const
+	{
+		return boxes.size() + extra.size() - numErased;
+	}
+
+
+	INLINE Real aabbTree::getMaxGrowth() const
+	{
+		return maxGrowth;
+	}
+
+
+	INLINE UInt aabbTree::getNumRebuilds() const
+	{
+		return numRebuilds;
+	}
+
+
+	INLINE bool aabbTree::toRebuild() const
+	{
+		return (2 * numErased > boxes.size()) || (extra.size() > leafSize * (1 + boxes.size() / 64));
+	}
+
+
+	INLINE size_t aabbTree::getMemory() const
+	{
+		return nodes.capacity() * sizeof(node) +
+			(boxes.capacity() + extra.capacity()) * sizeof(bbox3d) +
+			(leaf.capacity() + location.capacity() + dirty.capacity()) * sizeof(UInt);
+	}
+
+
+	//
+	// Set methods
+	//
+
+	INLINE void aabbTree::setMaxGrowth(const Real & mg)
+	{
+		maxGrowth = mg;
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	INLINE Real aabbTree::getArea(const node & nd)
+	{
+		auto dx(nd.NE[0] - nd.SW[0]), dy(nd.NE[1] - nd.SW[1]), dz(nd.NE[2] - nd.SW[2]);
+		if ((dx < 0.) || (dy < 0.) || (dz < 0.))
+			return 0.;
+		return 2. * (dx*dy + dy*dz + dz*dx);
+	}
+}
+
+#endif
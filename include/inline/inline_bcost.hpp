@@ -78,6 +78,72 @@ namespace geometry
 	}
 	
 	
+	// Both OnlyGeo<MeshType::GEO> and OnlyGeo<MeshType::DATA> just need
+	// the edge end-points and the collapsing point
+	template<>
+	INLINE Real bcost<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>>::getCost
+		(const UInt & id1, const UInt & id2, const point3d & p, 
+		const trialCollapse<Triangle, MeshType::GEO> &)
+	{
+		return static_cast<const OnlyGeo<MeshType::GEO> *>(this)
+			->imp_getCost(id1, id2, p);
+	}
+	
+	
+	template<>
+	INLINE Real bcost<Triangle, MeshType::DATA, OnlyGeo<MeshType::DATA>>::getCost
+		(const UInt & id1, const UInt & id2, const point3d & p, 
+		const trialCollapse<Triangle, MeshType::DATA> &)
+	{
+		return static_cast<const OnlyGeo<MeshType::DATA> *>(this)
+			->imp_getCost(id1, id2, p);
+	}
+	
+	
+	// Specialization for DataGeo, requiring also the outcome of the collapse
+	template<>
+	INLINE Real bcost<Triangle, MeshType::DATA, DataGeo>::getCost
+		(const UInt & id1, const UInt & id2, const point3d & p, 
+		const trialCollapse<Triangle, MeshType::DATA> & trial)
+	{
+		return static_cast<DataGeo *>(this)
+			->imp_getCost(id1, id2, p, trial);
+	}
+	
+	
+	// Both OnlyGeo<MeshType::GEO> and OnlyGeo<MeshType::DATA> just need
+	// the edge end-points and the collapsing point
+	template<>
+	INLINE Real bcost<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>>::getCost_f
+		(const UInt & id1, const UInt & id2, const point3d & p, 
+		const trialCollapse<Triangle, MeshType::GEO> &) const
+	{
+		return static_cast<const OnlyGeo<MeshType::GEO> *>(this)
+			->imp_getCost_f(id1, id2, p);
+	}
+	
+	
+	template<>
+	INLINE Real bcost<Triangle, MeshType::DATA, OnlyGeo<MeshType::DATA>>::getCost_f
+		(const UInt & id1, const UInt & id2, const point3d & p, 
+		const trialCollapse<Triangle, MeshType::DATA> &) const
+	{
+		return static_cast<const OnlyGeo<MeshType::DATA> *>(this)
+			->imp_getCost_f(id1, id2, p);
+	}
+	
+	
+	// Specialization for DataGeo, requiring also the outcome of the collapse
+	template<>
+	INLINE Real bcost<Triangle, MeshType::DATA, DataGeo>::getCost_f
+		(const UInt & id1, const UInt & id2, const point3d & p, 
+		const trialCollapse<Triangle, MeshType::DATA> & trial) const
+	{
+		return static_cast<const DataGeo *>(this)
+			->imp_getCost_f(id1, id2, p, trial);
+	}
+	
+	
 	//
 	// Updating methods
 	//
@@ -99,12 +165,13 @@ namespace geometry
 		static_cast<OnlyGeo<MeshType::DATA> *>(this)->imp_update(newId);
 	}
 	
-	// Specialization for DataGeo, requiring also the Id's of the elements to remove
+	// Specialization for DataGeo, requiring also the Id of the removed node
+	// and the Id's of the elements to remove
 	template<>
 	INLINE void bcost<Triangle, MeshType::DATA, DataGeo>::update(const UInt & newId, const UInt & oldId,
 		const vector<UInt> & toRemove)
 	{
-		static_cast<DataGeo *>(this)->imp_update(newId, toRemove);
+		static_cast<DataGeo *>(this)->imp_update(newId, oldId, toRemove);
 	}
 }
 
@@ -0,0 +1,84 @@
+/*!	\file	inline_cartesianGrid.hpp
+	\brief	Definitions of inlined members of class cartesianGrid. */
+
+#ifndef HH_INLINECARTESIANGRID_HH
+#define HH_INLINECARTESIANGRID_HH
+
+namespace geometry
+{
+	//
+	// Get methods
+	//
+
+	INLINE point3d cartesianGrid::getNE() const
+	{
+		return NE;
+	}
+
+
+	INLINE point3d cartesianGrid::getSW() const
+	{
+		return SW;
+	}
+
+
+	INLINE Real cartesianGrid::getCellSize(const UInt & i) const
+	{
+		return cellSize[i];
+	}
+
+
+	INLINE array<Real,3> cartesianGrid::getCellSize() const
+	{
+		return cellSize;
+	}
+
+
+	INLINE UInt cartesianGrid::getNumCells(const UInt & i) const
+	{
+		return numCells[i];
+	}
+
+
+	INLINE array<UInt,3> cartesianGrid::getNumCells() const
+	{
+		return numCells;
+	}
+
+
+	INLINE UInt cartesianGrid::getTotalNumCells() const
+	{
+		return numCells[0] * numCells[1] * numCells[2];
+	}
+
+
+	INLINE UInt cartesianGrid::getCell(const Real & x, const UInt & i) const
+	{
+		auto t = (x - SW[i]) / cellSize[i];
+		if (t <= 0.)
+			return 0;
+		auto c = static_cast<UInt>(t);
+		return (c < numCells[i]) ? c : numCells[i] - 1;
+	}
+
+
+	INLINE array<UInt,3> cartesianGrid::getCells(const point3d & p) const
+	{
+		return {{getCell(p[0], 0), getCell(p[1], 1), getCell(p[2], 2)}};
+	}
+
+
+	INLINE UInt cartesianGrid::getIdx(const point3d & p) const
+	{
+		return getCell(p[0], 0) + getCell(p[1], 1) * numCells[0] +
+			getCell(p[2], 2) * numCells[0] * numCells[1];
+	}
+
+
+	INLINE UInt cartesianGrid::getIdx(const bbox3d & bb) const
+	{
+		return getIdx(0.5*(bb.getNE() + bb.getSW()));
+	}
+}
+
+#endif
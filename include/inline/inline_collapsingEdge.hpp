@@ -50,6 +50,12 @@ namespace geometry
 	}
 	
 	
+	INLINE array<Real,3> collapsingEdge::getComponents() const
+	{
+		return components;
+	}
+	
+	
 	//
 	// Set methods
 	//
@@ -76,6 +82,12 @@ namespace geometry
 	{
 		cost = val;
 	}
+	
+	
+	INLINE void collapsingEdge::setComponents(const array<Real,3> & cmp)
+	{
+		components = cmp;
+	}
 }
 
 #endif
@@ -0,0 +1,87 @@
+/*!	\file	inline_collapsingQueue.hpp
+	\brief	Implementations of inlined members of class collapsingQueue. */
+
+#ifndef HH_INLINECOLLAPSINGQUEUE_HH
+#define HH_INLINECOLLAPSINGQUEUE_HH
+
+namespace geometry
+{
+	//
+	// Access members
+	//
+
+	INLINE UInt collapsingQueue::size() const
+	{
+		return numEdges;
+	}
+
+
+	INLINE UInt collapsingQueue::getHeapSize() const
+	{
+		return heap.size();
+	}
+
+
+	INLINE bool collapsingQueue::empty() const
+	{
+		return numEdges == 0;
+	}
+
+
+	INLINE const collapsingEdge & collapsingQueue::top() const
+	{
+		return heap.front().cEdge;
+	}
+
+
+	INLINE bool collapsingQueue::find(const UInt & id1, const UInt & id2) const
+	{
+		auto h = edges->find(id1,id2);
+		return (h < pos.size()) && (pos[h] != edgeTable::none);
+	}
+
+
+	INLINE QueueMode collapsingQueue::getMode() const
+	{
+		return mode;
+	}
+
+
+	INLINE Real collapsingQueue::getStaleBound() const
+	{
+		return staleBound;
+	}
+
+
+	//
+	// Set methods
+	//
+
+	INLINE void collapsingQueue::setStaleBound(const Real & sb)
+	{
+		staleBound = sb;
+	}
+
+
+	//
+	// Heap handling
+	//
+
+	INLINE bool collapsingQueue::isValid(const entry & e) const
+	{
+		if (mode == QueueMode::ADDRESSABLE)
+			return true;
+
+		return pos[e.handle] == e.version;
+	}
+
+
+	INLINE void collapsingQueue::place(const UInt & i, const entry & e)
+	{
+		heap[i] = e;
+		if (mode == QueueMode::ADDRESSABLE)
+			pos[e.handle] = i;
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*!	\file	inline_edgeTable.hpp
+	\brief	Implementations of inlined members of class edgeTable. */
+
+#ifndef HH_INLINEEDGETABLE_HH
+#define HH_INLINEEDGETABLE_HH
+
+namespace geometry
+{
+	//
+	// Get methods
+	//
+
+	INLINE UInt edgeTable::size() const
+	{
+		return ends.size() - freeHandles.size();
+	}
+
+
+	INLINE bool edgeTable::empty() const
+	{
+		return size() == 0;
+	}
+
+
+	INLINE UInt edgeTable::getNumHandles() const
+	{
+		return ends.size();
+	}
+
+
+	INLINE UInt edgeTable::find(const UInt & id1, const UInt & id2) const
+	{
+		auto i = findSlot(min(id1,id2), max(id1,id2));
+		return (i == none) ? none : slots[i].handle;
+	}
+
+
+	INLINE bool edgeTable::isValid(const UInt & h) const
+	{
+		return (h < ends.size()) && (ends[h][0] != none);
+	}
+
+
+	INLINE const array<UInt,2> & edgeTable::getEnds(const UInt & h) const
+	{
+		return ends[h];
+	}
+
+
+	INLINE const vector<array<UInt,2>> & edgeTable::getEnds() const
+	{
+		return ends;
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	INLINE uint64_t edgeTable::key(const UInt & id1, const UInt & id2)
+	{
+		return (static_cast<uint64_t>(id1) << 32) ^ static_cast<uint64_t>(id2);
+	}
+
+
+	INLINE uint64_t edgeTable::key(const slot & s)
+	{
+		return key(s.id1, s.id2);
+	}
+
+
+	INLINE UInt edgeTable::home(const uint64_t & k) const
+	{
+		return static_cast<UInt>((k * 0x9E3779B97F4A7C15ull) >> shift);
+	}
+
+
+	INLINE UInt edgeTable::distance(const UInt & i) const
+	{
+		return (i - home(key(slots[i]))) & (slots.size() - 1);
+	}
+
+
+	INLINE UInt edgeTable::findSlot(const UInt & id1, const UInt & id2) const
+	{
+		// Probe until either the edge, an empty slot or an entry
+		// closer to its home slot than the edge would be is found
+		UInt mask(slots.size() - 1);
+		for (UInt i = home(key(id1,id2)), d = 0; ; i = (i+1) & mask, ++d)
+		{
+			if (slots[i].id1 == none)
+				return none;
+			if ((slots[i].id1 == id1) && (slots[i].id2 == id2))
+				return i;
+			if (distance(i) < d)
+				return none;
+		}
+	}
+}
+
+#endif
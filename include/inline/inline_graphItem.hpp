@@ -30,12 +30,36 @@ namespace geometry
 	}
 	
 	
+	INLINE const UInt & graphItem::operator[](const UInt & i) const 
+	{
+		return *(conn.cbegin() + i);
+	}
+	
+	
+	INLINE flatSet<UInt>::const_iterator graphItem::begin() const 
+	{
+		return conn.cbegin();
+	}
+	
+	
+	INLINE flatSet<UInt>::const_iterator graphItem::end() const 
+	{
+		return conn.cend();
+	}
+	
+	
 	INLINE bool graphItem::isActive() const 
 	{
 		return active;
 	}
 	
 	
+	INLINE size_t graphItem::getMemory() const 
+	{
+		return sizeof(graphItem) + conn.getHeapMemory();
+	}
+	
+	
 	INLINE void graphItem::setId(const UInt & ID) 
 	{
 		Id = ID;
@@ -56,7 +80,7 @@ namespace geometry
 	
 	INLINE bool graphItem::find(const UInt & val) const 
 	{
-		return std::find(conn.cbegin(), conn.cend(), val) != conn.cend();
+		return conn.find(val) != conn.cend();
 	}
 	
 	
@@ -68,7 +92,7 @@ namespace geometry
 	
 	INLINE void graphItem::insert(const set<UInt> & s)
 	{
-		set_union(conn.begin(), conn.end(), s.cbegin(), s.cend(), inserter(conn, conn.begin()));
+		conn.insert(s.cbegin(), s.cend());
 	}
 	
 	
@@ -78,7 +102,7 @@ namespace geometry
 	}
 	
 	
-	INLINE void graphItem::erase(set<UInt>::iterator it) 
+	INLINE void graphItem::erase(flatSet<UInt>::iterator it) 
 	{
 		conn.erase(it);
 	}
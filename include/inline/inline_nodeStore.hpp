@@ -0,0 +1,135 @@
+/*!	\file	inline_nodeStore.hpp
+	\brief	Implementations of inlined members of class nodeStore. */
+
+#ifndef HH_INLINENODESTORE_HH
+#define HH_INLINENODESTORE_HH
+
+namespace geometry
+{
+	//
+	// Operators
+	//
+
+	INLINE point nodeStore::operator[](const UInt & Id) const
+	{
+		point p(x[Id], y[Id], z[Id], Id, getBoundary(Id));
+		if (!isActive(Id))
+			p.setInactive();
+		return p;
+	}
+
+
+	//
+	// Get methods
+	//
+
+	INLINE point3d nodeStore::getCoor(const UInt & Id) const
+	{
+		return point3d({x[Id], y[Id], z[Id]});
+	}
+
+
+	INLINE const Coord * nodeStore::getX() const
+	{
+		return x.data();
+	}
+
+
+	INLINE const Coord * nodeStore::getY() const
+	{
+		return y.data();
+	}
+
+
+	INLINE const Coord * nodeStore::getZ() const
+	{
+		return z.data();
+	}
+
+
+	INLINE const uint8_t * nodeStore::getFlags() const
+	{
+		return flags.data();
+	}
+
+
+	INLINE UInt nodeStore::getBoundary(const UInt & Id) const
+	{
+		return flags[Id] & ~activeBit;
+	}
+
+
+	INLINE bool nodeStore::isActive(const UInt & Id) const
+	{
+		return flags[Id] & activeBit;
+	}
+
+
+	INLINE UInt nodeStore::size() const
+	{
+		return x.size();
+	}
+
+
+	//
+	// Set methods
+	//
+
+	INLINE void nodeStore::set(const UInt & Id, const point & p)
+	{
+		x[Id] = p[0];
+		y[Id] = p[1];
+		z[Id] = p[2];
+		setBoundary(Id, p.getBoundary());
+	}
+
+
+	INLINE void nodeStore::setCoor(const UInt & Id, const array<Real,3> & c)
+	{
+		x[Id] = c[0];
+		y[Id] = c[1];
+		z[Id] = c[2];
+	}
+
+
+	INLINE void nodeStore::setBoundary(const UInt & Id, const UInt & bond)
+	{
+		flags[Id] = (flags[Id] & activeBit) | bond;
+	}
+
+
+	INLINE void nodeStore::setActive(const UInt & Id)
+	{
+		flags[Id] |= activeBit;
+	}
+
+
+	INLINE void nodeStore::setInactive(const UInt & Id)
+	{
+		flags[Id] &= ~activeBit;
+	}
+
+
+	//
+	// Insert methods
+	//
+
+	INLINE void nodeStore::push_back(const array<Real,3> & c, const UInt & bond)
+	{
+		x.push_back(c[0]);
+		y.push_back(c[1]);
+		z.push_back(c[2]);
+		flags.push_back(activeBit | bond);
+	}
+
+
+	INLINE void nodeStore::push_back(const point & p)
+	{
+		x.push_back(p[0]);
+		y.push_back(p[1]);
+		z.push_back(p[2]);
+		flags.push_back((p.isActive() ? activeBit : 0) | p.getBoundary());
+	}
+}
+
+#endif
@@ -28,42 +28,6 @@ namespace geometry
 	}
 			
 	
-	INLINE point3d searchPoint::getGlobalNE() 
-	{
-		return searchPoint::NE_global;
-	}
-				
-	
-	INLINE point3d searchPoint::getGlobalSW() 
-	{
-		return searchPoint::SW_global;
-	}
-	
-	
-	INLINE Real searchPoint::getCellSize(const UInt & i) 
-	{
-		return searchPoint::cellSize[i];
-	}
-	
-	
-	INLINE array<Real,3> searchPoint::getCellSize() 
-	{
-		return searchPoint::cellSize;
-	}
-	
-	
-	INLINE UInt searchPoint::getNumCells(const UInt & i) 
-	{
-		return searchPoint::numCells[i];
-	}
-	
-	
-	INLINE array<UInt,3> searchPoint::getNumCells() 
-	{
-		return searchPoint::numCells;
-	}
-	
-	
 	INLINE void searchPoint::setId(const UInt & idNew) 
 	{
 		Id = idNew;
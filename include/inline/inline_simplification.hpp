@@ -6,34 +6,6 @@
 
 namespace geometry
 {
-	//
-	// Get methods
-	//
-	
-	template<MeshType MT, typename CostClass>
-	INLINE const mesh<Triangle,MT> * simplification<Triangle, MT, CostClass>::
-		getCPointerToMesh() const
-	{
-		return this->gridOperation.getCPointerToMesh();
-	}
-			
-	
-	template<MeshType MT, typename CostClass>
-	INLINE const connect<Triangle,MT> * simplification<Triangle, MT, CostClass>::
-		getCPointerToConnectivity() const
-	{
-		return this->gridOperation.getCPointerToConnectivity();
-	}
-	
-	
-	template<MeshType MT, typename CostClass>
-	INLINE const bmeshOperation<Triangle,MT> * simplification<Triangle, MT, CostClass>::
-		getCPointerToMeshOperator() const
-	{
-		return &this->gridOperation;
-	}
-		
-	
 	//
   	// Compute cost and apply collapse
   	//
@@ -0,0 +1,61 @@
+/*!	\file	inline_triangleBatch.hpp
+	\brief	Implementations of inlined members of class triangleBatch. */
+
+#ifndef HH_INLINETRIANGLEBATCH_HH
+#define HH_INLINETRIANGLEBATCH_HH
+
+namespace geometry
+{
+	//
+	// Get methods
+	//
+
+	INLINE UInt triangleBatch::size() const
+	{
+		return coor[0].size();
+	}
+
+
+	INLINE const Real * triangleBatch::data(const UInt & v, const UInt & i) const
+	{
+		return coor[3*v + i].data();
+	}
+
+
+	INLINE point3d triangleBatch::getVertex(const UInt & k, const UInt & v) const
+	{
+		return point3d(coor[3*v][k], coor[3*v+1][k], coor[3*v+2][k]);
+	}
+
+
+	//
+	// Modify the batch
+	//
+
+	INLINE void triangleBatch::push_back(const point3d & D, const point3d & E,
+		const point3d & F)
+	{
+		for (UInt i = 0; i < 3; ++i)
+		{
+			coor[i].push_back(D[i]);
+			coor[3+i].push_back(E[i]);
+			coor[6+i].push_back(F[i]);
+		}
+	}
+
+
+	INLINE void triangleBatch::clear()
+	{
+		for (auto & c : coor)
+			c.clear();
+	}
+
+
+	INLINE void triangleBatch::reserve(const UInt & n)
+	{
+		for (auto & c : coor)
+			c.reserve(n);
+	}
+}
+
+#endif
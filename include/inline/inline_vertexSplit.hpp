@@ -0,0 +1,59 @@
+/*!	\file	inline_vertexSplit.hpp
+	\brief	Implementations of inlined members of class vertexSplit. */
+	
+#ifndef HH_INLINEVERTEXSPLIT_HH
+#define HH_INLINEVERTEXSPLIT_HH
+
+namespace geometry
+{
+	//
+	// Get methods
+	//
+	
+	INLINE UInt vertexSplit::getId1() const
+	{
+		return Id1;
+	}
+	
+	
+	INLINE UInt vertexSplit::getId2() const
+	{
+		return Id2;
+	}
+	
+	
+	INLINE point3d vertexSplit::getCollapsingPoint() const
+	{
+		return cPoint;
+	}
+	
+	
+	INLINE const vector<UInt> & vertexSplit::getElemsToRemove() const
+	{
+		return toRemove;
+	}
+	
+	
+	INLINE const vector<UInt> & vertexSplit::getElemsToRedirect() const
+	{
+		return toRedirect;
+	}
+	
+	
+	INLINE const vector<pair<UInt,point3d>> & vertexSplit::getMovedData() const
+	{
+		return movedData;
+	}
+	
+	
+	//
+	// Set methods
+	//
+	
+	INLINE void vertexSplit::addMovedData(const UInt & id, const point3d & p)
+	{
+		movedData.emplace_back(id, p);
+	}
+}
+
+#endif
@@ -6,9 +6,11 @@
 
 #include <memory>
 #include <tuple>
+#include <cstdint>
 
 #include "gutility.hpp"
 #include "mesh.hpp"
+#include "triangleBatch.hpp"
 
 namespace geometry
 {			
@@ -20,6 +22,12 @@ namespace geometry
 		At the moment, only the specialization for triangles is
 		implemented. Further specializations may be added in future. 
 		
+		A triangle can also be tested against a batch of triangles at
+		once. The pairs which can not intersect are first discarded
+		through SIMD instructions (AVX when the library is compiled
+		with ENABLE_AVX2, SSE2 otherwise), so that the exact test
+		only runs on the few remaining ones.
+		
 		Reference: 
 		O’Rourke J. "Computational geometry in C". 
 		Cambridge (UK), Cambridge University Press, 1998. */
@@ -77,6 +85,30 @@ namespace geometry
 				\param F	third vertex of second triangle */
 			static bool intersect(const point3d & A, const point3d & B, const point3d & C, 
 				const point3d & D, const point3d & E, const point3d & F);
+			
+			/*!	Check the intersection between a triangle and a batch
+				of triangles. A pair is discarded when a triangle lies
+				strictly on one side of the plane of the other one, or when
+				the intervals the triangles cut on the intersection line
+				of their planes are disjoint (Moller's test). Both tests keep
+				a margin proportional to the magnitude of the coordinates,
+				so that the result coincides with the one of the static
+				interface, which is called on the other pairs.
+				
+				\param A		first vertex of the triangle
+				\param B		second vertex of the triangle
+				\param C		third vertex of the triangle
+				\param batch	the other triangles
+				\param mask		buffer filled with a bitmask: the k%64-th bit
+								of mask[k/64] is set iff the triangle and the
+								k-th triangle of the batch intersect in a
+								non-conformal way; previous content is removed
+				
+				Reference:
+				Moller T. "A fast triangle-triangle intersection test".
+				Journal of Graphics Tools, 2(2), 1997. */
+			static void intersect(const point3d & A, const point3d & B, const point3d & C,
+				const triangleBatch & batch, vector<uint64_t> & mask);
 	};
 }
 
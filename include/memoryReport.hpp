@@ -0,0 +1,83 @@
+/*!	\file	memoryReport.hpp
+	\brief	Class reporting the memory occupied by a simplification process. */
+
+#ifndef HH_MEMORYREPORT_HH
+#define HH_MEMORYREPORT_HH
+
+#include <iostream>
+
+#include "inc.hpp"
+
+namespace geometry
+{
+	/*!	This is a merely storing class collecting the memory occupied
+		by each component of a simplification process, in bytes.
+		Each class owning a component fills the corresponding field(s)
+		through its method getMemory(memoryReport &), so that the report
+		can be built up by walking through the components. The capacity
+		of the containers is accounted for, not just their size: inactive
+		nodes and elements and the space left by a refresh count as well.
+		The fields of the components not employed (e.g. the data points
+		for purely geometric meshes) are left to zero.
+
+		\sa simplification.hpp */
+	struct memoryReport
+	{
+		/*!	Nodes of the mesh. */
+		size_t nodes = 0;
+
+		/*!	Elements of the mesh. */
+		size_t elems = 0;
+
+		/*!	Data points of the mesh. */
+		size_t data = 0;
+
+		/*!	Node-node connections. */
+		size_t node2node = 0;
+
+		/*!	Node-element connections. */
+		size_t node2elem = 0;
+
+		/*!	Data-element connections. */
+		size_t data2elem = 0;
+
+		/*!	Element-data connections. */
+		size_t elem2data = 0;
+
+		/*!	Set of edges of the connectivity. */
+		size_t edges = 0;
+
+		/*!	Bounding boxes of the structured data. */
+		size_t boxes = 0;
+
+		/*!	Queue of collapsingEdge's. */
+		size_t collapsingSet = 0;
+
+		/*!	Q matrices of the cost class. */
+		size_t Qs = 0;
+
+		/*!	Original locations of the data points, stored by the cost class. */
+		size_t dataOrigin = 0;
+
+		/*!	Quantities of information of the elements, stored by the cost class. */
+		size_t qoi = 0;
+
+		/*!	Any other state of the cost class. */
+		size_t cost = 0;
+
+		/*!	Collapse log, together with the copy of the original mesh. */
+		size_t log = 0;
+
+		/*!	Get the overall memory.
+			\return		number of bytes */
+		size_t total() const;
+
+		/*!	Output stream operator; the memory is printed in KiB.
+			\param out	output stream
+			\param mr	the report
+			\return		updated output stream */
+		friend ostream & operator<<(ostream & out, const memoryReport & mr);
+	};
+}
+
+#endif
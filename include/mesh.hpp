@@ -185,13 +185,18 @@ namespace geometry
 			
 			/*! Get a data point.
 				\param Id	point Id
-				\return		the data point */
-			dataPoint getData(const UInt & Id) const;
+				\return		non-owning reference to the data point */
+			const dataPoint & getData(const UInt & Id) const;
 			
 			/*! Get number of data point.
 				\return		number of data */
 			UInt getNumData() const;
 			
+			/*!	Get the memory occupied by nodes, elements and data points.
+				\param mr	the report, whose fields for nodes, elements
+							and data are set */
+			virtual void getMemory(memoryReport & mr) const;
+			
 			//
 			// Set methods
 			//
@@ -241,6 +246,27 @@ namespace geometry
 			/*! Clear the lists. */
 			virtual void clear();
 			
+			/*!	Release the memory not used by the lists. */
+			virtual void shrinkToFit();
+			
+			/*!	Re-number the data points along the Morton curve,
+				as reorder() does for nodes and elements.
+				\return		old-to-new map for data points Id's */
+			vector<UInt> reorderData();
+			
+			//
+			// Binary input/output
+			//
+			
+			/*!	Write the mesh and the data points in binary format.
+				\param out	output stream */
+			virtual void save(ostream & out) const;
+			
+			/*!	Read the mesh and the data points from binary format,
+				as written by save().
+				\param in	input stream */
+			virtual void load(istream & in);
+			
 		protected:
 			//
 			// Update Id's
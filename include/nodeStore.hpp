@@ -0,0 +1,191 @@
+/*!	\file	nodeStore.hpp
+	\brief	Class storing the nodes of a mesh as a structure of arrays. */
+
+#ifndef HH_NODESTORE_HH
+#define HH_NODESTORE_HH
+
+#include <vector>
+#include <cstdint>
+
+#include "point.hpp"
+
+namespace geometry
+{
+	/*!	This class stores the nodes of a mesh as a structure of arrays:
+		the x-, y- and z-coordinates are kept in three contiguous arrays,
+		while boundary and active flags are packed in a byte per node.
+		The Id of a node is its position in the store.
+
+		Compared to a vector of point's, each node takes 25 bytes
+		rather than 40 (13 bytes if the coordinates are stored in single
+		precision, see inc.hpp), and a loop over a coordinate of all the
+		nodes (e.g. to get the bounding box of the mesh) reads contiguous
+		memory and can then be vectorized by the compiler. The
+		geometric kernels may read the coordinates of a node directly
+		through getCoor(), or through the raw arrays.
+
+		The interface mimics the one of a vector of point's: a node is
+		returned as a point by value and it is assigned as the copy
+		assignment operator of point does, i.e. only coordinates and
+		boundary flag are copied. */
+	class nodeStore
+	{
+		public:
+			/*!	Mask for the bit flagging active nodes. */
+			static constexpr uint8_t activeBit = 0x80;
+
+		private:
+			/*!	Coordinates. */
+			vector<Coord> x, y, z;
+
+			/*!	Flags: the lowest bits store the boundary flag,
+				the highest bit is set for active nodes. */
+			vector<uint8_t> flags;
+
+		public:
+			//
+			// Constructors
+			//
+
+			/*!	Synthetic default constructor. */
+			nodeStore() = default;
+
+			/*!	Constructor.
+				\param nds	vector of nodes; their Id's are disregarded */
+			nodeStore(const vector<point> & nds);
+
+			//
+			// Operators
+			//
+
+			/*!	Get a node.
+				\param Id	node Id
+				\return		the node */
+			point operator[](const UInt & Id) const;
+
+			//
+			// Get methods
+			//
+
+			/*!	Get the coordinates of a node.
+				\param Id	node Id
+				\return		the coordinates */
+			point3d getCoor(const UInt & Id) const;
+
+			/*!	Get the x-coordinates of all nodes.
+				\return		pointer to the first x-coordinate */
+			const Coord * getX() const;
+
+			/*!	Get the y-coordinates of all nodes.
+				\return		pointer to the first y-coordinate */
+			const Coord * getY() const;
+
+			/*!	Get the z-coordinates of all nodes.
+				\return		pointer to the first z-coordinate */
+			const Coord * getZ() const;
+
+			/*!	Get the boundary flag of a node.
+				\param Id	node Id
+				\return		the boundary flag */
+			UInt getBoundary(const UInt & Id) const;
+
+			/*!	Get the flags of all nodes; a node is active
+				if the bit nodeStore::activeBit is set.
+				\return		pointer to the first flag */
+			const uint8_t * getFlags() const;
+
+			/*!	Know whether a node is active or not.
+				\param Id	node Id
+				\return		TRUE if the node is active, FALSE otherwise */
+			bool isActive(const UInt & Id) const;
+
+			/*!	Get the number of nodes, both active and inactive.
+				\return		number of nodes */
+			UInt size() const;
+
+			/*!	Get the memory occupied by the store.
+				\return		number of bytes */
+			size_t getMemory() const;
+
+			/*!	Get all nodes as point's.
+				\return		vector of nodes */
+			vector<point> getNodes() const;
+
+			//
+			// Set methods
+			//
+
+			/*!	Set coordinates and boundary flag of a node,
+				leaving its active flag unchanged.
+				\param Id	node Id
+				\param p	the point */
+			void set(const UInt & Id, const point & p);
+
+			/*!	Set coordinates of a node.
+				\param Id	node Id
+				\param c	the new coordinates */
+			void setCoor(const UInt & Id, const array<Real,3> & c);
+
+			/*!	Set the boundary flag of a node.
+				\param Id	node Id
+				\param bond	the new boundary flag */
+			void setBoundary(const UInt & Id, const UInt & bond);
+
+			/*!	Set a node as active.
+				\param Id	node Id */
+			void setActive(const UInt & Id);
+
+			/*!	Set a node as inactive.
+				\param Id	node Id */
+			void setInactive(const UInt & Id);
+
+			//
+			// Insert, erase and resize methods
+			//
+
+			/*!	Insert a node at the back, as an active node.
+				\param c	coordinates
+				\param bond	boundary flag */
+			void push_back(const array<Real,3> & c, const UInt & bond = 0);
+
+			/*!	Insert a node at the back.
+				\param p	the node; its Id is disregarded */
+			void push_back(const point & p);
+
+			/*!	Erase a node; the following nodes are shifted back.
+				\param Id	node Id */
+			void erase(const UInt & Id);
+
+			/*!	Remove the inactive nodes, keeping the active ones
+				in the same order.
+				\return		old-to-new map for nodes Id's; removed
+							nodes are mapped to REMOVED_ID */
+			vector<UInt> compact();
+
+			/*!	Move the nodes according to an old-to-new map,
+				e.g. the one given by a re-ordering of the mesh.
+				\param old2new	old-to-new map for nodes Id's */
+			void permute(const vector<UInt> & old2new);
+
+			/*!	Remove all nodes. */
+			void clear();
+
+			/*!	Reserve memory.
+				\param n	number of nodes */
+			void reserve(const UInt & n);
+
+			/*!	Resize the store; new nodes are active and lie in the origin.
+				\param n	number of nodes */
+			void resize(const UInt & n);
+
+			/*!	Release the memory not used by the nodes. */
+			void shrinkToFit();
+	};
+}
+
+/*! Include definitions of inlined members. */
+#ifdef INLINED
+#include "inline/inline_nodeStore.hpp"
+#endif
+
+#endif
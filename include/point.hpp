@@ -61,8 +61,8 @@ namespace geometry
 				\param p	point */
 		    point(const point & p) = default;
 
-			/*! Destructor */
-		    virtual ~point() = default;
+			/*! Synthetic destructor. */
+		    ~point() = default;
 			
 			//
 			// Operators
@@ -70,7 +70,7 @@ namespace geometry
 			
 			/*! The equality operator. 
 				\param p	point */
-			virtual point & operator=(const point & p);
+			point & operator=(const point & p);
 			
 			/*! Output stream operator.
 				\param out	output stream
@@ -95,7 +95,25 @@ namespace geometry
 			static tuple<Real, point3d, UInt> project(const point3d & P, 
 				const point3d & A, const point3d & B, const point3d & C,
 				const point3d & N, const Real & D, const UInt & x, const UInt & y);
-											
+
+			/*!	Project a set of points on a set of triangles, each point
+				onto the closest triangle.
+				This method does not access any mesh, so it can be used
+				to project on triangles which are not (yet) part of the mesh,
+				e.g. the triangles resulting from a trial edge collapse.
+
+				\param P	the points to project
+				\param A	first vertex of each triangle
+				\param B	second vertex of each triangle
+				\param C	third vertex of each triangle
+				\return		for each point, an STL tuple storing the projected
+							point, the index of the triangle it falls within
+							(in the input vectors) and the position of the
+							projection within the triangle (as given by the
+							single-point project()) */
+			static vector<tuple<point3d, UInt, UInt>> project(const vector<point3d> & P,
+				const vector<point3d> & A, const vector<point3d> & B, const vector<point3d> & C);
+
 			//
 			// Non-static interface
 			//
@@ -4,14 +4,22 @@
 #ifndef HH_SIMPLIFICATION_HH
 #define HH_SIMPLIFICATION_HH
 
+#include <random>
+#include <memory>
+
 #include "utility.hpp"
 #include "bmeshOperation.hpp"
 #include "bcost.hpp"
 #include "OnlyGeo.hpp"
 #include "DataGeo.hpp"
 #include "collapsingEdge.hpp"
+#include "collapsingQueue.hpp"
+#include "edgeTable.hpp"
 #include "structuredData.hpp"
 #include "intersection.hpp"
+#include "trialCollapse.hpp"
+#include "vertexSplit.hpp"
+#include "memoryReport.hpp"
 
 namespace geometry
 {
@@ -21,10 +29,10 @@ namespace geometry
 		the loss of information is just geometrical, otherwise for meshType MT::DATA the cost
 		functional takes into account the loss of statistical information as well.
 		At each iteration the edge with minimum cost is collapsed into a predefined point.
-		The edges are organized in a set in ascending order with respect to their costs called
-		collapsingSet which is used to extract the edge to contract. In case the edge has to be
-		searched for its ending points, refer to the unordered set cInfoList contained in the
-		cost class object.
+		The edges are organized in a priority queue in ascending order with respect to their costs
+		called collapsingSet which is used to extract the edge to contract. The queue is addressable
+		by the edge end-points too, so that an edge can be found, erased or have its cost changed
+		without knowing its current cost.
 		The point for the collapse is chosen among the two ending points of the selected edge,
 		their middle point and the so-called optimal point. The latter derives from an explicit
 		analytical formula based on proposition 5.2.2 from the thesis essay "Advanced Techniques for the
@@ -56,11 +64,28 @@ namespace geometry
 				- if MT::GEO, it corresponds to a meshInfo object
 				- if MT::DATA, it is a projection object to handle distrubuted data
 			\param costObj, cost class of CostClass
-			\param collapsingSet, set of collapsingEdge's ordered by cost in ascending order
+			\param collapsingSet, queue of collapsingEdge's ordered by cost in ascending order
 			\param structData, structured data necessary to support the intersection control
 			\param intersec, interesection object for the related control
 			\param dontTouch, boolean to indicate if the fixed element is used
 			\param dontTouchId, id of the fixed element 
+			\param numThreads, number of threads computing the costs when (re-)building the queue
+			\param numChoices, number of random candidates for the multiple-choice scheduler
+			\param seed, seed for the multiple-choice scheduler
+			\param numRecomputations, number of edge costs re-computed after the collapses
+			\param numRingRecomputations, number of edge costs the ring-based rule would re-compute
+			\param ringStats, boolean to indicate if numRingRecomputations is counted
+			\param logEnabled, boolean to indicate if the collapses are recorded
+			\param logOrigin, copy of the mesh before the recorded collapses
+			\param collapseLog, recorded collapses, i.e. a progressive mesh
+			\param engine, random engine for the multiple-choice scheduler
+			\param checkpointFile, path to the checkpoint file
+			\param checkpointStep, number of collapsed nodes between two checkpoints
+			\param memoryBudget, memory cap for the simplification process
+			\param memoryStep, number of collapsed nodes between two checks on the memory
+			\param numCompactions, number of compactions performed to stay within the memory cap
+			\param reordering, boolean to indicate if the mesh is re-ordered at every refresh
+			\param resumed, boolean to indicate if the state has been restored from a checkpoint
 			
 		\sa OnlyGeo.hpp, DataGeo.hpp */
     template<typename SHAPE, MeshType MT, typename CostClass> 
@@ -79,8 +104,9 @@ namespace geometry
 			/*! CostClass object for the cost computing of the edges. */
 			CostClass					costObj;
 
-			/*! Set of edges ordered by cost (ascending order). */
-			set<collapsingEdge>			collapsingSet;
+			/*! Queue of edges ordered by cost (ascending order)
+				and addressable by end-points. */
+			collapsingQueue				collapsingSet;
 
 			/*! Object for the bounding boxes structure.  */
 			structuredData<Triangle>	structData;
@@ -95,6 +121,76 @@ namespace geometry
 			/*! Id of the fixed element. */
 			UInt	  					dontTouchId;
 			
+			/*! TRUE if collapsingSet has been built, FALSE otherwise. */
+			bool						collapsingSetReady;
+			
+			/*! Number of threads employed to (re-)build the queue. */
+			UInt						numThreads;
+			
+			/*! Number of edges sampled at each iteration by the multiple-choice
+				scheduler; if zero, the edges are extracted from collapsingSet. */
+			UInt						numChoices;
+			
+			/*! Seed for the random engine of the multiple-choice scheduler. */
+			UInt						seed;
+			
+			/*! Number of edge costs re-computed after the collapses
+				performed by the last call to simplify(). */
+			UInt						numRecomputations;
+			
+			/*! Number of edge costs which would have been re-computed
+				by re-computing all the edges within the 2-ring (1-ring for
+				purely geometric grids) of the collapsing node; counted only
+				if ringStats is set. */
+			UInt						numRingRecomputations;
+			
+			/*! TRUE if numRingRecomputations is counted, FALSE otherwise. */
+			bool						ringStats;
+			
+			/*! TRUE if simplify() records the collapses, FALSE otherwise. */
+			bool						logEnabled;
+			
+			/*! Copy of the mesh at the beginning of the last call to
+				simplify(), taken only if the collapses are recorded.
+				The copy constructor is employed, since the assignment
+				operator of mesh does not preserve the data points. */
+			unique_ptr<mesh<Triangle,MT>>	logOrigin;
+			
+			/*! Collapses performed by the last call to simplify(), in order.
+				The Id's refer to logOrigin. */
+			vector<vertexSplit>			collapseLog;
+			
+			/*! Random engine for the multiple-choice scheduler. It is re-seeded
+				at each call to simplify(), unless resuming from a checkpoint. */
+			mt19937						engine;
+			
+			/*! Path to the file where simplify() writes the checkpoints. */
+			string						checkpointFile;
+			
+			/*! Number of nodes to collapse between two checkpoints;
+				if zero, no checkpoint is written. */
+			UInt						checkpointStep;
+			
+			/*!	Memory cap, in bytes, which simplify() tries to stay
+				within by compacting the mesh; if zero, no cap is set. */
+			size_t						memoryBudget;
+			
+			/*!	Number of nodes to collapse between two checks
+				of the memory occupied. */
+			UInt						memoryStep;
+			
+			/*!	Number of compactions performed by the last call 
+				to simplify() to stay within the memory cap. */
+			UInt						numCompactions;
+			
+			/*!	TRUE if nodes, elements and data points are re-ordered
+				along the Morton curve at every refresh, FALSE otherwise. */
+			bool						reordering;
+			
+			/*! TRUE if the state has been restored from a checkpoint and
+				simplify() has not been called yet, FALSE otherwise. */
+			bool						resumed;
+			
 		public:
 			//
 			// Constructors
@@ -194,35 +290,63 @@ namespace geometry
 			simplification(const MatrixXd & nds, const MatrixXi & els, 
 				const MatrixXd & loc, const VectorXd & val, 
 				const Real & wgeo = 1./3, const Real & wdis = 1./3, const Real & wequ = 1./3);			
+			
+			/*!	Constructor restoring the state saved by save(), i.e. the 
+				mesh with its inactive nodes and elements, the connections, the 
+				state of the CostClass object, the queue of collapsingEdge's, 
+				the fixed element and the settings. No cost is re-computed.
+				The next call to simplify() goes on from where the saved one
+				was interrupted, and gives the same mesh as an uninterrupted run
+				with the same targets.
+				
+				\param in	input stream, opened in binary mode
+				
+				\sa save(), setCheckpoint() */
+			simplification(istream & in);
 						
 			//
 			// Initialization and refreshing methods
 			//
 			
-			/*! Method that builds the set of CollapsingEdge ordered by cost and
-				the unordered set of cInfoList in the cost class.
+			/*! Method that builds the queue of collapsingEdge's ordered by cost.
 				The method uses the edge list from the connections and adds the 
-				cost information. */
+				cost information. The costs are computed in parallel by numThreads
+				threads, then bulk-loaded into the queue; the resulting queue
+				does not depend on the number of threads. Unless already done,
+				the queue is built by simplify(), so that the multiple-choice
+				scheduler does not pay for it. */
 			void setupCollapsingSet();
 			
-			/*!	Method re-building collapsingSet, i.e. re-computing all the costs. */
+			/*!	Method re-building collapsingSet, i.e. re-computing all the costs.
+				As in setupCollapsingSet(), the costs are computed in parallel. */
 			void rebuildCollapsingSet();
 			
+			/*!	Method re-keying collapsingSet after the normalization of the
+				cost components has changed. The costs are re-evaluated from
+				the raw components stored with each collapsingEdge, so that
+				no trial collapse is re-run; the collapsing points are kept.
+				Suitable only for cost classes providing the cost components,
+				e.g. DataGeo. */
+			void rescaleCollapsingSet();
+			
 			/*!	Method refreshing collapsingSet by applying an old-to-new map to
 				all nodes Id's. This method should be called any time the mesh gets
 				refreshed, i.e. the inactive nodes and elements are removed.
 				
 				\param old2new	old-to-new map for nodes Id's */
-			void refreshCollapsingSet(map<UInt,UInt> old2new);
+			void refreshCollapsingSet(const vector<UInt> & old2new);
 			
 			/*!	Method refreshing
 				<ol>
 				<li> the mesh
 				<li> the connectivities
+				<li> the state of the cost class
 				<li> the structured data
-				<li> the set of collapsingEdge's
-				<li> the set of collapseInfo's
-				<\ol> */
+				<li> the queue of collapsingEdge's
+				<\ol>
+				All but the structured data are updated in place by applying
+				the old-to-new maps given by the refresh of the mesh.
+				If enabled, the mesh is then re-ordered (see setReordering()). */
 			void refresh();
 						
 			//
@@ -240,6 +364,99 @@ namespace geometry
 			/*! Get const pointer to mesh operator.
 				\out 	const pointer to mesh operator */
 			const bmeshOperation<Triangle,MT> * getCPointerToMeshOperator() const;
+			
+			/*!	Get the mode of the queue of collapsingEdge's.
+				\return	the queue mode */
+			QueueMode getQueueMode() const;
+			
+			/*!	Get the mode of the structured data search.
+				\return	the search mode */
+			SearchMode getSearchMode() const;
+			
+			/*!	Check whether the cell size of the structured data is
+				tuned upon the elements.
+				\return	TRUE in auto-tuning mode, FALSE otherwise */
+			bool isAutoTuning() const;
+			
+			/*!	Get the number of threads employed to (re-)build the queue.
+				\return	number of threads */
+			UInt getNumThreads() const;
+			
+			/*!	Get the number of edges sampled at each iteration by the
+				multiple-choice scheduler.
+				\return	number of edges; zero if the scheduler is disabled */
+			UInt getNumChoices() const;
+			
+			/*!	Get the seed for the multiple-choice scheduler.
+				\return	the seed */
+			UInt getSeed() const;
+			
+			/*!	Get the path to the file where simplify() writes the checkpoints.
+				\return	the path */
+			string getCheckpointFile() const;
+			
+			/*!	Get the number of nodes to collapse between two checkpoints.
+				\return	number of nodes; zero if no checkpoint is written */
+			UInt getCheckpointStep() const;
+			
+			/*!	Get the number of edge costs re-computed after the collapses
+				performed by the last call to simplify().
+				\return	number of re-computations */
+			UInt getNumRecomputations() const;
+			
+			/*!	Get the number of edge cost re-computations saved by
+				getDirtyEdges() with respect to re-computing all the edges
+				within the 2-ring (1-ring for purely geometric grids) of the
+				collapsing node, for the last call to simplify(). Meaningful
+				only if the count has been enabled via setRingStatistics().
+				The number may be negative, since getDirtyEdges() re-computes
+				the edges close to the patch however far they are.
+				\return	number of saved re-computations */
+			long getNumSavedRecomputations() const;
+			
+			/*!	Know whether the edges re-computed by the ring-based rule
+				are counted.
+				\return	TRUE if the count is enabled,
+						FALSE otherwise */
+			bool getRingStatistics() const;
+			
+			/*!	Compare the queue with a full re-computation of the costs:
+				an edge should be in the queue if and only if it is valid
+				for collapse (see getCollapsingEdge()). All the edges of the
+				mesh are visited, so this is meant only for assessing
+				getDirtyEdges(). The mesh should have been refreshed, e.g.
+				by simplify(), and the queue must be in use, i.e. the
+				multiple-choice scheduler must be disabled.
+				\return	number of edges whose validity in the queue
+						is out of date */
+			UInt getNumStaleEdges() const;
+			
+			/*!	Get the memory cap for simplify().
+				\return	number of bytes; zero if no cap is set */
+			size_t getMemoryBudget() const;
+			
+			/*!	Get the number of nodes to collapse between two checks
+				of the memory occupied.
+				\return	number of nodes */
+			UInt getMemoryStep() const;
+			
+			/*!	Get the number of compactions performed by the last
+				call to simplify() to stay within the memory cap.
+				\return	number of compactions */
+			UInt getNumCompactions() const;
+			
+			/*!	Know whether the mesh is re-ordered at every refresh.
+				\return	TRUE if the re-ordering is enabled,
+						FALSE otherwise */
+			bool getReordering() const;
+			
+			/*!	Get the memory currently occupied by the simplification
+				process, broken down by component. The capacity of the
+				containers is accounted for, so inactive nodes and elements,
+				as well as the space released by a refresh but not given
+				back, count as well.
+				\return	the report */
+			memoryReport memoryUsage() const;
 									
 			//
 			// Set methods
@@ -248,6 +465,138 @@ namespace geometry
 			/*! Method which changes the pointer to the mesh.
 				\param grid pointer to the new mesh */
 			void setGrid(const mesh<Triangle,MT> & grid);
+			
+			/*!	Set the mode of the queue of collapsingEdge's.
+				In LAZY mode, the edges whose cost is re-computed are not
+				erased from the queue but just invalidated, and a new entry
+				is pushed. The collapse sequence is not affected.
+				
+				\param qm	queue mode
+				\param sb	maximum fraction of stale entries in LAZY mode;
+							once exceeded, the queue gets compacted
+				
+				\sa collapsingQueue.hpp */
+			void setQueueMode(const QueueMode & qm, const Real & sb = 0.5);
+			
+			/*!	Set the mode of the structured data search used by the
+				intersection control. In BVH mode, the bounding boxes of the
+				elements are stored in a bounding volume hierarchy, which suits
+				meshes whose elements have very different sizes. The collapse
+				sequence is not affected.
+				
+				\param sm	search mode
+				\param mg	in BVH mode, maximum growth of the surface of a
+							node of the tree before its subtree is re-built
+				
+				\sa structuredData.hpp, aabbTree.hpp */
+			void setSearchMode(const SearchMode & sm, const Real & mg = 2.);
+			
+			/*!	Enable or disable the auto-tuning of the cell size of the
+				structured data, in GRID mode. The cells are then sized upon the
+				distribution of the sizes of the elements, and the grid is
+				re-binned with coarser cells as the elements grow. The collapse
+				sequence is not affected.
+				
+				\param at		TRUE to enable the auto-tuning, FALSE otherwise
+				\param minOcc	minimum average number of elements per non-empty
+								cell before the grid is re-binned
+				\param maxOvf	maximum fraction of elements larger than the
+								cells before the grid is re-binned
+				
+				\sa structuredData.hpp */
+			void setAutoTuning(const bool & at, const Real & minOcc = 2., 
+				const Real & maxOvf = 0.001);
+			
+			/*!	Set the number of threads employed to (re-)build the queue.
+				By default, this is the number of concurrent threads supported
+				by the hardware. Note that the queue is first built upon
+				construction, so the new value applies to the next calls to
+				setupCollapsingSet() and rebuildCollapsingSet().
+				
+				\param nt	number of threads; if zero, the default is restored */
+			void setNumThreads(const UInt & nt);
+			
+			/*!	Enable the multiple-choice scheduler, which replaces collapsingSet.
+				At each iteration, simplify() samples k edges at random, computes
+				their cost on demand and collapses the cheapest one. Neither the 
+				costs of all edges are computed upfront nor those of the edges
+				around the collapsing point are re-computed after each collapse;
+				this makes the process much faster, at the price of a slightly
+				worse quality. The random engine is re-seeded at each call to
+				simplify(), so that runs are reproducible.
+				
+				Reference:
+				Wu J., Kobbelt L. "Fast mesh decimation by multiple-choice techniques".
+				Vision, Modeling and Visualization, 2002.
+				
+				\param k	number of edges sampled at each iteration;
+							if zero, the scheduler is disabled
+				\param s	seed for the random engine */
+			void setMultipleChoice(const UInt & k, const UInt & s = 0);
+			
+			/*!	Let simplify() write a checkpoint every given number of 
+				collapsed nodes, so that an interrupted run can be resumed 
+				through the constructor taking an input stream.
+				The checkpoint is first written to a temporary file, then 
+				renamed, so that the previous one survives an interruption
+				while writing.
+				
+				\param file	path to the checkpoint file
+				\param step	number of nodes; if zero, no checkpoint is written */
+			void setCheckpoint(const string & file, const UInt & step);
+			
+			/*!	Set a memory cap for simplify(). Every given number of
+				collapsed nodes, the memory occupied is checked through
+				memoryUsage(); if above the cap, the mesh is refreshed, i.e.
+				the inactive nodes and elements are removed, as well as the
+				connections, the state of the CostClass object and the queue,
+				and all containers give back the memory not used anymore.
+				Otherwise, inactive nodes and elements would be reclaimed only
+				at the end of simplify(). Being the old-to-new maps increasing,
+				the collapse sequence is not affected, apart from the 
+				multiple-choice scheduler which samples the nodes by Id, and
+				unless the re-ordering is enabled (see setReordering()). 
+				The cap is not enforced while the collapse log is enabled,
+				since the log refers to the Id's of the original mesh.
+				
+				Each compaction takes a time linear in the size of the mesh,
+				as it refreshes the mesh and re-builds the bounding boxes,
+				while the search grid is re-binned as without compaction (see
+				compact()). Since the memory is checked at most once every
+				step collapsed nodes, the number of compactions is bounded
+				by the number of nodes to collapse divided by step; then, a
+				cap below the memory the compacted mesh needs does not make
+				the process compact at every collapse.
+				
+				\param bytes	the cap; if zero, no cap is set
+				\param step		number of nodes to collapse between two checks */
+			void setMemoryBudget(const size_t & bytes, const UInt & step = 1000);
+			
+			/*!	Enable or disable the re-ordering of the mesh. When enabled,
+				nodes, elements and data points are re-numbered along the
+				Morton curve (see bmesh::reorder()) right away, i.e. just
+				after the mesh has been read if called after construction,
+				and then at every refresh, including the compactions done
+				to stay within the memory cap. Entities close in space thus
+				get close Id's, so that the walks through the adjacencies
+				along the simplification are cache-friendly. The Id's of
+				the output mesh change accordingly. As for the memory cap,
+				the re-ordering is skipped while the collapse log is enabled.
+				
+				\param flag	TRUE to enable the re-ordering,
+							FALSE to disable it */
+			void setReordering(const bool & flag);
+			
+			/*!	Enable or disable the count of the edges the ring-based rule
+				would re-compute after each collapse, i.e. the edges with an
+				end-point within the 2-ring (1-ring for purely geometric grids)
+				of the collapsing node. The count walks the rings once more
+				per collapse, so it is meant only for assessing getDirtyEdges()
+				and is disabled by default.
+				
+				\param flag	TRUE to enable the count,
+							FALSE to disable it */
+			void setRingStatistics(const bool & flag);
 
 		  	//
 		  	// Compute cost and apply collapse
@@ -258,8 +607,9 @@ namespace geometry
 				- extracts from the CostClass object the list of possible collapse points
 				- controls the validity of the points
 				- takes from the CostClass object the minimum cost value
-				- possibly insert the collapse information to the lists of collapseInfo
-				  and collapsingEdge objects
+				- possibly insert the collapse information to the queue
+				The first three steps are carried out by getCollapsingEdge(),
+				then the CostClass object is updated.
 								
 				\param id1	Id of the first end-point of the edge
 				\param id2	Id of the second end-point of the edge */
@@ -271,20 +621,35 @@ namespace geometry
 				- extracts from the CostClass object the list of possible collapse points
 				- controls the validity of the points
 				- takes from the CostClass object the minimum cost value
-				- possibly insert the collapse information to the lists of collapseInfo
-				  and collapsingEdge objects
+				- possibly insert the collapse information to the queue
 								
 				\param id1	Id of the first end-point of the edge
 				\param id2	Id of the second end-point of the edge */
 			void getCost_f(const UInt & id1, const UInt & id2);
+			
+			/*!	Method which computes the cost data for the contraction of the edge
+				as getCost_f() does, but without inserting them in the queue.
+				Neither the mesh nor the CostClass object are modified, so that
+				the method can be called concurrently by several threads.
+				
+				\param id1		Id of the first end-point of the edge
+				\param id2		Id of the second end-point of the edge
+				\param cEdge	collapse information, i.e. the cost and the
+								collapsing point; untouched if the edge cannot
+								be collapsed
+				\param minCmp	if not null, each cost component is lowered
+								to its minimum over the valid collapsing points
+				\return		TRUE if a valid collapsing point has been found,
+								FALSE otherwise */
+			bool getCollapsingEdge(const UInt & id1, const UInt & id2,
+				collapsingEdge & cEdge, array<Real,3> * minCmp = nullptr) const;
 						
 			/*! Method which updates:
 				<ol>
 				<li> the mesh
 				<li> the connectivities
 				<li> the structured data
-				<li> the set of collapsingEdge's
-				<li> the set of collapseInfo's
+				<li> the queue of collapsingEdge's
 				<\ol>
 				after each contraction.
 				In case of grids with distributed data, there is the further update 
@@ -300,8 +665,7 @@ namespace geometry
 				<li> the mesh
 				<li> the connectivities
 				<li> the structured data
-				<li> the set of collapsingEdge's
-				<li> the set of collapseInfo's
+				<li> the queue of collapsingEdge's
 				<\ol>
 				for a set of contractions.
 				In case of grids with distributed data, there is the further update 
@@ -340,6 +704,59 @@ namespace geometry
 				the global barycenter of the mesh. */
 			void findDontTouchId();
 			
+			//
+			// Methods for handling the collapse log
+			//
+			
+			/*!	Enable the collapse log. The next calls to simplify() keep
+				a copy of the mesh and record every collapse, so that the mesh 
+				at any intermediate number of nodes can then be extracted
+				through getLevelOfDetail(), without re-running the process. */
+			void enableCollapseLog();
+			
+			/*!	Disable the collapse log. */
+			void disableCollapseLog();
+			
+			/*!	Get the collapses recorded by the last call to simplify().
+				\return		vector of vertexSplit objects, in the order the
+							collapses have been performed */
+			const vector<vertexSplit> & getCollapseLog() const;
+			
+			/*!	Get the mesh at a given number of nodes, between the one 
+				before and the one after the last call to simplify(), by 
+				applying the recorded collapses to a copy of the original 
+				mesh. The resulting mesh is refreshed, i.e. inactive nodes
+				and elements are removed.
+				The collapse log must have been enabled before simplify().
+				
+				\param numNodes	number of nodes; values outside the range
+								are clamped to the nearest bound
+				\return			the mesh; empty if no collapse log is available */
+			mesh<Triangle,MT> getLevelOfDetail(const UInt & numNodes) const;
+			
+			/*!	Get the path to the output file for a target number of nodes, 
+				by inserting the number before the extension, e.g. output_8000.inp.
+				This is the path the snapshots taken by simplify() are printed to,
+				and it is meant for the meshes given by getLevelOfDetail() too.
+				
+				\param file		path to output file
+				\param numNodes	number of nodes
+				\return			the path */
+			static string getSnapshotFile(const string & file, const UInt & numNodes);
+			
+			//
+			// Checkpointing
+			//
+			
+			/*!	Write the state of the simplification process in binary format.
+				Neither the collapse log nor the number of threads are saved.
+				The checkpoint can be read only on the same architecture.
+				
+				\param out	output stream, opened in binary mode
+				
+				\sa simplification(istream &) */
+			void save(ostream & out) const;
+			
 			//
 			// Methods which make the simplification
 			//
@@ -354,12 +771,188 @@ namespace geometry
 				\param file				path to output file; if empty, nothing is printed */
 			void simplify(const UInt & numNodesMax, const bool & enableDontTouch,
 				const string & file = "");
+				
+			/*! Method which iteratively contracts the edge with minimum cost until 
+				reaching the smallest of several amounts of nodes, in a single pass.
+				Each time a target is reached, a copy of the mesh is refreshed,
+				i.e. inactive nodes and elements are removed, and possibly printed 
+				to file, while the process goes on over the live mesh.
+				The output file for each target is obtained by appending the
+				number of nodes to the given path, e.g. output_8000.inp; with
+				a single target, the given path is used as it is. No snapshot
+				is taken for the targets above the current number of nodes.
+				When resuming from a checkpoint, the targets already reached
+				before the checkpoint was written are skipped, as well as the
+				re-seeding of the random engine and the reset of the counters
+				of the cost re-computations; the collapse log, if enabled, 
+				starts from the checkpoint.
+				
+				\param numNodesMax		maximum numbers of nodes, in any order
+				\param enableDontTouch	TRUE if one element must be fixed,
+										FALSE otherwise
+				\param file				path to output file; if empty, nothing is printed */
+			void simplify(const vector<UInt> & numNodesMax, const bool & enableDontTouch,
+				const string & file = "");
 												
 		private:
 			/*!	Initialize the class, i.e. build collapsingSet and find the element
 				possibly to preserve throughout the simplification process. 
 				This method is just call in the constructor. */
 			void initialize();
+			
+			/*!	Restore the state written by save(). 
+				This method is just called in the constructor.
+				\param in	input stream */
+			void load(istream & in);
+			
+			/*!	Write a checkpoint to checkpointFile. */
+			void saveCheckpoint() const;
+			
+			/*!	Release the memory not used by the connectivity, the 
+				CostClass object, the structured data and the queue,
+				e.g. after a refresh. */
+			void shrinkToFit();
+			
+			/*!	Refresh the mesh along the simplification process, so to
+				stay within the memory cap. Unlike refresh(), the global grid
+				of the structured data is kept, so that the edges whose cost
+				is re-computed after the following collapses do not change. */
+			void compact();
+			
+			/*!	Re-order nodes, elements and data points along the Morton
+				curve, and apply the old-to-new maps to the connectivity,
+				the CostClass object, the queue and the fixed element.
+				The structured data are left to the caller. */
+			void reorder();
+			
+			/*!	Compute the cost data for a list of edges, splitting the
+				work among numThreads threads.
+				\param edges		the edges
+				\param progress	TRUE to print a progress bar (release mode only),
+									FALSE otherwise
+				\param minCmp		if not null, set to the minima of the cost
+									components over all the valid collapsing points
+				\return			collapse information for the edges which can
+									be collapsed, in the same order of the input list */
+			vector<collapsingEdge> getCollapsingEdges(const vector<pair<UInt,UInt>> & edges,
+				const bool & progress = false, array<Real,3> * minCmp = nullptr) const;
+			
+			/*!	Sample numChoices edges at random and get the cheapest one
+				which can be collapsed. Each edge is picked by sampling an active
+				node, then one of its neighbours.
+				
+				\param engine	random engine
+				\param cEdge	collapse information for the cheapest edge
+				\return		TRUE if at least one of the edges can be collapsed,
+								FALSE otherwise */
+			bool getRandomCollapsingEdge(mt19937 & engine, collapsingEdge & cEdge) const;
+			
+			/*!	Collapse an edge, updating the mesh, the connectivities, the
+				structured data and the CostClass object but not collapsingSet.
+				This method is used by the multiple-choice scheduler.
+				
+				\param id1		Id of the first end-point of the edge
+				\param id2		Id of the second end-point of the edge
+				\param cPoint	collapsing point */
+			void collapse(const UInt & id1, const UInt & id2, const point3d & cPoint);
+			
+			/*!	Print a refreshed copy of the current mesh, leaving the 
+				mesh itself untouched.
+				
+				\param file		path to output file; if empty, nothing is done
+				\param numNodes	target number of nodes, appended to the path */
+			void printSnapshot(const string & file, const UInt & numNodes) const;
+			
+			/*!	Possibly record a collapse in the collapse log.
+				This method should be called before updating the mesh.
+				
+				\param id1		Id of the first end-point of the edge
+				\param id2		Id of the second end-point of the edge
+				\param cPoint	collapsing point
+				\param toRemove	Id's of the elements on the edge
+				\param toKeep	Id's of the elements involved in the collapse
+								but not insisting on the edge */
+			void logCollapse(const UInt & id1, const UInt & id2, const point3d & cPoint,
+				const vector<UInt> & toRemove, const vector<UInt> & toKeep);
+				
+			/*!	Possibly record the new locations of the data points moved 
+				by the last recorded collapse. This method should be called
+				after the data points have been projected.
+				
+				\param toMove	Id's of the data points moved by the collapse */
+			void logMovedData(const vector<UInt> & toMove);
+			
+			/*!	Move the data points as done by a recorded collapse.
+				Purely geometric meshes have no data, then nothing is done.
+				
+				\param grid		the mesh
+				\param vs		the recorded collapse */
+			static void applyMovedData(mesh<Triangle,MeshType::GEO> & grid, const vertexSplit & vs);
+			
+			/*!	Move the data points as done by a recorded collapse.
+				
+				\param grid		the mesh
+				\param vs		the recorded collapse */
+			static void applyMovedData(mesh<Triangle,MeshType::DATA> & grid, const vertexSplit & vs);
+			
+			/*!	Re-order the data points. Purely geometric meshes have
+				no data, then nothing is done.
+				\param conn	the connectivity */
+			void reorderData(connect<Triangle,MeshType::GEO> * conn);
+			
+			/*!	Re-order the data points and apply the old-to-new map
+				to the state of the CostClass object.
+				\param conn	the connectivity */
+			void reorderData(connect<Triangle,MeshType::DATA> * conn);
+			
+			/*!	Get the elements whose bounding box intersects the bounding
+				box of a patch of elements, built upon the current position
+				of the nodes. The structured data are queried once for the
+				whole patch.
+				
+				\param elems	elements of the patch
+				\param res		buffer to fill with the Id's; previous content
+								is removed */
+			void getCloseElems(const vector<UInt> & elems, vector<UInt> & res) const;
+			
+			/*!	Get the edges whose cost must be re-computed after a collapse,
+				i.e. the edges whose cost inputs have actually changed. These
+				are the edges having an end-point
+				<ol>
+				<li> in the 1-ring of the collapsing node (included), since the 
+					 Q matrices of these nodes have been re-built and their
+					 incident triangles have been modified or have received
+					 the projected data;
+				<li> on an element whose quantity of information has changed,
+					 since some of its data have lost a connected element;
+				<li> on an element whose bounding box intersects the bounding
+					 box of the patch, before or after the collapse, since the
+					 test for self-intersections may give a different result
+				<\ol>
+				The end-points are taken however far from the collapsing node,
+				then the edges may exceed those picked by the ring-based rule 
+				(see getRingEdges()). The method has to be called after the 
+				collapse has been applied.
+				
+				\param id1			Id of the collapsing node
+				\param closeElems	elements close to the patch, as given by
+									getCloseElems() before and after the collapse
+				\param dataElems	elements whose quantity of information has
+									changed; empty for purely geometric grids
+				\param invEdges		set where the edges are inserted */
+			void getDirtyEdges(const UInt & id1, const vector<UInt> & closeElems, 
+				const vector<UInt> & dataElems, edgeTable & invEdges) const;
+			
+			/*!	Get all the edges with at least an end-point within a given
+				number of rings around a node. This is used to assess the
+				re-computations saved by getDirtyEdges(), if enabled via
+				setRingStatistics().
+				
+				\param id			Id of the node
+				\param numRings		number of rings
+				\param edges		set where the edges are inserted */
+			void getRingEdges(const UInt & id, const UInt & numRings,
+				edgeTable & edges) const;
 	};
 }
 
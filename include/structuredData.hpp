@@ -7,26 +7,153 @@
 #define HH_STRUCTUREDDATA_HH
 
 #include <memory>
-#include <unordered_set>
+#include <vector>
+#include <limits>
+#include <atomic>
 
 #include "boundingBox.hpp"
+#include "cartesianGrid.hpp"
+#include "aabbTree.hpp"
 #include "bmesh.hpp"
 #include "bmeshInfo.hpp"
 
 namespace geometry
 {
+	/*!	Search mode:
+		<ol>
+		<li> GRID: the bounding boxes are sorted by the cell of a uniform
+			 Cartesian grid their barycenter falls within;
+		<li> BVH: the bounding boxes are stored in a bounding volume
+			 hierarchy, i.e. an aabbTree.
+		<\ol> */
+	enum class SearchMode {GRID, BVH};
+
 	/*!	The bounding boxes for each element of a three-dimensional
-		mesh are stored in an unordered multi set. This should enable 
-		a quick index-based access to the boxes. */
+		mesh are stored in a flat array, sorted by the cell of the
+		Cartesian grid their barycenter falls within, as in a compressed
+		sparse row format: the boxes of a cell are contiguous and an array
+		of offsets gives where they start. When the grid has many more cells
+		than elements, the cells are hashed into as many buckets as elements,
+		so that the memory stays proportional to the mesh size; the boxes of
+		the cells sharing a bucket are then told apart through their index.
+		
+		The boxes updated after the last build are stored in place if
+		they stay in the same bucket, otherwise they are appended to a small
+		overflow list of the new bucket, leaving an erased entry behind.
+		When the overflow grows too long, all boxes are sorted again.
+		The queries scan contiguous memory and write into a buffer
+		provided by the caller.
+		
+		Since the cells have all the same size, a grid suits meshes whose
+		elements have similar sizes. Otherwise, the boxes can be stored in
+		a bounding volume hierarchy (BVH mode), which is refitted after any
+		update and partially re-built when its quality degrades; the grid
+		is then only used to label the boxes and to size the neighbourhood
+		of a point.
+		
+		By default, the cells are as large as the longest edge of the mesh
+		when the grid is built, and the grid is re-built when an edge gets
+		longer. In auto-tuning mode, the cell size is instead chosen upon the
+		distribution of the sizes of the boxes: the few boxes larger than
+		the cells are kept aside in an extra bucket, which is scanned by any
+		query, and the cells are then enlarged until they hold enough boxes
+		on average. As the elements grow, the grid is re-binned when the
+		average occupancy of the non-empty cells, or the fraction of boxes
+		larger than the cells, crosses a given threshold.
+		
+		\sa aabbTree.hpp, cartesianGrid.hpp */
 	template<typename SHAPE>
 	class structuredData
 	{
+		public:
+			/*!	Value marking a missing location, the end of an overflow
+				list or an erased bounding box. */
+			static constexpr UInt none = numeric_limits<UInt>::max();
+			
 		private:
 			/*!	Pointer to the mesh. */
 			bmesh<SHAPE> * grid;
 			
-			/*!	Set of bounding boxes surrounding the elements. */
-			unordered_multiset<bbox3d> 	boxes;
+			/*!	Cartesian grid the bounding boxes are sorted on. */
+			cartesianGrid cells;
+			
+			/*!	Bounding boxes sorted by bucket; erased boxes
+				have Id structuredData::none. */
+			vector<bbox3d> boxes;
+			
+			/*!	Offsets of the buckets in boxes: the boxes of the
+				b-th bucket lie in [bucketStart[b], bucketStart[b+1]). */
+			vector<UInt> bucketStart;
+			
+			/*!	Bounding boxes moved to another bucket after the last sorting. */
+			vector<bbox3d> overflow;
+			
+			/*!	Position in overflow of the last box appended to each bucket. */
+			vector<UInt> overflowHead;
+			
+			/*!	Position in overflow of the previous box appended to the same bucket. */
+			vector<UInt> overflowNext;
+			
+			/*!	Location of the box of each element: either the position in
+				boxes, or the size of boxes plus the position in overflow. */
+			vector<UInt> location;
+			
+			/*!	Whether the cells are hashed into the buckets. */
+			bool hashing;
+			
+			/*!	Number of bits to shift the hashed cell index by,
+				so to get the bucket. */
+			UInt shift;
+			
+			/*!	Number of buckets; the boxes larger than the cells, in
+				auto-tuning mode, are stored in a further bucket. */
+			UInt numBuckets;
+			
+			/*!	Whether the cell size is tuned upon the bounding boxes. */
+			bool autoTuning;
+			
+			/*!	Minimum average number of boxes per non-empty cell
+				before the grid is re-binned, in auto-tuning mode. */
+			Real minOccupancy;
+			
+			/*!	Maximum fraction of boxes larger than the cells
+				before the grid is re-binned, in auto-tuning mode. */
+			Real maxOverflow;
+			
+			/*!	Number of live boxes in each bucket, in auto-tuning mode. */
+			vector<UInt> bucketSize;
+			
+			/*!	Number of non-empty buckets, in auto-tuning mode. */
+			UInt numFilled;
+			
+			/*!	Number of times the grid has been re-binned. */
+			UInt numRebins;
+			
+			/*!	Counters of the queries and of the bounding boxes they have
+				examined. Since the queries may run concurrently, the counters
+				are atomic; they are copied by value along with the structure. */
+			struct queryCounter
+			{
+				atomic<size_t> numQueries;
+				atomic<size_t> numCandidates;
+				
+				queryCounter();
+				queryCounter(const queryCounter & qc);
+				queryCounter & operator=(const queryCounter & qc);
+				
+				/*!	Record a query.
+					\param n	number of bounding boxes examined */
+				void add(const size_t & n);
+			};
+			
+			/*!	Counters of the queries. */
+			mutable queryCounter counter;
+			
+			/*!	Search mode. */
+			SearchMode mode;
+			
+			/*!	Bounding volume hierarchy, used in BVH mode. */
+			aabbTree tree;
 			
 			/*!	Flag saying whether the structure should be updated.
 				This may happen when the elements have been strecthed too much. */
@@ -63,14 +190,62 @@ namespace geometry
 			// Get methods
 			//
 			
+			/*!	Get the Cartesian grid.
+				\return	the grid */
+			const cartesianGrid & getCartesianGrid() const;
+			
+			/*!	Get the search mode.
+				\return	the mode */
+			SearchMode getSearchMode() const;
+			
+			/*!	Get the bounding volume hierarchy, meaningful in BVH mode.
+				\return	the tree */
+			const aabbTree & getTree() const;
+			
+			/*!	Check whether the cell size is tuned upon the bounding boxes.
+				\return	TRUE in auto-tuning mode, FALSE otherwise */
+			bool isAutoTuning() const;
+			
+			/*!	Get the minimum occupancy of the cells in auto-tuning mode.
+				\return	average number of boxes per non-empty cell */
+			Real getMinOccupancy() const;
+			
+			/*!	Get the maximum overflow in auto-tuning mode.
+				\return	fraction of boxes larger than the cells */
+			Real getMaxOverflow() const;
+			
+			/*!	Get the average occupancy of the non-empty cells,
+				meaningful in auto-tuning mode.
+				\return	average number of boxes per non-empty cell */
+			Real getOccupancy() const;
+			
+			/*!	Get the number of boxes larger than the cells,
+				meaningful in auto-tuning mode.
+				\return	number of boxes */
+			UInt getNumOversized() const;
+			
+			/*!	Get the number of times the grid has been re-binned, i.e.
+				refreshed while toRefresh() held, since the last reset.
+				\return	number of re-bins */
+			UInt getNumRebins() const;
+			
+			/*!	Get the number of queries since the last reset.
+				\return	number of queries */
+			size_t getNumQueries() const;
+			
+			/*!	Get the number of bounding boxes examined by the
+				queries since the last reset.
+				\return	number of boxes */
+			size_t getNumCandidates() const;
+			
 			/*!	Get bounding box surrouning an element.
 				\param		element Id
 				\return		the bounding box */
 			bbox3d getBoundingBox(const UInt & Id) const;
 			
 			/*!	Get bounding boxes surrounding each element.
-				\return		set of bounding boxes */
-			unordered_multiset<bbox3d> getBoundingBox() const;
+				\return		vector of bounding boxes */
+			vector<bbox3d> getBoundingBox() const;
 			
 			/*!	Get Id's of elements whose bounding box may 
 				intersect the bounding box of a given element.
@@ -81,6 +256,46 @@ namespace geometry
 				\return		vector of Id's */ 
 			vector<UInt> getNeighbouringElements(const UInt & Id) const;
 			
+			/*!	Get Id's of elements whose bounding box may 
+				intersect the bounding box of a given element.
+				
+				\param Id	element Id
+				\param res	buffer to fill with the Id's; previous content
+							is removed */ 
+			void getNeighbouringElements(const UInt & Id, vector<UInt> & res) const;
+			
+			/*!	Get Id's of elements whose bounding box may
+				intersect a given bounding box, pretending that some
+				elements have been removed and some bounding boxes 
+				have been replaced. The structure is not modified.
+				This method will be useful when checking for mesh 
+				self-intersections after a trial edge collapse.
+				
+				\param box		the bounding box
+				\param toSkip	Id's of elements whose stored bounding
+								box should be disregarded
+				\param toAdd	bounding boxes to consider in place of 
+								the stored ones; their Id's should be
+								included in toSkip
+				\return			vector of Id's */ 
+			vector<UInt> getNeighbouringElements(const bbox3d & box, 
+				const vector<UInt> & toSkip, const vector<bbox3d> & toAdd) const;
+			
+			/*!	Get Id's of elements whose bounding box may
+				intersect a given bounding box, pretending that some
+				elements have been removed and some bounding boxes 
+				have been replaced.
+				
+				\param box		the bounding box
+				\param toSkip	Id's of elements whose stored bounding
+								box should be disregarded
+				\param toAdd	bounding boxes to consider in place of 
+								the stored ones
+				\param res		buffer to fill with the Id's; previous
+								content is removed */ 
+			void getNeighbouringElements(const bbox3d & box, const vector<UInt> & toSkip, 
+				const vector<bbox3d> & toAdd, vector<UInt> & res) const;
+			
 			/*!	Given a point, returns the elements which it may
 				belongs to. This method will be useful to construct
 				data-element connections in case of data locations
@@ -90,6 +305,18 @@ namespace geometry
 				\return		vector of Id's */ 
 			vector<UInt> getNeighbouringElements(const point3d & P) const;
 			
+			/*!	Given a point, returns the elements which it may
+				belongs to.
+				
+				\param P	three-dimensional point
+				\param res	buffer to fill with the Id's; previous content
+							is removed */ 
+			void getNeighbouringElements(const point3d & P, vector<UInt> & res) const;
+			
+			/*!	Get the memory occupied by the bounding boxes.
+				\return		number of bytes */
+			size_t getMemory() const;
+			
 			//
 			// Set methods
 			//
@@ -106,6 +333,31 @@ namespace geometry
 			template<MeshType MT>
 			void setMesh(bmeshInfo<SHAPE,MT> & news);
 			
+			/*!	Set the Cartesian grid and re-build the set of bounding boxes.
+				This is useful when the grid has been restored rather than
+				computed from the mesh.
+				\param cg	the new grid */
+			void setCartesianGrid(const cartesianGrid & cg);
+			
+			/*!	Set the search mode and re-build the structure accordingly.
+				\param sm	the new mode
+				\param mg	in BVH mode, maximum growth of the surface of
+							a node of the tree before its subtree is re-built */
+			void setSearchMode(const SearchMode & sm, const Real & mg = 2.);
+			
+			/*!	Enable or disable the auto-tuning of the cell size, meaningful
+				in GRID mode. When the mode changes, the grid is re-built.
+				\param at		TRUE to enable the auto-tuning, FALSE otherwise
+				\param minOcc	minimum average number of boxes per non-empty
+								cell before the grid is re-binned
+				\param maxOvf	maximum fraction of boxes larger than the cells
+								before the grid is re-binned */
+			void setAutoTuning(const bool & at, const Real & minOcc = 2., 
+				const Real & maxOvf = 0.001);
+			
+			/*!	Reset the number of re-bins and the counters of the queries. */
+			void resetStatistics();
+			
 			//
 			// Modify set of bounding boxes
 			//
@@ -143,7 +395,11 @@ namespace geometry
 			// Refresh methods
 			//
 			
-			/*!	Check if the structure requires a refresh.
+			/*!	Check if the structure requires a refresh. In GRID mode, this
+				happens when an element has been stretched more than the size
+				of a cell or, in auto-tuning mode, when the occupancy or the
+				overflow of the cells crosses its threshold; in BVH mode, when
+				most boxes have been erased.
 				\return		TRUE if the structure should be refreshed,
 							FALSE otherwise */
 			bool toRefresh() const; 
@@ -154,6 +410,79 @@ namespace geometry
 				\sa bmeshInfo.hpp */
 			template<MeshType MT>
 			void refresh(const bmeshInfo<SHAPE,MT> & news);
+			
+			/*!	Re-build set of bounding boxes, keeping the current
+				Cartesian grid. */
+			void rebuild();
+			
+			/*!	Merge the overflow into the sorted boxes, drop the
+				erased boxes and release the memory not needed anymore,
+				e.g. after a refresh. */
+			void shrinkToFit();
+			
+		private:
+			//
+			// Auxiliary methods
+			//
+			
+			/*!	Get the bucket of a cell.
+				\param idx	scalar index of the cell
+				\return		the bucket */
+			UInt getBucket(const UInt & idx) const;
+			
+			/*!	Get the bucket of a bounding box.
+				\param bb	the bounding box
+				\return		the bucket of its cell, or numBuckets if
+							the box is larger than the cells */
+			UInt getBucket(const bbox3d & bb) const;
+			
+			/*!	Check whether a bounding box is larger than the cells of a
+				grid, i.e. it may overlap a box whose barycenter lies two
+				cells away. This only happens in auto-tuning mode.
+				\param bb	the bounding box
+				\param cg	the grid
+				\return		TRUE if the box is larger than the cells,
+							FALSE otherwise */
+			bool isOversized(const bbox3d & bb, const cartesianGrid & cg) const;
+			
+			/*!	Choose the Cartesian grid upon the current bounding boxes:
+				the cells are the smallest ones such that few boxes are larger
+				than them, enlarged until they hold enough boxes on average.
+				\param pne	North-East point of the mesh
+				\param psw	South-West point of the mesh
+				\return		the grid */
+			cartesianGrid getTunedGrid(const point3d & pne, const point3d & psw) const;
+			
+			/*!	Get the range of cells to scan for a box, i.e. the cells
+				intersecting the box plus an extra layer.
+				\param SW	South-West point of the box
+				\param NE	North-East point of the box
+				\return		first and last cell along each direction */
+			array<UInt,6> getCellsRange(const point3d & SW, const point3d & NE) const;
+			
+			/*!	Visit the live bounding boxes stored for a cell.
+				\param idx	scalar index of the cell
+				\param f	function taking a bounding box */
+			template<typename F>
+			void forEachBox(const UInt & idx, F f) const;
+			
+			/*!	Visit the live bounding boxes larger than the cells.
+				\param f	function taking a bounding box */
+			template<typename F>
+			void forEachOversized(F f) const;
+			
+			/*!	Store the bounding box of an element, replacing the old one:
+				in place if the bucket does not change, otherwise in the
+				overflow of the new bucket. Boxes are sorted again when
+				the overflow gets too long. In BVH mode, the box is replaced
+				in the tree, which is refitted afterwards.
+				\param bb	the bounding box, with the Id of the element */
+			void place(const bbox3d & bb);
+			
+			/*!	Sort some bounding boxes by bucket and make them
+				the content of the structure.
+				\param all	the bounding boxes */
+			void sortBoxes(const vector<bbox3d> & all);
 	};
 }
 
@@ -0,0 +1,215 @@
+/*!	\file	trialCollapse.hpp
+	\brief	Class evaluating an edge collapse on a local copy of the
+			involved patch, without modifying the mesh. */
+
+#ifndef HH_TRIALCOLLAPSE_HH
+#define HH_TRIALCOLLAPSE_HH
+
+#include <array>
+#include <utility>
+
+#include "bmeshOperation.hpp"
+#include "structuredData.hpp"
+#include "intersection.hpp"
+
+namespace geometry
+{
+	/*!	This class evaluates the outcome of an edge collapse, i.e.
+		its validity, the location of the data points and the
+		possible mesh self-intersections it would lead to.
+		Upon construction, the class extracts the elements involved
+		in the collapse and builds a local copy of them as they would
+		be after the collapse. Then, the collapsing point can be moved
+		and the collapse checked several times.
+
+		The mesh, its connections and the structured data are only
+		read and never modified. Therefore, several objects of this
+		class may work at once on the same mesh, as far as the mesh
+		itself is not modified in the meanwhile.
+
+		Denoting by (id1,id2) the edge, the collapse is assumed to
+		keep id1 and remove id2, consistently with the class simplification.
+		The template parameters are the shape of the elements and
+		the mesh type.
+
+		\sa simplification.hpp */
+	template<typename SHAPE, MeshType MT>
+	class trialCollapse
+	{
+	};
+
+	/*!	Specialization for triangular grids. */
+	template<MeshType MT>
+	class trialCollapse<Triangle, MT>
+	{
+		private:
+			/*!	Pointer to the operator on the mesh. */
+			const bmeshOperation<Triangle,MT> * oprtr;
+
+			/*!	Id of the end-point of the edge to keep. */
+			UInt id1;
+
+			/*!	Id of the end-point of the edge to remove. */
+			UInt id2;
+
+			/*!	Current collapsing point. */
+			point3d cPoint;
+
+			/*!	Flag saying whether the collapse can be performed
+				from a topological viewpoint. */
+			bool feasible;
+
+			/*!	Id's of the elements insisting on the edge. */
+			vector<UInt> toRemove;
+
+			/*!	Id's of the elements involved in the collapse but not
+				insisting on the edge. */
+			vector<UInt> toKeep;
+
+			/*!	Vertices of the elements in toKeep after the collapse,
+				i.e. with id2 replaced by id1. */
+			vector<array<UInt,3>> vertices;
+
+			/*!	Normals to the elements in toKeep before the collapse. */
+			vector<point3d> oldNormals;
+
+			/*!	Flag saying whether the data points involved in the
+				collapse have already been extracted. */
+			bool dataReady;
+
+			/*!	Id's of the data points to project. */
+			vector<UInt> toMove;
+
+			/*!	For each element in toKeep, data points which are not
+				projected, along with the number of elements each of them
+				would be associated with after the collapse;
+				pairs are sorted by data point Id. */
+			vector<vector<pair<UInt,UInt>>> fixedData;
+
+			/*!	Location of the data points in toMove after the last
+				projection. */
+			vector<point3d> movedData;
+
+			/*!	Quantity of information for the elements in toKeep
+				after the last projection. */
+			vector<Real> qoi;
+
+			/*!	Elements each projected data point would be associated
+				with after the last projection; the elements of the j-th
+				data point in toMove are stored in positions from
+				data2ElemBegin[j] to data2ElemBegin[j+1] (excluded). */
+			vector<UInt> data2Elem;
+
+			/*!	Beginning of the connections of each data point in data2Elem. */
+			vector<UInt> data2ElemBegin;
+
+			/*!	Buffers for node-element connections, re-used
+				by subsequent projections to avoid allocations. */
+			vector<UInt> elemsBuffer1, elemsBuffer2;
+
+		public:
+			//
+			// Constructors
+			//
+
+			/*!	Constructor.
+				\param bmo	the operator on the mesh
+				\param a	Id of the end-point of the edge to keep
+				\param b	Id of the end-point of the edge to remove */
+			trialCollapse(const bmeshOperation<Triangle,MT> & bmo,
+				const UInt & a, const UInt & b);
+
+			//
+			// Get methods
+			//
+
+			/*!	Check whether the collapse can be performed from a
+				topological viewpoint, i.e. exactly two elements insist
+				on the edge and no edge would be shared by more than
+				two elements after the collapse.
+
+				\return		TRUE if the collapse is feasible,
+							FALSE otherwise */
+			bool isFeasible() const;
+
+			/*!	Get the elements insisting on the edge.
+				\return		vector of Id's */
+			const vector<UInt> & getElemsToRemove() const;
+
+			/*!	Get the elements involved in the collapse but not
+				insisting on the edge.
+				\return		vector of Id's */
+			const vector<UInt> & getElemsToKeep() const;
+
+			/*!	Get the current collapsing point.
+				\return		the point */
+			point3d getCollapsingPoint() const;
+
+			/*!	Get the data points projected by project().
+				\return		vector of Id's */
+			const vector<UInt> & getDataToMove() const;
+
+			/*!	Get the location of the data points after the last
+				call to project().
+				\return		vector of locations, in the same order
+							given by getDataToMove() */
+			const vector<point3d> & getProjectedData() const;
+
+			/*!	Get the quantity of information for the elements
+				after the last call to project().
+				\return		vector of quantities of information, in the
+							same order given by getElemsToKeep() */
+			const vector<Real> & getQuantityOfInformation() const;
+
+			//
+			// Trial methods
+			//
+
+			/*!	Set the collapsing point.
+				\param p	the new collapsing point */
+			void setCollapsingPoint(const point3d & p);
+
+			/*!	Check that the collapse in the current collapsing point
+				leads to neither degenerate nor inverted triangles.
+				\return		TRUE if the collapse is valid, FALSE otherwise */
+			bool isValid() const;
+
+			/*!	Project the data points onto the elements resulting
+				from the collapse in the current collapsing point, then
+				compute the new quantity of information.
+				This method is provided only for grids with distributed data.
+
+				\return		TRUE if no element would be left without data points,
+							FALSE otherwise */
+			bool project();
+
+			/*!	Check whether the collapse in the current collapsing point
+				would lead to mesh self-intersections.
+				\param sd	structured data built on the mesh
+				\return		TRUE if self-intersections arise, FALSE otherwise */
+			bool intersect(const structuredData<Triangle> & sd) const;
+
+		private:
+			//
+			// Auxiliary methods
+			//
+
+			/*!	Get the location of a node after the collapse.
+				\param Id	node Id
+				\return		the location */
+			point3d getNode(const UInt & Id) const;
+
+			/*!	Get the node-element connections for a node after the collapse.
+				\param Id		node Id; it should not be id2
+				\param elems	ascending-ordered elements Id's */
+			void getNode2Elem(const UInt & Id, vector<UInt> & elems) const;
+
+			/*!	Extract the data points involved in the collapse. */
+			void setupData();
+	};
+}
+
+/*!	Include implementations of class members. */
+#include "implementation/imp_trialCollapse.hpp"
+
+#endif
@@ -0,0 +1,72 @@
+/*!	\file	triangleBatch.hpp
+	\brief	Class storing the coordinates of a batch of triangles. */
+
+#ifndef HH_TRIANGLEBATCH_HH
+#define HH_TRIANGLEBATCH_HH
+
+#include <vector>
+#include <array>
+
+#include "geoPoint.hpp"
+
+namespace geometry
+{
+	/*!	This class stores the vertices of a set of triangles as a
+		structure of arrays: the i-th coordinate of the v-th vertex of
+		all the triangles are contiguous. The coordinates of consecutive
+		triangles can then be loaded at once into SIMD registers.
+
+		\sa intersection.hpp */
+	class triangleBatch
+	{
+		private:
+			/*!	Coordinates; the i-th coordinate of the v-th
+				vertex are stored in coor[3*v + i]. */
+			array<vector<Real>,9> coor;
+
+		public:
+			//
+			// Get methods
+			//
+
+			/*!	Get the number of triangles.
+				\return		number of triangles */
+			UInt size() const;
+
+			/*!	Get a coordinate of a vertex of all the triangles.
+				\param v	local index of the vertex
+				\param i	index of the coordinate
+				\return		pointer to the coordinates */
+			const Real * data(const UInt & v, const UInt & i) const;
+
+			/*!	Get a vertex of a triangle.
+				\param k	index of the triangle
+				\param v	local index of the vertex
+				\return		the vertex */
+			point3d getVertex(const UInt & k, const UInt & v) const;
+
+			//
+			// Modify the batch
+			//
+
+			/*!	Append a triangle.
+				\param D	first vertex
+				\param E	second vertex
+				\param F	third vertex */
+			void push_back(const point3d & D, const point3d & E, const point3d & F);
+
+			/*!	Remove all the triangles, keeping the memory. */
+			void clear();
+
+			/*!	Reserve memory.
+				\param n	number of triangles */
+			void reserve(const UInt & n);
+	};
+}
+
+/*!	Include definitions of inlined members. */
+#ifdef INLINED
+#include "inline/inline_triangleBatch.hpp"
+#endif
+
+#endif
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include "inc.hpp"
 
@@ -48,7 +49,54 @@ namespace geometry
 				\param out		output stream */
 			static void printIntersectionType(const IntersectionType & it, const string & elements,
 				ostream & out = cout);
+			
+			/*!	Apply an old-to-new map to a vector indexed by node or
+				element Id's, e.g. after a refresh of the mesh. If the map
+				is increasing, the entries are moved back in place;
+				otherwise (e.g. after a re-ordering of the mesh) they are
+				scattered into a new vector.
+				\param v		the vector; its size should not exceed the one
+								of the map
+				\param old2new	old-to-new map; the entries mapped to REMOVED_ID
+								are erased */
+			template<typename T>
+			static void compact(vector<T> & v, const vector<UInt> & old2new);
+			
+			//
+			// Binary input/output
+			//
+			// These methods are used to write and read checkpoints.
+			// The values are stored in their in-memory representation,
+			// so a checkpoint can be read only on the same architecture.
+			
+			/*!	Write a value in binary format.
+				\param out	output stream
+				\param val	the value; its type must be trivially copyable */
+			template<typename T>
+			static void write(ostream & out, const T & val);
+			
+			/*!	Write a vector in binary format, size first.
+				\param out	output stream
+				\param v	the vector; the type of its elements must be 
+							trivially copyable */
+			template<typename T>
+			static void write(ostream & out, const vector<T> & v);
+			
+			/*!	Read a value written by write().
+				\param in	input stream
+				\param val	the value */
+			template<typename T>
+			static void read(istream & in, T & val);
+			
+			/*!	Read a vector written by write().
+				\param in	input stream
+				\param v	the vector */
+			template<typename T>
+			static void read(istream & in, vector<T> & v);
 	};
 }
 
+/*!	Include implementations of template members. */
+#include "implementation/imp_utility.hpp"
+
 #endif
@@ -0,0 +1,125 @@
+/*!	\file	vertexSplit.hpp
+	\brief	Class storing an edge collapse as an entry of a progressive mesh log. */
+	
+#ifndef HH_VERTEXSPLIT_HH
+#define HH_VERTEXSPLIT_HH
+
+#include "point.hpp"
+
+namespace geometry
+{
+	/*!	This is a merely storing class bringing all information for
+		re-playing an edge collapse on a copy of the original mesh,
+		without any connectivity. Conversely to collapsingEdge, the
+		cost is not stored, while the elements and the data points
+		affected by the collapse are.
+		A sequence of vertexSplit objects is a progressive mesh:
+		applying the first k of them to the original mesh gives the
+		mesh after k collapses, while undoing them in reverse order
+		(i.e. splitting the vertices) would give back the original mesh.
+		
+		\sa collapsingEdge.hpp, simplification.hpp */
+	class vertexSplit
+	{
+		private:
+			/*!	Id's of edge end-points; the second one gets removed. */
+			UInt Id1;
+			UInt Id2;
+		
+			/*!	Collapsing point. */
+			point3d cPoint;
+			
+			/*!	Id's of the elements insisting on the edge, then removed. */
+			vector<UInt> toRemove;
+			
+			/*!	Id's of the elements whose vertex Id2 is replaced by Id1. */
+			vector<UInt> toRedirect;
+			
+			/*!	Id's of the data points moved by the collapse, 
+				together with their new locations. */
+			vector<pair<UInt,point3d>> movedData;
+			
+		public:
+			//
+			// Constructor
+			//
+			
+			/*!	Synthetic default constructor. */
+			vertexSplit() = default;
+			
+			/*!	Constructor.
+				\param id1		Id of first end-point
+				\param id2		Id of second end-point, i.e. the node to remove
+				\param cp		collapsing point
+				\param rmv		Id's of the elements to remove
+				\param rdr		Id's of the elements whose vertex id2 is replaced by id1 */
+			vertexSplit(const UInt & id1, const UInt & id2, const point3d & cp,
+				const vector<UInt> & rmv, const vector<UInt> & rdr);
+				
+			/*!	Synthetic copy constructor. 
+				\param vs	another vertexSplit object */
+			vertexSplit(const vertexSplit & vs) = default;
+			
+			/*!	Synthetic move constructor. 
+				\param vs	another vertexSplit object */
+			vertexSplit(vertexSplit && vs) = default;
+			
+			//
+			// Operators
+			//
+			
+			/*!	Synthetic copy-assignment operator.
+				\param vs	another vertexSplit object
+				\return		the updated current object */
+			vertexSplit & operator=(const vertexSplit & vs) = default;
+			
+			/*!	Synthetic move-assignment operator.
+				\param vs	another vertexSplit object
+				\return		the updated current object */
+			vertexSplit & operator=(vertexSplit && vs) = default;
+						
+			//
+			// Get methods
+			//
+			
+			/*!	Get Id of first end-point.
+				\return		Id of first end-point */
+			UInt getId1() const;
+			
+			/*!	Get Id of second end-point, i.e. the node to remove.
+				\return		Id of second end-point */
+			UInt getId2() const;
+			
+			/*!	Get collapsing point.
+				\return		the collapsing point */
+			point3d getCollapsingPoint() const;
+			
+			/*!	Get the elements to remove.
+				\return		vector of elements Id's */
+			const vector<UInt> & getElemsToRemove() const;
+			
+			/*!	Get the elements whose vertex Id2 is replaced by Id1.
+				\return		vector of elements Id's */
+			const vector<UInt> & getElemsToRedirect() const;
+			
+			/*!	Get the data points moved by the collapse.
+				\return		vector of (Id, new location) pairs */
+			const vector<pair<UInt,point3d>> & getMovedData() const;
+			
+			//
+			// Set methods
+			//
+			
+			/*!	Add a data point moved by the collapse.
+				\param id	data point Id
+				\param p	new location */
+			void addMovedData(const UInt & id, const point3d & p);
+	};
+}
+
+/*!	Include implementations of inlined class members. */
+#ifdef INLINED
+#include "inline/inline_vertexSplit.hpp"
+#endif
+
+#endif
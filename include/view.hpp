@@ -0,0 +1,66 @@
+/*!	\file	view.hpp
+	\brief	A non-owning view on a range of elements. */
+
+#ifndef HH_VIEW_HH
+#define HH_VIEW_HH
+
+#include "inc.hpp"
+
+namespace geometry
+{
+	/*!	This class represents a range of elements stored elsewhere,
+		given by a pair of iterators. It does not own the elements: it is
+		cheap to copy and it allows to iterate over a container through 
+		a range-based for loop without copying the container itself.
+		The view is invalidated whenever the underlying container is 
+		modified.
+
+		\param Iterator	type of the iterators */
+	template<typename Iterator>
+	class view
+	{
+		private:
+			/*!	Iterator to the first element. */
+			Iterator first;
+
+			/*!	Iterator past the last element. */
+			Iterator last;
+
+			/*!	Number of elements. */
+			UInt sz;
+
+		public:
+			//
+			// Constructor
+			//
+
+			/*!	Constructor.
+				\param f	iterator to the first element
+				\param l	iterator past the last element
+				\param n	number of elements */
+			view(Iterator f, Iterator l, const UInt & n);
+
+			//
+			// Access methods
+			//
+
+			/*!	\return	iterator to the first element */
+			Iterator begin() const;
+
+			/*!	\return	iterator past the last element */
+			Iterator end() const;
+
+			/*!	Get number of elements.
+				\return		number of elements */
+			UInt size() const;
+
+			/*!	Check whether the view is empty.
+				\return		TRUE if the view is empty, FALSE otherwise */
+			bool empty() const;
+	};
+}
+
+/*!	Include definitions of template members. */
+#include "implementation/imp_view.hpp"
+
+#endif
@@ -3,7 +3,7 @@
 	
 #include <chrono>
 	
-#include "simplification.hpp"
+#include "driverOptions.hpp"
 
 int main(int argc, char * argv[])
 {
@@ -21,56 +21,34 @@ int main(int argc, char * argv[])
 		<< "process applied to a mesh with distributed data." << endl
 		<< "To run it, from the current directory type: " << endl
 		<< "    " << argv[0] << " [options] [arguments]" << endl
-		<< "List of available options:" << endl
-		<< "-h, --help                 " << "print help" << endl
-		<< "-i, --input [file]         " << "specify path to input file (mandatory)" << endl
-		<< "-n, --nodes [n]            " << "set target number of nodes (mandatory)" << endl
-		<< "-o, --output [file]        " << "specify path to output file (default: none)" << endl
-		<< "-wg, --weight-geom [wg]    " << "set weight for geometric cost function (default: 1/3)" << endl
+		<< "List of available options:" << endl;
+		driverOptions::printHelp();
+		cout << "-wg, --weight-geom [wg]    " << "set weight for geometric cost function (default: 1/3)" << endl
 		<< "-wd, --weight-disp [wd]    " << "set weight for displacement cost function (default: 1/3)" << endl
-		<< "-we, --weight-equi [we]    " << "set weight for equidistribution cost function (default: 1/3)" << endl
-		<< "--disable-fixed-element    " << "disable fixed element" << endl;
+		<< "-we, --weight-equi [we]    " << "set weight for equidistribution cost function (default: 1/3)" << endl;
 		return 0;
 	}
 	
 	// Initialize settings
-	string iFile, oFile;
-	UInt n(0);
+	driverOptions opts;
 	Real wg(1./3), wd(1./3), we(1./3);
-	bool fixedElem(true);
 	
 	// Read arguments from command line
 	for (UInt i = 1; i < argc; i+=2)
 	{
-		if (!strcmp(argv[i],"-i") || !strcmp(argv[i],"--input"))
-			iFile = argv[i+1];
-		else if (!strcmp(argv[i],"-n") || !strcmp(argv[i],"--nodes"))
-			n = atoi(argv[i+1]);
-		else if (!strcmp(argv[i],"-o") || !strcmp(argv[i],"--output"))
-			oFile = argv[i+1];
-		else if (!strcmp(argv[i],"-wg") || !strcmp(argv[i],"--weight-geom"))
+		if (opts.read(argv[i], argv[i+1]))
+			continue;
+		if (!strcmp(argv[i],"-wg") || !strcmp(argv[i],"--weight-geom"))
 			wg = atof(argv[i+1]);
 		else if (!strcmp(argv[i],"-wd") || !strcmp(argv[i],"--weight-dist"))
 			wd = atof(argv[i+1]);
 		else if (!strcmp(argv[i],"-we") || !strcmp(argv[i],"--weight-equi"))
 			we = atof(argv[i+1]);
-		else if (!strcmp(argv[i],"--disable-fixed-element"))
-			fixedElem = false;
 	}
 	
-	// Check on input file
-	if (!iFile.compare(""))
-	{
-		cout << "Input file not provided. Aborted." << endl;
-		return 0;
-	}
-	
-	// Check on final number of nodes
-	if (n == 0)
-	{
-		cout << "Target number of nodes not provided or zero. Aborted." << endl;
+	// Check on input file and final number of nodes
+	if (!opts.check())
 		return 0;
-	}	
 	
 	// Check that weights are positive
 	if ((wg < 0) || (wd < 0) || (we < 0))
@@ -95,8 +73,11 @@ int main(int argc, char * argv[])
 	high_resolution_clock::time_point start = high_resolution_clock::now();
 	#endif
 	
-	simplification<Triangle, MeshType::DATA, DataGeo> simplifier(iFile);
-	simplifier.simplify(n, fixedElem, oFile);
+	// Either start from the input file or resume from a checkpoint
+	auto simplifier = opts.getSimplifier<MeshType::DATA, DataGeo>();
+	if (!simplifier)
+		return 0;
+	opts.run(*simplifier);
 		
 	#ifdef NDEBUG
 	high_resolution_clock::time_point stop = high_resolution_clock::now();
@@ -6,7 +6,7 @@
 	
 #include <chrono>
 	
-#include "simplification.hpp"
+#include "driverOptions.hpp"
 
 int main(int argc, char * argv[])
 {
@@ -25,46 +25,21 @@ int main(int argc, char * argv[])
 		<< "The edge cost function does not take statistical considerations into account." << endl
 		<< "To run it, from the current directory type: " << endl
 		<< "    " << argv[0] << " [options] [arguments]" << endl
-		<< "List of available options:" << endl
-		<< "-h, --help                 " << "print help" << endl
-		<< "-i, --input [file]         " << "specify path to input file (mandatory)" << endl
-		<< "-n, --nodes [n]            " << "set target number of nodes (mandatory)" << endl
-		<< "-o, --output [file]        " << "specify path to output file (default: none)" << endl
-		<< "--disable-fixed-element    " << "disable fixed element" << endl;
+		<< "List of available options:" << endl;
+		driverOptions::printHelp();
 		return 0;
 	}
 	
 	// Initialize settings
-	string iFile, oFile;
-	UInt n(0);
-	bool fixedElem(true);
+	driverOptions opts;
 	
 	// Read arguments from command line
 	for (UInt i = 1; i < argc; i+=2)
-	{
-		if (!strcmp(argv[i],"-i") || !strcmp(argv[i],"--input"))
-			iFile = argv[i+1];
-		else if (!strcmp(argv[i],"-n") || !strcmp(argv[i],"--nodes"))
-			n = atoi(argv[i+1]);
-		else if (!strcmp(argv[i],"-o") || !strcmp(argv[i],"--output"))
-			oFile = argv[i+1];
-		else if (!strcmp(argv[i],"--disable-fixed-element"))
-			fixedElem = false;
-	}
-	
-	// Check on input file
-	if (!iFile.compare(""))
-	{
-		cout << "Input file not provided. Aborted." << endl;
-		return 0;
-	}
+		opts.read(argv[i], argv[i+1]);
 	
-	// Check on final number of nodes
-	if (n == 0)
-	{
-		cout << "Target number of nodes not provided or zero. Aborted." << endl;
+	// Check on input file and final number of nodes
+	if (!opts.check())
 		return 0;
-	}	
 	
 	//
 	// Run
@@ -74,8 +49,11 @@ int main(int argc, char * argv[])
 	high_resolution_clock::time_point start = high_resolution_clock::now();
 	#endif
 	
-	simplification<Triangle, MeshType::DATA, OnlyGeo<MeshType::DATA>> simplifier(iFile);
-	simplifier.simplify(n, fixedElem, oFile);
+	// Either start from the input file or resume from a checkpoint
+	auto simplifier = opts.getSimplifier<MeshType::DATA, OnlyGeo<MeshType::DATA>>();
+	if (!simplifier)
+		return 0;
+	opts.run(*simplifier);
 		
 	#ifdef NDEBUG
 	high_resolution_clock::time_point stop = high_resolution_clock::now();
@@ -21,6 +21,10 @@ namespace geometry
 	using Vector3r = Matrix<Real,3,1>;
 	using Matrix3r = Matrix<Real,3,3>;
 	
+	// Minima of the edges whose cost has not been stored
+	static const array<Real,3> noMinima = {{numeric_limits<Real>::max(),
+		numeric_limits<Real>::max(), numeric_limits<Real>::max()}};
+	
 	
 	//
 	// Constructors
@@ -59,8 +63,8 @@ namespace geometry
 		assert(id < this->oprtr->getCPointerToMesh()->getElemsListSize());
 		
 		// Extract the first vertex of the triangle
-		auto elem = this->oprtr->getCPointerToMesh()->getElem(id);
-		auto p = this->oprtr->getCPointerToMesh()->getNode(elem[0]);
+		auto & elem = this->oprtr->getCPointerToMesh()->getElem(id);
+		auto p = this->oprtr->getCPointerToMesh()->getCoor(elem[0]);
 			
 		// Compute unit normal and (signed) distance from the origin
 		// for the plane identified by the triangle
@@ -95,7 +99,7 @@ namespace geometry
 		// of the triangle
 		for (UInt j = 0; j < numElems; ++j)
 		{
-			auto elem = this->oprtr->getCPointerToMesh()->getElem(j);
+			auto & elem = this->oprtr->getCPointerToMesh()->getElem(j);
 			auto K = getKMatrix(j);
 			Qs[elem[0]] += K;
 			Qs[elem[1]] += K;
@@ -107,8 +111,8 @@ namespace geometry
 	void DataGeo::updateQs(const UInt & newId)
 	{
 		// Extract the nodes connected to id
-		auto nodes = this->oprtr->getCPointerToConnectivity()
-			->getNode2Node(newId).getConnected();
+		auto & nodes = this->oprtr->getCPointerToConnectivity()
+			->getNode2Node(newId);
 		
 		// 
 		// Re-build Q matrix for the collapsing point
@@ -119,8 +123,8 @@ namespace geometry
 		
 		// Loop over all elements sharing the collapsing point,
 		// compute K and add it to Q
-		auto newId_elems = this->oprtr->getCPointerToConnectivity()
-			->getNode2Elem(newId).getConnected();
+		auto & newId_elems = this->oprtr->getCPointerToConnectivity()
+			->getNode2Elem(newId);
 		for (auto elem : newId_elems)
 			Qs[newId] += getKMatrix(elem);
 		
@@ -136,8 +140,8 @@ namespace geometry
 	
 			// Loop over all elements sharing the node,
 			// compute K and add it to Q
-			auto node_elems = this->oprtr->getCPointerToConnectivity()
-				->getNode2Elem(node).getConnected();
+			auto & node_elems = this->oprtr->getCPointerToConnectivity()
+				->getNode2Elem(node);
 			for (auto elem : node_elems)
 				Qs[node] += getKMatrix(elem);
 		}
@@ -367,6 +371,9 @@ namespace geometry
 			maxCost[1] = min_disp;
 		if (min_equi > maxCost[2])
 			maxCost[2] = min_equi;
+			
+		// Keep track of the minima
+		storeMinimumCosts(id1, id2);
 	}
 	
 	
@@ -378,13 +385,84 @@ namespace geometry
 		maxCost = {{numeric_limits<Real>::lowest(),
 			numeric_limits<Real>::lowest(), numeric_limits<Real>::lowest()}};
 			
+		// Reset per-edge minima and max-heaps
+		minCosts.assign(this->oprtr->getCPointerToConnectivity()
+			->getEdgeTable().getNumHandles(), noMinima);
+		for (auto & heap : maxHeaps)
+			heap = priority_queue<pair<Real,UInt>>();
+			
 		// Extract all edges
-		auto edges = this->oprtr->getCPointerToConnectivity()->getEdges();
+		auto edges = this->oprtr->getCPointerToConnectivity()->getEdgesView();
+		
+		// Loop over all edges, skipping the erased ones, and for
+		// each one possibly update the maximum values
+		for (auto & edge : edges)
+			if (edge[0] != edgeTable::none)
+				getMaximumCosts(edge[0], edge[1]);
+	}
+	
+	
+	void DataGeo::storeMinimumCosts(const UInt & id1, const UInt & id2)
+	{
+		// Edges without valid collapsing points are not stored
+		if ((min_geo == numeric_limits<Real>::max()) ||
+			(min_disp == numeric_limits<Real>::max()) ||
+			(min_equi == numeric_limits<Real>::max()))
+			return;
 		
-		// Loop over all edges and for each one possibly update
-		// the maximum values
-		for (auto edge : edges)
-			getMaximumCosts(edge[0], edge[1]);
+		auto & edges = this->oprtr->getCPointerToConnectivity()->getEdgeTable();
+		auto h = edges.find(id1, id2);
+		assert(h != edgeTable::none);
+		if (h >= minCosts.size())
+			minCosts.resize(edges.getNumHandles(), noMinima);
+		minCosts[h] = {{min_geo, min_disp, min_equi}};
+		maxHeaps[0].emplace(min_geo, h);
+		maxHeaps[1].emplace(min_disp, h);
+		maxHeaps[2].emplace(min_equi, h);
+		
+		//
+		// Possibly compact the heaps
+		//
+		// Stale entries are discarded only when they reach the top,
+		// then the heaps are re-built from scratch whenever they grow
+		// too large with respect to the number of edges
+		
+		if (maxHeaps[0].size() > 2 * edges.size() + 1024)
+			rebuildMaxHeaps();
+	}
+	
+	
+	void DataGeo::rebuildMaxHeaps()
+	{
+		for (UInt i = 0; i < 3; ++i)
+		{
+			vector<pair<Real,UInt>> entries;
+			entries.reserve(minCosts.size());
+			for (UInt h = 0; h < minCosts.size(); ++h)
+				if (minCosts[h] != noMinima)
+					entries.emplace_back(minCosts[h][i], h);
+			maxHeaps[i] = priority_queue<pair<Real,UInt>>
+				(less<pair<Real,UInt>>(), move(entries));
+		}
+	}
+	
+	
+	Real DataGeo::getRunningMaximum(const UInt & i)
+	{
+		while (!maxHeaps[i].empty() && isStale(i, maxHeaps[i].top()))
+			maxHeaps[i].pop();
+			
+		if (maxHeaps[i].empty())
+			return numeric_limits<Real>::lowest();
+		return maxHeaps[i].top().first;
+	}
+	
+	
+	bool DataGeo::isStale(const UInt & i, const pair<Real,UInt> & e) const
+	{
+		// The minimum has been either dropped along with the edge
+		// (see imp_update()) or re-computed afterwards
+		return (e.second >= minCosts.size()) || (minCosts[e.second][i] != e.first);
 	}
 		
 	
@@ -666,42 +744,137 @@ namespace geometry
 	}
 	
 	
-	//
-	// Updating methods
-	//
+	Real DataGeo::imp_getCost(const UInt & id1, const UInt & id2, const point3d & p,
+		const trialCollapse<Triangle, MeshType::DATA> & trial)
+	{
+		return imp_getCost(imp_getCostComponents(id1, id2, p, trial));
+	}
 	
-	void DataGeo::imp_addCollapseInfo(const UInt & id1, const UInt & id2, 
-		const Real & val, const point3d & p)
+	
+	Real DataGeo::imp_getCost_f(const UInt & id1, const UInt & id2, const point3d & p,
+		const trialCollapse<Triangle, MeshType::DATA> & trial) const
+	{
+		return imp_getCost_f(imp_getCostComponents(id1, id2, p, trial));
+	}
+	
+	
+	Real DataGeo::imp_getCost(const array<Real,3> & cmp)
+	{
+		// Check if they are the minima so far (for this edge)
+		if (cmp[0] < min_geo)
+			min_geo = cmp[0];
+		if (cmp[1] < min_disp)
+			min_disp = cmp[1];
+		if (cmp[2] < min_equi)
+			min_equi = cmp[2];
+		
+		//
+		// Final cost
+		//
+		
+		return imp_getCost_f(cmp);
+	}
+	
+	
+	Real DataGeo::imp_getCost_f(const array<Real,3> & cmp) const
+	{
+		return (weight[0] * cmp[0] / maxCost[0] + weight[1] * cmp[1] / maxCost[1]
+			+ weight[2] * cmp[2] / maxCost[2]);
+	}
+	
+	
+	void DataGeo::imp_getMemory(memoryReport & mr) const
+	{
+		mr.Qs = Qs.capacity() * sizeof(array<Real,10>);
+		mr.dataOrigin = dataOrigin.capacity() * sizeof(point3d);
+		mr.qoi = qoi.capacity() * sizeof(Real);
+		
+		// The capacity of the max-heaps is not accessible
+		mr.cost = minCosts.capacity() * sizeof(array<Real,3>);
+		for (auto & heap : maxHeaps)
+			mr.cost += heap.size() * sizeof(pair<Real,UInt>);
+	}
+	
+	
+	array<Real,3> DataGeo::imp_getCostComponents(const UInt & id1, const UInt & id2, 
+		const point3d & p, const trialCollapse<Triangle, MeshType::DATA> & trial) const
 	{
 		//
-		// Insert the new collapseInfo to the list
+		// Compute geometric cost function
 		//
 		
-		this->cInfoList.emplace(id1, id2, val, p);
+		// Extract the matrix Q associated to the edge
+		auto Q = Qs[id1] + Qs[id2];
 		
+		// Compute the quadratic form
+		Real geo = Q[0]*p[0]*p[0] + Q[4]*p[1]*p[1] + Q[7]*p[2]*p[2]
+			+ 2*Q[1]*p[0]*p[1] + 2*Q[2]*p[0]*p[2] + 2*Q[5]*p[1]*p[2]
+			+ 2*Q[3]*p[0] + 2*Q[6]*p[1] + 2*Q[8]*p[2] + Q[9];
+					
 		//
-		// Check if the costs should be re-computed
+		// Compute data displacement cost function
 		//
-		// For each component, check whether the minimum computed on the current edge
-		// significantly exceeds the current maximum. If so, set to_update to TRUE and
-		// update the maximum.
+		// Get the maximum distance between the original data point
+		// and its projection for involved data points
 		
-		if (min_geo > 1.3 * maxCost[0])
-		{
-			maxCost[0] = min_geo;
-			to_update = true;
-		}
+		auto & toMove = trial.getDataToMove();
+		auto & dataProjected = trial.getProjectedData();
 		
-		if (min_disp > 1.3 * maxCost[1])
+		Real disp(numeric_limits<Real>::lowest());
+		if (toMove.size() == 0)
+			disp = 0.;
+		else
 		{
-			maxCost[1] = min_disp;
-			to_update = true;
+			for (UInt i = 0; i < toMove.size(); ++i)
+			{
+				Real dl = (dataProjected[i] - dataOrigin[toMove[i]]).norm2();
+				if (dl > disp)	
+					disp = dl;
+			}
 		}
 		
-		if (min_equi > 1.3 * maxCost[2])
+		//
+		// Compute data distribution cost function
+		//
+		
+		auto & qoi_new = trial.getQuantityOfInformation();
+		
+		Real equi(0.);
+		for (auto q : qoi_new)
+			equi += (q - qoi_mean)*(q - qoi_mean);
+		
+		// Average over all involved elements
+		equi /= qoi_new.size();
+		
+		return {{geo, disp, equi}};
+	}
+	
+	
+	//
+	// Updating methods
+	//
+	
+	void DataGeo::imp_addCollapseInfo(const UInt & id1, const UInt & id2, 
+		const Real &, const point3d &)
+	{
+		//
+		// Check if the costs should be re-computed
+		//
+		// Store the minima computed on the current edge, then for each component
+		// check whether the maximum over all edges has significantly moved away 
+		// from the current normalizing value. If so, set to_update to TRUE and
+		// update the normalizing value.
+		
+		storeMinimumCosts(id1, id2);
+		
+		for (UInt i = 0; i < 3; ++i)
 		{
-			maxCost[2] = min_equi;
-			to_update = true;
+			auto m = getRunningMaximum(i);
+			if ((m > 0.) && ((m > 1.3 * maxCost[i]) || (1.3 * m < maxCost[i])))
+			{
+				maxCost[i] = m;
+				to_update = true;
+			}
 		}
 		
 		//
@@ -714,10 +887,20 @@ namespace geometry
 	}
 	
 	
-	void DataGeo::imp_update(const UInt & newId, const vector<UInt> & toRemove)
+	void DataGeo::imp_update(const UInt & newId, const UInt & oldId, const vector<UInt> & toRemove)
 	{
 		assert(this->oprtr != nullptr);
 		
+		// Drop the minima of the edges connected to the removed node,
+		// whose handles are about to be erased and possibly recycled
+		auto conn = this->oprtr->getCPointerToConnectivity();
+		for (auto id : conn->getNode2Node(oldId))
+		{
+			auto h = conn->getEdgeTable().find(oldId, id);
+			if (h < minCosts.size())
+				minCosts[h] = noMinima;
+		}
+		
 		// Update list of Q matrices
 		updateQs(newId);
 		
@@ -725,6 +908,151 @@ namespace geometry
 		// number of elements and average quantity of information
 		updateQuantityOfInformation(newId, toRemove);
 	}
+	
+	
+	void DataGeo::imp_refresh(const vector<UInt> & nodesOld2New, const vector<UInt> & elemsOld2New)
+	{
+		// Q matrices and quantities of information are
+		// indexed by nodes and elements Id's, respectively
+		utility::compact(Qs, nodesOld2New);
+		utility::compact(qoi, elemsOld2New);
+		
+		// The minima are moved along with the handles of the edges,
+		// which have been re-numbered by the connectivity
+		auto conn = this->oprtr->getCPointerToConnectivity();
+		auto & edgesOld2New = conn->getEdgesOld2New();
+		vector<array<Real,3>> oldCosts(move(minCosts));
+		minCosts.assign(conn->getEdgeTable().getNumHandles(), noMinima);
+		for (UInt h = 0; h < min(oldCosts.size(), edgesOld2New.size()); ++h)
+			if (edgesOld2New[h] != edgeTable::none)
+				minCosts[edgesOld2New[h]] = oldCosts[h];
+		
+		// The entries in the heaps refer to the old handles
+		rebuildMaxHeaps();
+	}
+	
+	
+	void DataGeo::imp_refreshData(const vector<UInt> & dataOld2New)
+	{
+		utility::compact(dataOrigin, dataOld2New);
+	}
+	
+	
+	void DataGeo::imp_shrinkToFit()
+	{
+		Qs.shrink_to_fit();
+		dataOrigin.shrink_to_fit();
+		qoi.shrink_to_fit();
+		
+		// Trailing free handles are dropped, then the heaps
+		// must not refer to them anymore
+		minCosts.resize(min(minCosts.size(), static_cast<size_t>(this->oprtr
+			->getCPointerToConnectivity()->getEdgeTable().getNumHandles())));
+		minCosts.shrink_to_fit();
+		rebuildMaxHeaps();
+	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	void DataGeo::imp_save(ostream & out) const
+	{
+		utility::write(out, Qs);
+		
+		vector<array<Real,3>> origin;
+		origin.reserve(dataOrigin.size());
+		for (auto p : dataOrigin)
+			origin.push_back(p.getCoor());
+		utility::write(out, origin);
+		
+		utility::write(out, qoi);
+		utility::write(out, numElems);
+		utility::write(out, qoi_mean);
+		utility::write(out, maxCost);
+		utility::write(out, weight);
+		utility::write(out, min_geo);
+		utility::write(out, min_disp);
+		utility::write(out, min_equi);
+		utility::write(out, to_update);
+		
+		// Write the minima stored for each edge; handles are not
+		// written, since they are re-assigned when reading
+		auto & edges = this->oprtr->getCPointerToConnectivity()->getEdgeTable();
+		vector<array<UInt,2>> ids;
+		vector<array<Real,3>> minima;
+		for (UInt h = 0; h < minCosts.size(); ++h)
+			if (minCosts[h] != noMinima)
+			{
+				ids.push_back(edges.getEnds(h));
+				minima.push_back(minCosts[h]);
+			}
+		utility::write(out, ids);
+		utility::write(out, minima);
+		
+		// Write the max-heaps, stale entries included, so that
+		// they get compacted as in an uninterrupted run
+		for (auto heap : maxHeaps)
+		{
+			vector<Real> vals;
+			ids.clear();
+			vals.reserve(heap.size());
+			ids.reserve(heap.size());
+			for ( ; !heap.empty(); heap.pop())
+			{
+				vals.push_back(heap.top().first);
+				ids.push_back(heap.top().second < edges.getNumHandles() ? 
+					edges.getEnds(heap.top().second) : 
+					array<UInt,2>({{edgeTable::none, edgeTable::none}}));
+			}
+			utility::write(out, vals);
+			utility::write(out, ids);
+		}
+	}
+	
+	
+	void DataGeo::imp_load(istream & in)
+	{
+		utility::read(in, Qs);
+		
+		vector<array<Real,3>> origin;
+		utility::read(in, origin);
+		dataOrigin.assign(origin.cbegin(), origin.cend());
+		
+		utility::read(in, qoi);
+		utility::read(in, numElems);
+		utility::read(in, qoi_mean);
+		utility::read(in, maxCost);
+		utility::read(in, weight);
+		utility::read(in, min_geo);
+		utility::read(in, min_disp);
+		utility::read(in, min_equi);
+		utility::read(in, to_update);
+		
+		// Read the minima stored for each edge; the connectivity,
+		// and so the set of edges, is supposed to have been read
+		auto & edges = this->oprtr->getCPointerToConnectivity()->getEdgeTable();
+		vector<array<UInt,2>> ids;
+		vector<array<Real,3>> minima;
+		utility::read(in, ids);
+		utility::read(in, minima);
+		minCosts.assign(edges.getNumHandles(), noMinima);
+		for (UInt i = 0; i < ids.size(); ++i)
+			minCosts[edges.find(ids[i][0], ids[i][1])] = minima[i];
+			
+		// Read the max-heaps; the entries of the edges which have
+		// been dropped are given an invalid handle
+		for (auto & heap : maxHeaps)
+		{
+			vector<Real> vals;
+			utility::read(in, vals);
+			utility::read(in, ids);
+			heap = priority_queue<pair<Real,UInt>>();
+			for (UInt i = 0; i < vals.size(); ++i)
+				heap.emplace(vals[i], edges.find(ids[i][0], ids[i][1]));
+		}
+	}
 }
 
 
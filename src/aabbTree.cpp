@@ -0,0 +1,273 @@
+/*!	\file	aabbTree.cpp
+	\brief	Implementations of members of class aabbTree. */
+
+#include <algorithm>
+#include <cassert>
+
+#include "aabbTree.hpp"
+
+// Include definitions of inlined members
+#ifndef INLINED
+#include "inline/inline_aabbTree.hpp"
+#endif
+
+namespace geometry
+{
+	constexpr UInt aabbTree::none;
+	constexpr UInt aabbTree::leafSize;
+
+
+	//
+	// Constructors
+	//
+
+	aabbTree::aabbTree(const Real & mg) :
+		maxGrowth(mg), numErased(0), numRebuilds(0)
+	{
+		assert(mg > 1.);
+	}
+
+
+	//
+	// Get methods
+	//
+
+	vector<bbox3d> aabbTree::getBoundingBox() const
+	{
+		vector<bbox3d> res;
+		res.reserve(size());
+		for (auto & bb : boxes)
+			if (bb.getId() != none)
+				res.push_back(bb);
+		for (auto & bb : extra)
+			if (bb.getId() != none)
+				res.push_back(bb);
+		return res;
+	}
+
+
+	//
+	// Modify the tree
+	//
+
+	void aabbTree::build(const vector<bbox3d> & all)
+	{
+		boxes = all;
+		extra.clear();
+		dirty.clear();
+		numErased = 0;
+
+		UInt numIds(0);
+		for (auto & bb : boxes)
+			numIds = max(numIds, bb.getId() + 1);
+		location.assign(numIds, none);
+		leaf.resize(boxes.size());
+
+		nodes.resize(boxes.empty() ? 0 : getNumNodes(boxes.size()));
+		if (!boxes.empty())
+			buildSubtree(0, 0, boxes.size(), none);
+	}
+
+
+	void aabbTree::replace(const bbox3d & bb)
+	{
+		auto id = bb.getId();
+		if (id >= location.size())
+			location.resize(id + 1, none);
+
+		// Element not in the tree: keep its box aside
+		auto loc = location[id];
+		if (loc == none)
+		{
+			location[id] = boxes.size() + extra.size();
+			extra.push_back(bb);
+			return;
+		}
+
+		if (loc < boxes.size())
+		{
+			boxes[loc] = bb;
+			dirty.push_back(leaf[loc]);
+		}
+		else
+			extra[loc - boxes.size()] = bb;
+	}
+
+
+	void aabbTree::erase(const UInt & id)
+	{
+		if ((id >= location.size()) || (location[id] == none))
+			return;
+
+		auto loc = location[id];
+		if (loc < boxes.size())
+		{
+			boxes[loc].setId(none);
+			dirty.push_back(leaf[loc]);
+		}
+		else
+			extra[loc - boxes.size()].setId(none);
+		location[id] = none;
+		++numErased;
+	}
+
+
+	void aabbTree::refit()
+	{
+		//
+		// Re-compute bounds bottom-up, stopping at the first
+		// node whose bounds do not change
+		//
+
+		sort(dirty.begin(), dirty.end());
+		dirty.erase(unique(dirty.begin(), dirty.end()), dirty.end());
+
+		vector<UInt> grown;
+		for (auto n : dirty)
+			while (computeBounds(n))
+			{
+				if ((nodes[n].right != none) && (getArea(nodes[n]) > maxGrowth * nodes[n].area))
+					grown.push_back(n);
+				if (nodes[n].parent == none)
+					break;
+				n = nodes[n].parent;
+			}
+		dirty.clear();
+
+		//
+		// Re-build the topmost subtrees which have grown too much;
+		// in pre-order, the nodes of a subtree follow its root
+		//
+
+		sort(grown.begin(), grown.end());
+		UInt end(0);
+		for (auto n : grown)
+			if (n >= end)
+			{
+				end = buildSubtree(n, nodes[n].first, nodes[n].count, nodes[n].parent);
+				++numRebuilds;
+			}
+	}
+
+
+	void aabbTree::shrinkToFit()
+	{
+		build(getBoundingBox());
+		nodes.shrink_to_fit();
+		boxes.shrink_to_fit();
+		extra.shrink_to_fit();
+		leaf.shrink_to_fit();
+		location.shrink_to_fit();
+		dirty.shrink_to_fit();
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	UInt aabbTree::buildSubtree(const UInt & n, const UInt & first,
+		const UInt & count, const UInt & parent)
+	{
+		nodes[n].parent = parent;
+		nodes[n].first = first;
+		nodes[n].count = count;
+
+		// Leaf
+		if (count <= leafSize)
+		{
+			nodes[n].right = none;
+			for (UInt k = first; k < first + count; ++k)
+			{
+				leaf[k] = n;
+				if (boxes[k].getId() != none)
+					location[boxes[k].getId()] = k;
+			}
+			computeBounds(n);
+			nodes[n].area = getArea(nodes[n]);
+			return n + 1;
+		}
+
+		//
+		// Split the boxes in two halves along the direction
+		// where the barycenters spread the most
+		//
+
+		array<Real,3> lo, hi;
+		lo.fill(numeric_limits<Real>::max());
+		hi.fill(numeric_limits<Real>::lowest());
+		for (UInt k = first; k < first + count; ++k)
+		{
+			auto c(boxes[k].getSW() + boxes[k].getNE());
+			for (UInt i = 0; i < 3; ++i)
+			{
+				lo[i] = min(lo[i], c[i]);
+				hi[i] = max(hi[i], c[i]);
+			}
+		}
+		UInt axis(0);
+		for (UInt i = 1; i < 3; ++i)
+			if (hi[i] - lo[i] > hi[axis] - lo[axis])
+				axis = i;
+
+		auto half(count / 2);
+		nth_element(boxes.begin() + first, boxes.begin() + first + half,
+			boxes.begin() + first + count, [axis](const bbox3d & a, const bbox3d & b)
+			{
+				return a.getSW()[axis] + a.getNE()[axis] < b.getSW()[axis] + b.getNE()[axis];
+			});
+
+		// Children
+		auto right = buildSubtree(n + 1, first, half, n);
+		nodes[n].right = right;
+		auto end = buildSubtree(right, first + half, count - half, n);
+
+		computeBounds(n);
+		nodes[n].area = getArea(nodes[n]);
+		return end;
+	}
+
+
+	bool aabbTree::computeBounds(const UInt & n)
+	{
+		auto & nd = nodes[n];
+		array<Real,3> sw, ne;
+		sw.fill(numeric_limits<Real>::max());
+		ne.fill(numeric_limits<Real>::lowest());
+
+		auto merge = [&](const point3d & psw, const point3d & pne)
+		{
+			for (UInt i = 0; i < 3; ++i)
+			{
+				sw[i] = min(sw[i], psw[i]);
+				ne[i] = max(ne[i], pne[i]);
+			}
+		};
+
+		// Leaf: merge the live boxes; otherwise, merge the children
+		if (nd.right == none)
+		{
+			for (UInt k = nd.first; k < nd.first + nd.count; ++k)
+				if (boxes[k].getId() != none)
+					merge(boxes[k].getSW(), boxes[k].getNE());
+		}
+		else
+		{
+			merge(point3d(nodes[n+1].SW), point3d(nodes[n+1].NE));
+			merge(point3d(nodes[nd.right].SW), point3d(nodes[nd.right].NE));
+		}
+
+		auto changed = (sw != nd.SW) || (ne != nd.NE);
+		nd.SW = sw;
+		nd.NE = ne;
+		return changed;
+	}
+
+
+	UInt aabbTree::getNumNodes(const UInt & count)
+	{
+		if (count <= leafSize)
+			return 1;
+		return 1 + getNumNodes(count / 2) + getNumNodes(count - count / 2);
+	}
+}
@@ -30,11 +30,14 @@ namespace geometry
 				 << "0 0 0" << endl;
 				 
 			// Print nodes
-			for (auto node : nodes)
-				file << node.getId()+1 	<< " "
+			for (UInt i = 0; i < nodes.size(); ++i)
+			{
+				auto node = nodes.getCoor(i);
+				file << i+1 			<< " "
 					 << node[0] 		<< " "
 					 << node[1] 		<< " "
 					 << node[2] 		<< endl;
+			}
 					 
 			// Print elements
 			for (auto elem : elems)
@@ -71,11 +74,14 @@ namespace geometry
 				 << "0 0 0" << endl;
 				 
 			// Print nodes
-			for (auto node : nodes)
-				file << node.getId()+1 	<< " "
+			for (UInt i = 0; i < nodes.size(); ++i)
+			{
+				auto node = nodes.getCoor(i);
+				file << i+1 			<< " "
 					 << node[0] 		<< " "
 					 << node[1] 		<< " "
 					 << node[2] 		<< endl;
+			}
 					 
 			// Print elements
 			for (auto elem : elems)
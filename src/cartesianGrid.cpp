@@ -0,0 +1,134 @@
+/*!	\file	cartesianGrid.cpp
+	\brief	Implementations of members of class cartesianGrid. */
+
+#include <cassert>
+
+#include "cartesianGrid.hpp"
+
+// Include definitions of inlined members
+#ifndef INLINED
+#include "inline/inline_cartesianGrid.hpp"
+#endif
+
+namespace geometry
+{
+	//
+	// Constructors
+	//
+
+	cartesianGrid::cartesianGrid(const point3d & pne, const point3d & psw,
+		const array<Real,3> & dl) :
+		NE(pne), SW(psw), cellSize(dl)
+	{
+		// Compute number of cells
+		updateNumCells();
+	}
+
+
+	//
+	// Set methods
+	//
+
+	void cartesianGrid::setNE(const point3d & p)
+	{
+		// Set the new point
+		NE = p;
+
+		// Update number of cells
+		updateNumCells();
+	}
+
+
+	void cartesianGrid::setSW(const point3d & p)
+	{
+		// Set the new point
+		SW = p;
+
+		// Update number of cells
+		updateNumCells();
+	}
+
+
+	void cartesianGrid::setCellSize(const UInt & i, const Real & val)
+	{
+		assert(i < 3);
+
+		// Set the new size
+		cellSize[i] = val;
+
+		// Update number of cells
+		updateNumCells(i);
+	}
+
+
+	void cartesianGrid::setCellSize(const array<Real,3> & val)
+	{
+		// Set the new sizes
+		cellSize = val;
+
+		// Update number of cells
+		updateNumCells();
+	}
+
+
+	void cartesianGrid::setNumCells(const UInt & i, const UInt & val)
+	{
+		assert(i < 3);
+
+		// Set the new number of cells
+		numCells[i] = val;
+
+		// Update related cells size
+		updateCellSize(i);
+	}
+
+
+	void cartesianGrid::setNumCells(const array<UInt,3> & val)
+	{
+		// Set the new numbers of cells
+		numCells = val;
+
+		// Update related cells size
+		updateCellSize();
+	}
+
+
+	//
+	// Methods to keep the attributes coherent
+	//
+
+	void cartesianGrid::updateNumCells(const UInt & i)
+	{
+		// Update the number of cells
+		numCells[i] = static_cast<UInt>((NE[i] - SW[i]) / cellSize[i]);
+
+		// Check it is not zero
+		if (numCells[i] == 0)
+			numCells[i] = 1;
+
+		// Update size
+		updateCellSize(i);
+	}
+
+
+	void cartesianGrid::updateNumCells()
+	{
+		for (UInt i = 0; i < 3; ++i)
+			updateNumCells(i);
+	}
+
+
+	void cartesianGrid::updateCellSize(const UInt & i)
+	{
+		assert(numCells[i] > 0);
+
+		cellSize[i] = (NE[i] - SW[i]) / numCells[i];
+	}
+
+
+	void cartesianGrid::updateCellSize()
+	{
+		for (UInt i = 0; i < 3; ++i)
+			updateCellSize(i);
+	}
+}
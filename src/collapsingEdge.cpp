@@ -16,14 +16,15 @@ namespace geometry
 	// Constructor
 	//
 	
-	collapsingEdge::collapsingEdge(const UInt & id1, const UInt & id2, const Real & val, const point3d & cp) :
-		Id1(id1), Id2(id2), cPoint(cp), cost(val)
+	collapsingEdge::collapsingEdge(const UInt & id1, const UInt & id2, const Real & val, const point3d & cp,
+		const array<Real,3> & cmp) :
+		Id1(id1), Id2(id2), cPoint(cp), cost(val), components(cmp)
 	{
 	}
 	
 	
 	collapsingEdge::collapsingEdge(const vector<UInt> & ids, const Real & val, const point3d & cp) :
-		Id1(ids[0]), Id2(ids[1]), cPoint(cp), cost(val)
+		Id1(ids[0]), Id2(ids[1]), cPoint(cp), cost(val), components{{0.,0.,0.}}
 	{
 	}
 	
@@ -41,8 +42,9 @@ namespace geometry
 		// Copy collapsing point
 		cPoint = cEdge.cPoint;
 		
-		// Copy collapsing cost
+		// Copy collapsing cost and its components
 		cost = cEdge.cost;
+		components = cEdge.components;
 		
 		return *this;
 	}
@@ -0,0 +1,338 @@
+/*!	\file	collapsingQueue.cpp
+	\brief	Implementations of members of class collapsingQueue. */
+
+#include <cassert>
+#include <algorithm>
+
+#include "collapsingQueue.hpp"
+
+// Include implementations of inlined class members
+#ifndef INLINED
+#include "inline/inline_collapsingQueue.hpp"
+#endif
+
+namespace geometry
+{
+	//
+	// Constructors
+	//
+
+	collapsingQueue::collapsingQueue(const edgeTable * et, const QueueMode & qm,
+		const Real & sb) :
+		mode(qm), staleBound(sb), lastVersion(0), edges(et), numEdges(0)
+	{
+	}
+
+
+	collapsingQueue::collapsingQueue(const edgeTable * et, const vector<collapsingEdge> & cEdges,
+		const QueueMode & qm, const Real & sb) :
+		mode(qm), staleBound(sb), lastVersion(0), edges(et), numEdges(0)
+	{
+		insert(cEdges);
+	}
+
+
+	//
+	// Access members
+	//
+
+	vector<collapsingEdge> collapsingQueue::getEdges() const
+	{
+		vector<collapsingEdge> cEdges;
+		cEdges.reserve(numEdges);
+		for (auto e : heap)
+			if (isValid(e))
+				cEdges.push_back(e.cEdge);
+		return cEdges;
+	}
+
+
+	size_t collapsingQueue::getMemory() const
+	{
+		return sizeof(collapsingQueue) + heap.capacity() * sizeof(entry) +
+			pos.capacity() * sizeof(UInt);
+	}
+
+
+	//
+	// Set methods
+	//
+
+	void collapsingQueue::setMode(const QueueMode & qm)
+	{
+		// Get rid of stale entries, then re-build the
+		// index according to the new mode
+		compact();
+		mode = qm;
+		for (auto & e : heap)
+			e.version = ++lastVersion;
+		heapify();
+	}
+
+
+	//
+	// Updating methods
+	//
+
+	void collapsingQueue::emplace(const UInt & id1, const UInt & id2, const Real & val,
+		const point3d & p, const array<Real,3> & cmp)
+	{
+		auto h = getHandle(id1,id2);
+		entry e{collapsingEdge(id1, id2, val, p, cmp), ++lastVersion, h.first};
+
+		if (mode == QueueMode::ADDRESSABLE)
+		{
+			// New edge: append it and move it up
+			if (h.second)
+			{
+				++numEdges;
+				heap.push_back(e);
+				siftUp(heap.size()-1);
+				return;
+			}
+
+			// Edge already in the queue: replace it and move it
+			// either up or down according to the new cost
+			UInt i(pos[h.first]);
+			bool up(e.cEdge < heap[i].cEdge);
+			heap[i] = e;
+			up ? siftUp(i) : siftDown(i);
+		}
+		else
+		{
+			// Push a new entry and make it the valid one;
+			// the old entry, if any, becomes stale
+			if (h.second)
+				++numEdges;
+			pos[h.first] = e.version;
+			heap.push_back(e);
+			siftUp(heap.size()-1);
+			prune();
+		}
+	}
+
+
+	void collapsingQueue::insert(const vector<collapsingEdge> & cEdges)
+	{
+		// Edges possibly already in the queue must be replaced
+		if (numEdges > 0)
+		{
+			for (auto cEdge : cEdges)
+				emplace(cEdge.getId1(), cEdge.getId2(), cEdge.getCost(),
+					cEdge.getCollapsingPoint(), cEdge.getComponents());
+			return;
+		}
+
+		// Get rid of stale entries (if any), then append all
+		// the edges and build the heap from scratch
+		heap.clear();
+		heap.reserve(cEdges.size());
+		for (auto cEdge : cEdges)
+			heap.push_back({cEdge, ++lastVersion,
+				edges->find(cEdge.getId1(), cEdge.getId2())});
+		heapify();
+	}
+
+
+	bool collapsingQueue::erase(const UInt & id1, const UInt & id2)
+	{
+		// Correctly handle the case the edge cannot be found
+		auto h = edges->find(id1,id2);
+		if ((h >= pos.size()) || (pos[h] == edgeTable::none))
+			return false;
+
+		--numEdges;
+		if (mode == QueueMode::ADDRESSABLE)
+		{
+			UInt i(pos[h]);
+			pos[h] = edgeTable::none;
+			removeAt(i);
+		}
+		else
+		{
+			// Just invalidate the entry
+			pos[h] = edgeTable::none;
+			prune();
+		}
+
+		return true;
+	}
+
+
+	void collapsingQueue::pop()
+	{
+		assert(!heap.empty());
+		--numEdges;
+		pos[heap.front().handle] = edgeTable::none;
+		removeAt(0);
+		prune();
+	}
+
+
+	void collapsingQueue::clear()
+	{
+		heap.clear();
+		pos.clear();
+		numEdges = 0;
+		lastVersion = 0;
+	}
+
+
+	void collapsingQueue::rekey(const function<Real(const collapsingEdge &)> & f)
+	{
+		// Update valid entries, then re-build the heap
+		compact();
+		for (auto & e : heap)
+			e.cEdge.setCost(f(e.cEdge));
+		heapify();
+	}
+
+
+	void collapsingQueue::refresh(const vector<UInt> & old2new)
+	{
+		// Drop stale entries and apply the map to the valid ones
+		// in a single pass, then re-build index and heap once;
+		// the handles are taken from the re-numbered set of edges
+		UInt j(0);
+		for (UInt i = 0; i < heap.size(); ++i)
+			if ((mode == QueueMode::ADDRESSABLE) || isValid(heap[i]))
+			{
+				heap[j] = heap[i];
+				heap[j].cEdge.setId1(old2new[heap[j].cEdge.getId1()]);
+				heap[j].cEdge.setId2(old2new[heap[j].cEdge.getId2()]);
+				heap[j].handle = edges->find(heap[j].cEdge.getId1(), heap[j].cEdge.getId2());
+				++j;
+			}
+		heap.resize(j);
+		heapify();
+	}
+
+
+	void collapsingQueue::shrinkToFit()
+	{
+		compact();
+		heap.shrink_to_fit();
+		pos.resize(min(pos.size(), static_cast<size_t>(edges->getNumHandles())));
+		pos.shrink_to_fit();
+	}
+
+
+	//
+	// Heap handling
+	//
+
+	pair<UInt,bool> collapsingQueue::getHandle(const UInt & id1, const UInt & id2)
+	{
+		auto h = edges->find(id1,id2);
+		assert(h != edgeTable::none);
+		if (h >= pos.size())
+			pos.resize(h + 1, edgeTable::none);
+		return {h, pos[h] == edgeTable::none};
+	}
+
+
+	void collapsingQueue::siftUp(UInt i)
+	{
+		// Hold the entry to move and shift down its ancestors
+		// until the right slot is found
+		entry e(heap[i]);
+		while (i > 0)
+		{
+			UInt parent((i-1) / D);
+			if (!(e.cEdge < heap[parent].cEdge))
+				break;
+			place(i, heap[parent]);
+			i = parent;
+		}
+		place(i, e);
+	}
+
+
+	void collapsingQueue::siftDown(UInt i)
+	{
+		// Hold the entry to move and shift up its cheapest child
+		// until the right slot is found
+		entry e(heap[i]);
+		UInt n(heap.size());
+		while (true)
+		{
+			UInt first(D*i + 1);
+			if (first >= n)
+				break;
+
+			UInt last(first + D < n ? first + D : n);
+			UInt child(first);
+			for (UInt j = first + 1; j < last; ++j)
+				if (heap[j].cEdge < heap[child].cEdge)
+					child = j;
+
+			if (!(heap[child].cEdge < e.cEdge))
+				break;
+			place(i, heap[child]);
+			i = child;
+		}
+		place(i, e);
+	}
+
+
+	void collapsingQueue::removeAt(const UInt & i)
+	{
+		// Fill the hole with the last entry, then restore the heap property
+		UInt last(heap.size()-1);
+		if (i != last)
+		{
+			bool up(heap[last].cEdge < heap[i].cEdge);
+			place(i, heap[last]);
+			heap.pop_back();
+			up ? siftUp(i) : siftDown(i);
+		}
+		else
+			heap.pop_back();
+	}
+
+
+	void collapsingQueue::prune()
+	{
+		if (mode == QueueMode::ADDRESSABLE)
+			return;
+
+		// Discard stale entries on the top
+		while (!heap.empty() && !isValid(heap.front()))
+			removeAt(0);
+
+		// Possibly compact the heap
+		if ((heap.size() >= minCompactSize) &&
+			(heap.size() - numEdges > staleBound * heap.size()))
+			compact();
+	}
+
+
+	void collapsingQueue::compact()
+	{
+		if (mode == QueueMode::ADDRESSABLE)
+			return;
+
+		// Remove stale entries and re-build the heap
+		UInt j(0);
+		for (UInt i = 0; i < heap.size(); ++i)
+			if (isValid(heap[i]))
+				heap[j++] = heap[i];
+		heap.resize(j);
+		heapify();
+	}
+
+
+	void collapsingQueue::heapify()
+	{
+		// Re-build the index
+		pos.assign(edges->getNumHandles(), edgeTable::none);
+		for (UInt i = 0; i < heap.size(); ++i)
+			pos[heap[i].handle] = (mode == QueueMode::ADDRESSABLE) ? i : heap[i].version;
+		numEdges = heap.size();
+
+		// Bottom-up construction
+		if (heap.size() > 1)
+			for (UInt i = (heap.size()-2) / D + 1; i-- > 0; )
+				siftDown(i);
+	}
+}
@@ -54,6 +54,7 @@ namespace geometry
 		#endif
 						
 		// Go through all data points
+		vector<UInt> ids;
 		for (UInt i = 0; i < this->grid.getNumData(); ++i)
 		{
 			// Variables to keep track of the closest triangle,
@@ -69,7 +70,7 @@ namespace geometry
 			bool toassociate(true);
 			
 			// Get triangles the data point may belong to
-			auto ids( sd.getNeighbouringElements(this->grid.getData(i)) );
+			sd.getNeighbouringElements(this->grid.getData(i), ids);
 			
 			// Test belonging for each triangle; when done, exit
 			for (UInt j = 0; j < ids.size() && toassociate; ++j)
@@ -0,0 +1,88 @@
+/*!	\file	driverOptions.cpp
+	\brief	Definitions of members of class driverOptions. */
+
+#include <sstream>
+#include <cstring>
+#include <algorithm>
+
+#include "driverOptions.hpp"
+
+namespace geometry
+{
+	bool driverOptions::read(const char * option, const char * arg)
+	{
+		if (!strcmp(option,"-i") || !strcmp(option,"--input"))
+			iFile = arg;
+		else if (!strcmp(option,"-n") || !strcmp(option,"--nodes"))
+		{
+			istringstream targets(arg);
+			string target;
+			while (getline(targets, target, ','))
+				n.push_back(atoi(target.c_str()));
+		}
+		else if (!strcmp(option,"-o") || !strcmp(option,"--output"))
+			oFile = arg;
+		else if (!strcmp(option,"-q") || !strcmp(option,"--queue"))
+			qm = strcmp(arg,"lazy") ? QueueMode::ADDRESSABLE : QueueMode::LAZY;
+		else if (!strcmp(option,"--search"))
+		{
+			sm = strcmp(arg,"bvh") ? SearchMode::GRID : SearchMode::BVH;
+			autoTuning = !strcmp(arg,"auto");
+		}
+		else if (!strcmp(option,"-k") || !strcmp(option,"--choices"))
+			k = atoi(arg);
+		else if (!strcmp(option,"-s") || !strcmp(option,"--seed"))
+			seed = atoi(arg);
+		else if (!strcmp(option,"-l") || !strcmp(option,"--lod"))
+			lods.push_back(atoi(arg));
+		else if (!strcmp(option,"-c") || !strcmp(option,"--checkpoint"))
+			cFile = arg;
+		else if (!strcmp(option,"-e") || !strcmp(option,"--every"))
+			step = atoi(arg);
+		else if (!strcmp(option,"-r") || !strcmp(option,"--resume"))
+			rFile = arg;
+		else if (!strcmp(option,"--disable-fixed-element"))
+			fixedElem = false;
+		else
+			return false;
+		return true;
+	}
+
+
+	bool driverOptions::check() const
+	{
+		// Check on input file
+		if (iFile.empty() && rFile.empty())
+		{
+			cout << "Input file not provided. Aborted." << endl;
+			return false;
+		}
+
+		// Check on final number of nodes
+		if (n.empty() || (find(n.cbegin(), n.cend(), 0) != n.cend()))
+		{
+			cout << "Target number of nodes not provided or zero. Aborted." << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+
+	void driverOptions::printHelp(ostream & out)
+	{
+		out << "-h, --help                 " << "print help" << endl
+		<< "-i, --input [file]         " << "specify path to input file (mandatory)" << endl
+		<< "-n, --nodes [n]            " << "set target number of nodes (mandatory); a comma-separated list, e.g. 32000,16000,8000, prints a mesh per target in a single pass" << endl
+		<< "-o, --output [file]        " << "specify path to output file (default: none)" << endl
+		<< "-q, --queue [mode]         " << "set collapse queue mode, either addressable or lazy (default: addressable)" << endl
+		<< "--search [mode]            " << "set search mode for the intersection control, either grid, bvh or auto, i.e. a grid whose cells are tuned upon the elements (default: grid)" << endl
+		<< "-k, --choices [k]          " << "use the multiple-choice scheduler, sampling k random edges per collapse (default: 0, i.e. use the queue)" << endl
+		<< "-s, --seed [s]             " << "set seed for the multiple-choice scheduler (default: 0)" << endl
+		<< "-l, --lod [m]              " << "also print the mesh at m nodes, extracted from the collapse log; may be repeated (requires -o)" << endl
+		<< "-c, --checkpoint [file]    " << "write a checkpoint to file while simplifying (default: none)" << endl
+		<< "-e, --every [m]            " << "write a checkpoint every m collapsed nodes (default: 1000)" << endl
+		<< "-r, --resume [file]        " << "resume from a checkpoint, in place of -i; the settings are taken from the checkpoint" << endl
+		<< "--disable-fixed-element    " << "disable fixed element" << endl;
+	}
+}
@@ -0,0 +1,209 @@
+/*!	\file	edgeTable.cpp
+	\brief	Implementations of members of class edgeTable. */
+
+#include <utility>
+#include <algorithm>
+
+#include "edgeTable.hpp"
+
+// Include implementations of inlined class members
+#ifndef INLINED
+#include "inline/inline_edgeTable.hpp"
+#endif
+
+namespace geometry
+{
+	constexpr UInt edgeTable::none;
+	constexpr UInt edgeTable::minNumSlots;
+
+
+	//
+	// Constructor
+	//
+
+	edgeTable::edgeTable(const UInt & n) :
+		shift(64)
+	{
+		rehash(minNumSlots);
+		reserve(n);
+	}
+
+
+	//
+	// Get methods
+	//
+
+	size_t edgeTable::getMemory() const
+	{
+		return sizeof(edgeTable) + slots.capacity() * sizeof(slot) +
+			ends.capacity() * sizeof(array<UInt,2>) + freeHandles.capacity() * sizeof(UInt);
+	}
+
+
+	//
+	// Insert and erase methods
+	//
+
+	pair<UInt,bool> edgeTable::insert(const UInt & id1, const UInt & id2)
+	{
+		auto i = findSlot(min(id1,id2), max(id1,id2));
+		if (i != none)
+			return {slots[i].handle, false};
+
+		// Keep the load factor below 3/4
+		if (4 * (size() + 1) > 3 * slots.size())
+			rehash(2 * slots.size());
+
+		// Possibly recycle the handle of an erased edge
+		UInt h;
+		array<UInt,2> e{{min(id1,id2), max(id1,id2)}};
+		if (freeHandles.empty())
+		{
+			h = ends.size();
+			ends.push_back(e);
+		}
+		else
+		{
+			h = freeHandles.back();
+			freeHandles.pop_back();
+			ends[h] = e;
+		}
+
+		place({e[0], e[1], h});
+		return {h, true};
+	}
+
+
+	UInt edgeTable::erase(const UInt & id1, const UInt & id2)
+	{
+		auto i = findSlot(min(id1,id2), max(id1,id2));
+		if (i == none)
+			return none;
+		auto h = slots[i].handle;
+
+		// Shift back the following entries, until either an empty
+		// slot or an entry lying in its home slot is found
+		UInt mask(slots.size() - 1);
+		for (UInt j = (i+1) & mask; (slots[j].id1 != none) && (distance(j) > 0);
+			j = (j+1) & mask)
+		{
+			slots[i] = slots[j];
+			i = j;
+		}
+		slots[i].id1 = none;
+
+		// Release the handle
+		ends[h] = {{none, none}};
+		freeHandles.push_back(h);
+		return h;
+	}
+
+
+	void edgeTable::clear()
+	{
+		for (auto & s : slots)
+			s.id1 = none;
+		ends.clear();
+		freeHandles.clear();
+	}
+
+
+	void edgeTable::reserve(const UInt & n)
+	{
+		UInt numSlots(slots.size());
+		while (4 * n > 3 * numSlots)
+			numSlots *= 2;
+		if (numSlots > slots.size())
+			rehash(numSlots);
+		ends.reserve(n);
+	}
+
+
+	void edgeTable::shrinkToFit()
+	{
+		UInt numSlots(minNumSlots);
+		while (4 * size() > 3 * numSlots)
+			numSlots *= 2;
+		if (numSlots < slots.size())
+			rehash(numSlots);
+		slots.shrink_to_fit();
+
+		// Drop the free handles at the back, which no edge refers to
+		UInt n(ends.size());
+		while ((n > 0) && (ends[n-1][0] == none))
+			--n;
+		if (n < ends.size())
+		{
+			ends.resize(n);
+			freeHandles.erase(remove_if(freeHandles.begin(), freeHandles.end(),
+				[n](const UInt & h){ return h >= n; }), freeHandles.end());
+		}
+		ends.shrink_to_fit();
+		freeHandles.shrink_to_fit();
+	}
+
+
+	vector<UInt> edgeTable::refresh(const vector<UInt> & old2new)
+	{
+		// Empty the table, keeping the number of slots
+		vector<array<UInt,2>> oldEnds(move(ends));
+		ends.clear();
+		ends.reserve(oldEnds.size());
+		freeHandles.clear();
+		for (auto & s : slots)
+			s.id1 = none;
+
+		// Insert the edges in the order of their old handles;
+		// no handle is recycled, then the new ones are dense
+		vector<UInt> handles(oldEnds.size(), none);
+		for (UInt h = 0; h < oldEnds.size(); ++h)
+			if ((oldEnds[h][0] != none) && (old2new[oldEnds[h][0]] != REMOVED_ID) &&
+				(old2new[oldEnds[h][1]] != REMOVED_ID))
+				handles[h] = insert(old2new[oldEnds[h][0]], old2new[oldEnds[h][1]]).first;
+		return handles;
+	}
+
+
+	//
+	// Auxiliary methods
+	//
+
+	void edgeTable::place(slot s)
+	{
+		// A key travelling farther from its home slot than the
+		// entry found takes its place, and the entry goes on
+		UInt mask(slots.size() - 1);
+		for (UInt i = home(key(s)), d = 0; ; i = (i+1) & mask, ++d)
+		{
+			if (slots[i].id1 == none)
+			{
+				slots[i] = s;
+				return;
+			}
+
+			auto di = distance(i);
+			if (di < d)
+			{
+				swap(s, slots[i]);
+				d = di;
+			}
+		}
+	}
+
+
+	void edgeTable::rehash(const UInt & n)
+	{
+		vector<slot> old(move(slots));
+		slots.assign(n, {none, none, 0});
+
+		// The home slot is given by the highest log2(n) bits
+		// of the hashed key
+		shift = 64;
+		for (UInt m = n; m > 1; m >>= 1)
+			--shift;
+
+		for (auto & s : old)
+			if (s.id1 != none)
+				place(s);
+	}
+}
@@ -1,7 +1,10 @@
 /*!	\file	graphItem.cpp
 	\brief	Implementations of members and friend functions of class graphItem. */
 	
+#include <algorithm>
+
 #include "graphItem.hpp"
+#include "utility.hpp"
 
 // Include definitions of inlined members and friend functions 
 #ifndef INLINED
@@ -31,6 +34,12 @@ namespace geometry
 	{
 	}
 		
+	
+	graphItem::graphItem(const flatSet<UInt> & c, const UInt & ID) :
+		Id(ID), conn(c), active(true) 
+	{
+	}
+		
 		
 	//
 	// Operators
@@ -42,8 +51,7 @@ namespace geometry
 		Id = g.Id;
 		
 		// Copy connected elements
-		conn.clear();
-		copy(g.conn.cbegin(), g.conn.cend(), inserter(conn, conn.end()));
+		conn = g.conn;
 		
 		// Copy active flag
 		active = g.active;
@@ -77,26 +85,24 @@ namespace geometry
 	void graphItem::setConnected(const vector<UInt> & v)
 	{
 		conn.clear();
-		copy(v.cbegin(), v.cend(), inserter(conn, conn.end()));
+		conn.insert(v.cbegin(), v.cend());
 	}
 	
 	
 	//
-	// Find, insert, replace and erase methods
+	// Find, insert, replace, remap and erase methods
 	//
 	
-	pair<set<UInt>::iterator,bool> graphItem::find(const UInt & val)
+	pair<flatSet<UInt>::iterator,bool> graphItem::find(const UInt & val)
 	{
-		auto it = std::find(conn.cbegin(), conn.cend(), val);
-		return make_pair(it, it != conn.cend());
+		auto it = conn.find(val);
+		return make_pair(it, it != conn.end());
 	}
 	
 	
 	void graphItem::insert(const vector<UInt> & v)
 	{
-		// Make v a set and then add it
-		set<UInt> s(v.cbegin(), v.cend());
-		set_union(conn.begin(), conn.end(), s.cbegin(), s.cend(), inserter(conn, conn.begin()));
+		conn.insert(v.cbegin(), v.cend());
 	}
 	
 	void graphItem::replace(const UInt & oldId, const UInt & newId)
@@ -112,13 +118,52 @@ namespace geometry
 	}
 	
 	
+	void graphItem::remap(const vector<UInt> & old2new)
+	{
+		// Overwrite the connected Id's with their images,
+		// skipping the removed ones, then drop the tail
+		auto out = conn.begin();
+		for (auto it = conn.begin(); it != conn.end(); ++it)
+			if (old2new[*it] != REMOVED_ID)
+				*(out++) = old2new[*it];
+		while (conn.end() != out)
+			conn.erase(conn.end() - 1);
+		
+		// Restore the order, if the map did not preserve it
+		if (!is_sorted(conn.begin(), conn.end()))
+			sort(conn.begin(), conn.end());
+	}
+	
+	
+	//
+	// Binary input/output
+	//
+	
+	void graphItem::save(ostream & out) const
+	{
+		utility::write(out, Id);
+		utility::write(out, active);
+		utility::write(out, vector<UInt>(conn.cbegin(), conn.cend()));
+	}
+	
+	
+	void graphItem::load(istream & in)
+	{
+		utility::read(in, Id);
+		utility::read(in, active);
+		vector<UInt> v;
+		utility::read(in, v);
+		conn = flatSet<UInt>(v.cbegin(), v.cend());
+	}
+	
+	
 	//
 	// Common and uncommon connected
 	//
 	
-	set<UInt> set_intersection(const graphItem & g1, const graphItem & g2)
+	flatSet<UInt> set_intersection(const graphItem & g1, const graphItem & g2)
 	{
-		set<UInt> res;
+		flatSet<UInt> res;
 		set_intersection(g1.conn.cbegin(), g1.conn.cend(), g2.conn.cbegin(), g2.conn.cend(), inserter(res, res.end()));
 		return res;
 	}
@@ -131,9 +176,9 @@ namespace geometry
 	}
 	
 	
-	set<UInt> set_union(const graphItem & g1, const graphItem & g2)
+	flatSet<UInt> set_union(const graphItem & g1, const graphItem & g2)
 	{
-		set<UInt> res;
+		flatSet<UInt> res;
 		set_union(g1.conn.cbegin(), g1.conn.cend(), g2.conn.cbegin(), g2.conn.cend(), inserter(res, res.end()));
 		return res;
 	}
@@ -146,9 +191,9 @@ namespace geometry
 	}
 	
 	
-	set<UInt> set_difference(const graphItem & g1, const graphItem & g2)
+	flatSet<UInt> set_difference(const graphItem & g1, const graphItem & g2)
 	{
-		set<UInt> res;
+		flatSet<UInt> res;
 		set_difference(g1.conn.cbegin(), g1.conn.cend(), g2.conn.cbegin(), g2.conn.cend(), inserter(res, res.end()));
 		return res;
 	}
@@ -161,9 +206,9 @@ namespace geometry
 	}
 	
 	
-	set<UInt> set_symmetric_difference(const graphItem & g1, const graphItem & g2)
+	flatSet<UInt> set_symmetric_difference(const graphItem & g1, const graphItem & g2)
 	{
-		set<UInt> res;
+		flatSet<UInt> res;
 		set_symmetric_difference(g1.conn.cbegin(), g1.conn.cend(), g2.conn.cbegin(), g2.conn.cend(), inserter(res, res.end()));
 		return res;
 	}
@@ -3,6 +3,7 @@
 	
 #include <cmath>
 #include <cstdlib>
+#include <algorithm>
 	
 #include "utility.hpp"
 #include "gutility.hpp"
@@ -551,4 +552,66 @@ namespace geometry
 		// triangle in a non-conformal way
 		return IntersectionType::INVALID;
 	}
-} 
+	
+	
+	//
+	// Space-filling curves
+	//
+	
+	uint64_t gutility::getMortonCode(const point3d & p, const point3d & SW,
+		const point3d & NE)
+	{
+		// Spread the lowest 21 bits of an integer, leaving
+		// two zero bits between any two of them
+		auto spread = [](uint64_t v)
+		{
+			v &= 0x1fffff;
+			v = (v | (v << 32)) & 0x1f00000000ffff;
+			v = (v | (v << 16)) & 0x1f0000ff0000ff;
+			v = (v | (v << 8)) & 0x100f00f00f00f00f;
+			v = (v | (v << 4)) & 0x10c30c30c30c30c3;
+			v = (v | (v << 2)) & 0x1249249249249249;
+			return v;
+		};
+		
+		uint64_t code(0);
+		for (UInt i = 0; i < 3; ++i)
+		{
+			// Quantize the coordinate on 21 bits
+			Real l(NE[i] - SW[i]);
+			Real t = (l > 0.) ? (p[i] - SW[i]) / l : 0.;
+			t = min(max(t, 0.), 1.);
+			code |= spread(static_cast<uint64_t>(t * 0x1fffff)) << i;
+		}
+		return code;
+	}
+	
+	
+	vector<UInt> gutility::getMortonOrder(const vector<point3d> & pts)
+	{
+		vector<UInt> old2new(pts.size());
+		if (pts.empty())
+			return old2new;
+		
+		// Bounding box of the points
+		point3d SW(pts[0]), NE(pts[0]);
+		for (auto & p : pts)
+			for (UInt i = 0; i < 3; ++i)
+			{
+				SW[i] = min(SW[i], p[i]);
+				NE[i] = max(NE[i], p[i]);
+			}
+		
+		// Sort the positions by code
+		vector<pair<uint64_t,UInt>> codes;
+		codes.reserve(pts.size());
+		for (UInt i = 0; i < pts.size(); ++i)
+			codes.emplace_back(getMortonCode(pts[i], SW, NE), i);
+		sort(codes.begin(), codes.end());
+		
+		// Invert the permutation
+		for (UInt i = 0; i < codes.size(); ++i)
+			old2new[codes[i].second] = i;
+		return old2new;
+	}
+}
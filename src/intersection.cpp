@@ -15,6 +15,13 @@
 	checks may be implemented in future just for the sake of
 	completeness. */
 	
+#include <cmath>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "utility.hpp"
 #include "intersection.hpp"
 
@@ -25,6 +32,208 @@
 
 namespace geometry
 {
+	namespace
+	{
+		//
+		// Lanes
+		//
+		// A lane stores the same quantity for some consecutive 
+		// triangles of a batch. Comparisons return a mask, 
+		// which is turned into a bitmask by bits().
+		
+		/*!	Single triangle, used when no SIMD instruction
+			set is available and for the tail of a batch. */
+		struct lane1
+		{
+			Real v;
+			
+			static constexpr UInt width = 1;
+			static lane1 load(const Real * p) { return {*p}; }
+			static lane1 set(const Real & x) { return {x}; }
+		};
+		
+		inline lane1 operator+(const lane1 & a, const lane1 & b) { return {a.v + b.v}; }
+		inline lane1 operator-(const lane1 & a, const lane1 & b) { return {a.v - b.v}; }
+		inline lane1 operator*(const lane1 & a, const lane1 & b) { return {a.v * b.v}; }
+		inline lane1 operator/(const lane1 & a, const lane1 & b) { return {a.v / b.v}; }
+		inline bool operator>(const lane1 & a, const lane1 & b) { return a.v > b.v; }
+		inline bool operator<(const lane1 & a, const lane1 & b) { return a.v < b.v; }
+		inline lane1 vsqrt(const lane1 & a) { return {std::sqrt(a.v)}; }
+		inline lane1 vmin(const lane1 & a, const lane1 & b) { return {min(a.v, b.v)}; }
+		inline lane1 vmax(const lane1 & a, const lane1 & b) { return {max(a.v, b.v)}; }
+		inline lane1 select(const bool & m, const lane1 & a, const lane1 & b) { return m ? a : b; }
+		inline unsigned bits(const bool & m) { return m; }
+		
+		#if defined(__AVX__)
+		/*!	Four triangles, through AVX instructions. */
+		struct lane4
+		{
+			__m256d v;
+			
+			static constexpr UInt width = 4;
+			static lane4 load(const Real * p) { return {_mm256_loadu_pd(p)}; }
+			static lane4 set(const Real & x) { return {_mm256_set1_pd(x)}; }
+		};
+		
+		inline lane4 operator+(const lane4 & a, const lane4 & b) { return {_mm256_add_pd(a.v, b.v)}; }
+		inline lane4 operator-(const lane4 & a, const lane4 & b) { return {_mm256_sub_pd(a.v, b.v)}; }
+		inline lane4 operator*(const lane4 & a, const lane4 & b) { return {_mm256_mul_pd(a.v, b.v)}; }
+		inline lane4 operator/(const lane4 & a, const lane4 & b) { return {_mm256_div_pd(a.v, b.v)}; }
+		inline lane4 operator>(const lane4 & a, const lane4 & b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+		inline lane4 operator<(const lane4 & a, const lane4 & b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+		inline lane4 operator&(const lane4 & a, const lane4 & b) { return {_mm256_and_pd(a.v, b.v)}; }
+		inline lane4 operator|(const lane4 & a, const lane4 & b) { return {_mm256_or_pd(a.v, b.v)}; }
+		inline lane4 vsqrt(const lane4 & a) { return {_mm256_sqrt_pd(a.v)}; }
+		inline lane4 vmin(const lane4 & a, const lane4 & b) { return {_mm256_min_pd(a.v, b.v)}; }
+		inline lane4 vmax(const lane4 & a, const lane4 & b) { return {_mm256_max_pd(a.v, b.v)}; }
+		inline lane4 select(const lane4 & m, const lane4 & a, const lane4 & b) { return {_mm256_blendv_pd(b.v, a.v, m.v)}; }
+		inline unsigned bits(const lane4 & m) { return _mm256_movemask_pd(m.v); }
+		#elif defined(__SSE2__)
+		/*!	Two triangles, through SSE2 instructions. */
+		struct lane2
+		{
+			__m128d v;
+			
+			static constexpr UInt width = 2;
+			static lane2 load(const Real * p) { return {_mm_loadu_pd(p)}; }
+			static lane2 set(const Real & x) { return {_mm_set1_pd(x)}; }
+		};
+		
+		inline lane2 operator+(const lane2 & a, const lane2 & b) { return {_mm_add_pd(a.v, b.v)}; }
+		inline lane2 operator-(const lane2 & a, const lane2 & b) { return {_mm_sub_pd(a.v, b.v)}; }
+		inline lane2 operator*(const lane2 & a, const lane2 & b) { return {_mm_mul_pd(a.v, b.v)}; }
+		inline lane2 operator/(const lane2 & a, const lane2 & b) { return {_mm_div_pd(a.v, b.v)}; }
+		inline lane2 operator>(const lane2 & a, const lane2 & b) { return {_mm_cmpgt_pd(a.v, b.v)}; }
+		inline lane2 operator<(const lane2 & a, const lane2 & b) { return {_mm_cmplt_pd(a.v, b.v)}; }
+		inline lane2 operator&(const lane2 & a, const lane2 & b) { return {_mm_and_pd(a.v, b.v)}; }
+		inline lane2 operator|(const lane2 & a, const lane2 & b) { return {_mm_or_pd(a.v, b.v)}; }
+		inline lane2 vsqrt(const lane2 & a) { return {_mm_sqrt_pd(a.v)}; }
+		inline lane2 vmin(const lane2 & a, const lane2 & b) { return {_mm_min_pd(a.v, b.v)}; }
+		inline lane2 vmax(const lane2 & a, const lane2 & b) { return {_mm_max_pd(a.v, b.v)}; }
+		inline lane2 select(const lane2 & m, const lane2 & a, const lane2 & b) 
+		{
+			return {_mm_or_pd(_mm_and_pd(m.v, a.v), _mm_andnot_pd(m.v, b.v))};
+		}
+		inline unsigned bits(const lane2 & m) { return _mm_movemask_pd(m.v); }
+		#endif
+		
+		
+		//
+		// Rejection tests
+		//
+		
+		/*!	Get the interval a triangle cuts on the line where
+			the plane of another triangle meets its own plane.
+			The vertices should lie on both sides of the other plane.
+			\param p0	projection of the first vertex on the line
+			\param p1	projection of the second vertex on the line
+			\param p2	projection of the third vertex on the line
+			\param d0	signed distance of the first vertex from the other plane
+			\param d1	signed distance of the second vertex from the other plane
+			\param d2	signed distance of the third vertex from the other plane
+			\param lo	lower end of the interval
+			\param hi	upper end of the interval */
+		template<typename L>
+		inline void getInterval(const L & p0, const L & p1, const L & p2,
+			const L & d0, const L & d1, const L & d2, L & lo, L & hi)
+		{
+			// Find the vertex lying alone on its side of the plane
+			auto zero = L::set(0.);
+			auto s01 = d0*d1 > zero;
+			auto s12 = d1*d2 > zero;
+			auto pl = select(s01, p2, select(s12, p0, p1));
+			auto dl = select(s01, d2, select(s12, d0, d1));
+			auto pa = select(s01, p0, select(s12, p1, p0));
+			auto da = select(s01, d0, select(s12, d1, d0));
+			auto pb = select(s01, p1, p2);
+			auto db = select(s01, d1, d2);
+			
+			// The edges leaving that vertex cross the plane
+			auto ta = pl + (pa - pl) * dl / (dl - da);
+			auto tb = pl + (pb - pl) * dl / (dl - db);
+			lo = vmin(ta, tb);
+			hi = vmax(ta, tb);
+		}
+		
+		
+		/*!	Find which triangles of a batch can not intersect a 
+			given triangle, starting from a given position.
+			\param A		first vertex of the triangle
+			\param B		second vertex of the triangle
+			\param C		third vertex of the triangle
+			\param N		unit normal to the triangle
+			\param RHS		right-hand side of the equation of its plane
+			\param margin	tolerance on distances
+			\param batch	the other triangles
+			\param k		position of the first triangle of the batch to test
+			eturn			bitmask, whose j-th bit is set iff the triangle and
+							the (k+j)-th triangle of the batch can not intersect */
+		template<typename L>
+		inline unsigned getSeparated(const point3d & A, const point3d & B, const point3d & C,
+			const point3d & N, const Real & RHS, const Real & margin, 
+			const triangleBatch & batch, const UInt & k)
+		{
+			auto m = L::set(margin);
+			auto mm = L::set(-margin);
+			
+			// Vertices of the triangles
+			auto Ax(L::set(A[0])), Ay(L::set(A[1])), Az(L::set(A[2]));
+			auto Bx(L::set(B[0])), By(L::set(B[1])), Bz(L::set(B[2]));
+			auto Cx(L::set(C[0])), Cy(L::set(C[1])), Cz(L::set(C[2]));
+			auto Dx(L::load(batch.data(0,0) + k)), Dy(L::load(batch.data(0,1) + k)), Dz(L::load(batch.data(0,2) + k));
+			auto Ex(L::load(batch.data(1,0) + k)), Ey(L::load(batch.data(1,1) + k)), Ez(L::load(batch.data(1,2) + k));
+			auto Fx(L::load(batch.data(2,0) + k)), Fy(L::load(batch.data(2,1) + k)), Fz(L::load(batch.data(2,2) + k));
+			
+			// Signed distances of D, E and F from the plane of ABC
+			auto nx(L::set(N[0])), ny(L::set(N[1])), nz(L::set(N[2]));
+			auto rhs = L::set(RHS);
+			auto dD = nx*Dx + ny*Dy + nz*Dz - rhs;
+			auto dE = nx*Ex + ny*Ey + nz*Ez - rhs;
+			auto dF = nx*Fx + ny*Fy + nz*Fz - rhs;
+			
+			// Signed distances of A, B and C from the plane of DEF;
+			// for a degenerate triangle, they are not a number and
+			// the pair is not discarded
+			auto ux(Ex - Dx), uy(Ey - Dy), uz(Ez - Dz);
+			auto vx(Fx - Ex), vy(Fy - Ey), vz(Fz - Ez);
+			auto Nx(uy*vz - uz*vy), Ny(uz*vx - ux*vz), Nz(ux*vy - uy*vx);
+			auto len = vsqrt(Nx*Nx + Ny*Ny + Nz*Nz);
+			Nx = Nx / len;
+			Ny = Ny / len;
+			Nz = Nz / len;
+			auto rhs2 = Nx*Dx + Ny*Dy + Nz*Dz;
+			auto dA = Nx*Ax + Ny*Ay + Nz*Az - rhs2;
+			auto dB = Nx*Bx + Ny*By + Nz*Bz - rhs2;
+			auto dC = Nx*Cx + Ny*Cy + Nz*Cz - rhs2;
+			
+			// A triangle lies strictly on one side of the other plane
+			auto separated = ((dD > m) & (dE > m) & (dF > m)) | ((dD < mm) & (dE < mm) & (dF < mm)) |
+				((dA > m) & (dB > m) & (dC > m)) | ((dA < mm) & (dB < mm) & (dC < mm));
+				
+			//
+			// Interval test, only when no vertex is close to the 
+			// other plane and the planes are not almost parallel
+			//
+			
+			auto Lx(ny*Nz - nz*Ny), Ly(nz*Nx - nx*Nz), Lz(nx*Ny - ny*Nx);
+			auto L2 = Lx*Lx + Ly*Ly + Lz*Lz;
+			auto cut = ((dA > m) | (dA < mm)) & ((dB > m) | (dB < mm)) & ((dC > m) | (dC < mm)) &
+				((dD > m) | (dD < mm)) & ((dE > m) | (dE < mm)) & ((dF > m) | (dF < mm)) &
+				(L2 > L::set(1.e-12));
+			
+			L lo1, hi1, lo2, hi2;
+			getInterval(Lx*Ax + Ly*Ay + Lz*Az, Lx*Bx + Ly*By + Lz*Bz, Lx*Cx + Ly*Cy + Lz*Cz,
+				dA, dB, dC, lo1, hi1);
+			getInterval(Lx*Dx + Ly*Dy + Lz*Dz, Lx*Ex + Ly*Ey + Lz*Ez, Lx*Fx + Ly*Fy + Lz*Fz,
+				dD, dE, dF, lo2, hi2);
+			auto gap = m * vsqrt(L2);
+			separated = separated | (cut & ((hi1 + gap < lo2) | (hi2 + gap < lo1)));
+			
+			return bits(separated);
+		}
+	}
+	
+	
 	//
 	// Constructor
 	//
@@ -137,20 +346,59 @@ namespace geometry
 	bool intersection<Triangle>::intersect(const UInt & id1, const UInt & id2) const
 	{
 		// Extract vertices of first element
-		auto el1 = grid->getElem(id1); 
-		point3d A(grid->getNode(el1[0]));
-		point3d B(grid->getNode(el1[1]));
-		point3d C(grid->getNode(el1[2]));
+		auto & el1 = grid->getElem(id1); 
+		point3d A(grid->getCoor(el1[0]));
+		point3d B(grid->getCoor(el1[1]));
+		point3d C(grid->getCoor(el1[2]));
 				
 		// Extract vertices of first element
-		auto el2 = grid->getElem(id2); 
-		point3d D(grid->getNode(el2[0]));
-		point3d E(grid->getNode(el2[1]));
-		point3d F(grid->getNode(el2[2]));
+		auto & el2 = grid->getElem(id2); 
+		point3d D(grid->getCoor(el2[0]));
+		point3d E(grid->getCoor(el2[1]));
+		point3d F(grid->getCoor(el2[2]));
 		
 		// Call static interface
 		return ((id1 != id2) && intersection<Triangle>::intersect(A,B,C,D,E,F));
 	}
+	
+	
+	void intersection<Triangle>::intersect(const point3d & A, const point3d & B, const point3d & C,
+		const triangleBatch & batch, vector<uint64_t> & mask)
+	{
+		auto n = batch.size();
+		mask.assign((n + 63) / 64, 0);
+		
+		// Plane of the triangle
+		auto N = ((B - A)^(C - B)).normalize();
+		auto RHS = N*A;
+		
+		// The margin on distances grows with the magnitude of the
+		// coordinates, as the round-off errors of the exact test do
+		Real scale(1.);
+		for (UInt i = 0; i < 3; ++i)
+			scale = max(scale, max(abs(A[i]), max(abs(B[i]), abs(C[i]))));
+		auto margin = 1.e-6 * scale;
+		
+		// Run the exact test on the pairs which have not been discarded
+		auto test = [&](const UInt & k, const UInt width, const unsigned & separated)
+		{
+			for (UInt j = 0; j < width; ++j)
+				if (!(separated & (1u << j)) && intersect(A, B, C, 
+					batch.getVertex(k+j, 0), batch.getVertex(k+j, 1), batch.getVertex(k+j, 2)))
+					mask[(k+j) / 64] |= uint64_t(1) << ((k+j) % 64);
+		};
+		
+		UInt k(0);
+		#if defined(__AVX__)
+		for ( ; k + lane4::width <= n; k += lane4::width)
+			test(k, lane4::width, getSeparated<lane4>(A, B, C, N, RHS, margin, batch, k));
+		#elif defined(__SSE2__)
+		for ( ; k + lane2::width <= n; k += lane2::width)
+			test(k, lane2::width, getSeparated<lane2>(A, B, C, N, RHS, margin, batch, k));
+		#endif
+		for ( ; k < n; ++k)
+			test(k, 1, getSeparated<lane1>(A, B, C, N, RHS, margin, batch, k));
+	}
 }
 
 
@@ -0,0 +1,44 @@
+/*!	\file	memoryReport.cpp
+	\brief	Implementations of members of class memoryReport. */
+
+#include <iomanip>
+
+#include "memoryReport.hpp"
+
+namespace geometry
+{
+	size_t memoryReport::total() const
+	{
+		return nodes + elems + data + node2node + node2elem + data2elem +
+			elem2data + edges + boxes + collapsingSet + Qs + dataOrigin +
+			qoi + cost + log;
+	}
+
+
+	ostream & operator<<(ostream & out, const memoryReport & mr)
+	{
+		auto line = [&out](const string & name, const size_t & bytes)
+		{
+			out << "  " << left << setw(16) << name << right << setw(10)
+				<< bytes / 1024 << " KiB" << endl;
+		};
+
+		line("Nodes", mr.nodes);
+		line("Elements", mr.elems);
+		line("Data", mr.data);
+		line("node2node", mr.node2node);
+		line("node2elem", mr.node2elem);
+		line("data2elem", mr.data2elem);
+		line("elem2data", mr.elem2data);
+		line("Edges", mr.edges);
+		line("Bounding boxes", mr.boxes);
+		line("collapsingSet", mr.collapsingSet);
+		line("Q matrices", mr.Qs);
+		line("dataOrigin", mr.dataOrigin);
+		line("qoi", mr.qoi);
+		line("Cost state", mr.cost);
+		line("Collapse log", mr.log);
+		line("Total", mr.total());
+		return out;
+	}
+}
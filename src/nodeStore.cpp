@@ -0,0 +1,129 @@
+/*!	\file	nodeStore.cpp
+	\brief	Implementations of members of class nodeStore. */
+
+#include "nodeStore.hpp"
+#include "utility.hpp"
+
+// Include implementations of inlined class members
+#ifndef INLINED
+#include "inline/inline_nodeStore.hpp"
+#endif
+
+namespace geometry
+{
+	constexpr uint8_t nodeStore::activeBit;
+
+
+	//
+	// Constructors
+	//
+
+	nodeStore::nodeStore(const vector<point> & nds)
+	{
+		reserve(nds.size());
+		for (auto & p : nds)
+			push_back(p);
+	}
+
+
+	//
+	// Get methods
+	//
+
+	size_t nodeStore::getMemory() const
+	{
+		return sizeof(nodeStore) +
+			(x.capacity() + y.capacity() + z.capacity()) * sizeof(Coord) +
+			flags.capacity() * sizeof(uint8_t);
+	}
+
+
+	vector<point> nodeStore::getNodes() const
+	{
+		vector<point> nds;
+		nds.reserve(size());
+		for (UInt i = 0; i < size(); ++i)
+			nds.push_back((*this)[i]);
+		return nds;
+	}
+
+
+	//
+	// Erase and resize methods
+	//
+
+	void nodeStore::erase(const UInt & Id)
+	{
+		x.erase(x.begin() + Id);
+		y.erase(y.begin() + Id);
+		z.erase(z.begin() + Id);
+		flags.erase(flags.begin() + Id);
+	}
+
+
+	vector<UInt> nodeStore::compact()
+	{
+		vector<UInt> old2new(size(), REMOVED_ID);
+		UInt count(0);
+		for (UInt i = 0; i < size(); ++i)
+			if (isActive(i))
+			{
+				x[count] = x[i];
+				y[count] = y[i];
+				z[count] = z[i];
+				flags[count] = flags[i];
+				old2new[i] = count++;
+			}
+
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+		flags.resize(count);
+		return old2new;
+	}
+
+
+	void nodeStore::permute(const vector<UInt> & old2new)
+	{
+		utility::compact(x, old2new);
+		utility::compact(y, old2new);
+		utility::compact(z, old2new);
+		utility::compact(flags, old2new);
+	}
+
+
+	void nodeStore::clear()
+	{
+		x.clear();
+		y.clear();
+		z.clear();
+		flags.clear();
+	}
+
+
+	void nodeStore::reserve(const UInt & n)
+	{
+		x.reserve(n);
+		y.reserve(n);
+		z.reserve(n);
+		flags.reserve(n);
+	}
+
+
+	void nodeStore::resize(const UInt & n)
+	{
+		x.resize(n, 0.);
+		y.resize(n, 0.);
+		z.resize(n, 0.);
+		flags.resize(n, activeBit);
+	}
+
+
+	void nodeStore::shrinkToFit()
+	{
+		x.shrink_to_fit();
+		y.shrink_to_fit();
+		z.shrink_to_fit();
+		flags.shrink_to_fit();
+	}
+}
@@ -78,7 +78,7 @@ namespace geometry
 	vector<UInt> projection<Triangle>::getNewData2Elem(const UInt & Id, const UInt & pos) const
 	{
 		// Extract the triangle and its vertices
-		auto elem = this->getCPointerToMesh()->getElem(Id);
+		auto & elem = this->getCPointerToMesh()->getElem(Id);
 		
 		//
 		// The point is inside the triangle
@@ -510,52 +510,27 @@ namespace geometry
 	}
 					
 	
-	//
-	// Non-static interface
-	//
-	
-	pair<point3d, vector<UInt>> projection<Triangle>::project
-		(const UInt & datum, const vector<UInt> & elems)
+	vector<tuple<point3d, UInt, UInt>> projection<Triangle>::project(const vector<point3d> & P,
+		const vector<point3d> & A, const vector<point3d> & B, const vector<point3d> & C)
 	{
 		//
-		// Extract data point
-		// 
-		
-		point3d P(this->getCPointerToMesh()->getData(datum));
-		
-		//
-		// Extract triangles
+		// Pre-process triangles
 		//
 		
-		// Declare auxiliary vectors
-		vector<point3d> A, B, C;
 		#ifdef NDEBUG
+			// Declare auxiliary vectors
 			vector<point3d> N;
 			vector<Real> D;
 			vector<UInt> x, y;
-		#endif
-		
-		// Reserve memory
-		A.reserve(elems.size());
-		B.reserve(elems.size());
-		C.reserve(elems.size());
-		#ifdef NDEBUG
-			N.reserve(elems.size());
-			D.reserve(elems.size());
-			x.reserve(elems.size());
-			y.reserve(elems.size());
-		#endif
-		
-		// Get information on each triangle
-		for (UInt i = 0; i < elems.size(); ++i)
-		{
-			auto elem = this->getCPointerToMesh()->getElem(elems[i]);
 			
-			// Extract vertices
-			A.emplace_back(this->getCPointerToMesh()->getNode(elem[0]));
-			B.emplace_back(this->getCPointerToMesh()->getNode(elem[1]));
-			C.emplace_back(this->getCPointerToMesh()->getNode(elem[2]));
-			#ifdef NDEBUG
+			// Reserve memory
+			N.reserve(A.size());
+			D.reserve(A.size());
+			x.reserve(A.size());
+			y.reserve(A.size());
+			
+			for (UInt i = 0; i < A.size(); ++i)
+			{
 				// Extract normal to the plane defined by the triangle
 				// and (signed) distance from the origin
 				N.emplace_back(((B[i] - A[i])^(C[i] - B[i])).normalize());
@@ -565,57 +540,65 @@ namespace geometry
 				auto z = N[i].getMaxCoor();
 				x.emplace_back((z+1) % 3);
 				y.emplace_back((z+2) % 3);
-			#endif
-		}
+			}
+		#endif
 		
 		//
-		// Project the point
+		// Project the points
 		//
 		
-		Real dist, opt_dist(numeric_limits<Real>::max());
-		point3d Q, opt_Q;
-		UInt opt_id(MAX_NUM_ELEMS);
-		UInt pos, opt_pos;
+		vector<tuple<point3d, UInt, UInt>> res;
+		res.reserve(P.size());
 		
-		// Loop over all triangles
-		for (UInt i = 0; i < elems.size(); ++i)
+		// Loop over all points
+		for (UInt j = 0; j < P.size(); ++j)
 		{
-			// Test projection
-			#ifndef NDEBUG
-				tie(dist, Q, pos) = project(P, A[i], B[i], C[i]);
-			#else
-				tie(dist, Q, pos) = project(P, A[i], B[i], C[i], N[i], D[i], x[i], y[i]);
-			#endif
-			
-			// If the projection falls within the triangle,
-			// make sure it is the closest triangle to the point.
-			if (dist < opt_dist)
+			Real dist, opt_dist(numeric_limits<Real>::max());
+			point3d Q, opt_Q;
+			UInt opt_i(MAX_NUM_ELEMS);
+			UInt pos, opt_pos;
+			
+			// For each point, loop over all triangles
+			for (UInt i = 0; i < A.size(); ++i)
 			{
-				opt_dist = dist;
-				opt_Q = Q;
-				opt_id = elems[i];
-				opt_pos = pos;
+				// Test projection
+				#ifndef NDEBUG
+					tie(dist, Q, pos) = project(P[j], A[i], B[i], C[i]);
+				#else
+					tie(dist, Q, pos) = project(P[j], A[i], B[i], C[i], N[i], D[i], x[i], y[i]);
+				#endif
+			
+				// If the projection falls within the triangle,
+				// make sure it is the closest triangle to the point.
+				if (dist < opt_dist)
+				{
+					opt_dist = dist;
+					opt_Q = Q;
+					opt_i = i;
+					opt_pos = pos;
+				}
 			}
-		}
-		
-		// Test if the projection falls within a triangle
-		// (only debug mode)
-		assert(opt_id < MAX_NUM_ELEMS);
-		
-		//
-		// Update connections
-		//
-		
-		// Get new data-element connections
-		auto newData2Elem = getNewData2Elem(opt_id, opt_pos);
 		
-		// Set new data-element connections
-		auto oldData2Elem = this->connectivity.setData2Elem(datum, newData2Elem);
-		
-		// Update data point location
-		this->getPointerToMesh()->setData(datum, opt_Q);
+			// Test if the projection falls within a triangle
+			// (only debug mode)
+			assert(opt_i < MAX_NUM_ELEMS);
+			
+			res.emplace_back(opt_Q, opt_i, opt_pos);
+		}
 		
-		return make_pair(P, oldData2Elem);
+		return res;
+	}
+					
+	
+	//
+	// Non-static interface
+	//
+	
+	pair<point3d, vector<UInt>> projection<Triangle>::project
+		(const UInt & datum, const vector<UInt> & elems)
+	{
+		auto res = project(vector<UInt>{datum}, elems);
+		return res.front();
 	}
 	
 	
@@ -635,101 +618,41 @@ namespace geometry
 		// Extract triangles
 		//
 		
-		// Declare auxiliary vectors
 		vector<point3d> A, B, C;
-		#ifdef NDEBUG
-			vector<point3d> N;
-			vector<Real> D;
-			vector<UInt> x, y;
-		#endif
-		
-		// Reserve memory
 		A.reserve(elems.size());
 		B.reserve(elems.size());
 		C.reserve(elems.size());
-		#ifdef NDEBUG
-			N.reserve(elems.size());
-			D.reserve(elems.size());
-			x.reserve(elems.size());
-			y.reserve(elems.size());
-		#endif
-		
-		// Get information on each triangle
-		for (UInt i = 0; i < elems.size(); ++i)
+		for (auto id : elems)
 		{
-			auto elem = this->getCPointerToMesh()->getElem(elems[i]);
-			
-			// Extract vertices
-			A.emplace_back(this->getCPointerToMesh()->getNode(elem[0]));
-			B.emplace_back(this->getCPointerToMesh()->getNode(elem[1]));
-			C.emplace_back(this->getCPointerToMesh()->getNode(elem[2]));
-			#ifdef NDEBUG
-				// Extract normal to the plane defined by the triangle
-				// and (signed) distance from the origin
-				N.emplace_back(((B[i] - A[i])^(C[i] - B[i])).normalize());
-				D.emplace_back(N[i]*A[i]);
-				
-				// Get the "xy"-plane
-				auto z = N[i].getMaxCoor();
-				x.emplace_back((z+1) % 3);
-				y.emplace_back((z+2) % 3);
-			#endif
+			auto & elem = this->getCPointerToMesh()->getElem(id);
+			A.emplace_back(this->getCPointerToMesh()->getCoor(elem[0]));
+			B.emplace_back(this->getCPointerToMesh()->getCoor(elem[1]));
+			C.emplace_back(this->getCPointerToMesh()->getCoor(elem[2]));
 		}
 		
 		//
 		// Project the points
 		//
 		
+		auto prj = project(P, A, B, C);
+		
+		//
+		// Update connections
+		//
+		
 		vector<pair<point3d, vector<UInt>>> res;
 		res.reserve(data.size());
 		
-		// Loop over all data points
 		for (UInt j = 0; j < data.size(); ++j)
 		{
-			Real dist, opt_dist(numeric_limits<Real>::max());
-			point3d Q, opt_Q;
-			UInt opt_id(MAX_NUM_ELEMS);
-			UInt pos, opt_pos;
-			
-			//
-			// Projection
-			//
-			// For each data point, loop over all triangles
-			for (UInt i = 0; i < elems.size(); ++i)
-			{
-				// Test projection
-				#ifndef NDEBUG
-					tie(dist, Q, pos) = project(P[j], A[i], B[i], C[i]);
-				#else
-					tie(dist, Q, pos) = project(P[j], A[i], B[i], C[i], N[i], D[i], x[i], y[i]);
-				#endif
-			
-				// If the projection falls within the triangle,
-				// make sure it is the closest triangle to the point.
-				if (dist < opt_dist)
-				{
-					opt_dist = dist;
-					opt_Q = Q;
-					opt_id = elems[i];
-					opt_pos = pos;
-				}
-			}
-		
-			// Test if the projection falls within a triangle
-			// (only debug mode)
-			assert(opt_id < MAX_NUM_ELEMS);
-		
-			//
-			// Update connections
-			//
-		
-			auto newData2Elem = getNewData2Elem(opt_id, opt_pos);
+			// Get new data-element connections
+			auto newData2Elem = getNewData2Elem(elems[get<1>(prj[j])], get<2>(prj[j]));
 			
 			// Set new data-element connections
 			auto oldData2Elem = this->connectivity.setData2Elem(data[j], newData2Elem);
 		
 			// Update data point location
-			this->getPointerToMesh()->setData(data[j], opt_Q);
+			this->getPointerToMesh()->setData(data[j], get<0>(prj[j]));
 			
 			// Update output
 			res.emplace_back(P[j], oldData2Elem);
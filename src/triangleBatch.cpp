@@ -0,0 +1,9 @@
+/*!	\file	triangleBatch.cpp
+	\brief	Implementations of members of class triangleBatch. */
+
+#include "triangleBatch.hpp"
+
+// Include definitions of inlined members
+#ifndef INLINED
+#include "inline/inline_triangleBatch.hpp"
+#endif
@@ -0,0 +1,22 @@
+/*!	\file	vertexSplit.cpp
+	\brief	Implementations of members of class vertexSplit. */
+	
+#include "vertexSplit.hpp"
+
+// Include implementations of inlined class members
+#ifndef INLINED
+#include "inline/inline_vertexSplit.hpp"
+#endif
+
+namespace geometry
+{
+	// 
+	// Constructor
+	//
+	
+	vertexSplit::vertexSplit(const UInt & id1, const UInt & id2, const point3d & cp,
+		const vector<UInt> & rmv, const vector<UInt> & rdr) :
+		Id1(id1), Id2(id2), cPoint(cp), toRemove(rmv), toRedirect(rdr)
+	{
+	}
+}
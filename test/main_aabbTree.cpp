@@ -0,0 +1,117 @@
+/*!	\file	main_aabbTree.cpp
+	\brief	A small executable testing and benchmarking the bounding volume
+			hierarchy as search structure for the intersection control.
+
+	For each mesh:
+	<ol>
+	<li> the neighbours of each element are found through the uniform grid
+		 and through the tree, and the two sets are compared;
+	<li> the mesh is simplified in both search modes, and the final
+		 meshes are compared.
+	<\ol> */
+
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Count the mismatching nodes and elements of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+template<MeshType MT>
+UInt compare(const mesh<Triangle,MT> & a, const mesh<Triangle,MT> & b)
+{
+	if ((a.getNumNodes() != b.getNumNodes()) || (a.getNumElems() != b.getNumElems()))
+		return a.getNumNodes() + a.getNumElems();
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumNodes(); ++i)
+		if ((a.getNode(i) - b.getNode(i)).norm2() > 0.)
+			++numMismatch;
+	for (UInt i = 0; i < a.getNumElems(); ++i)
+		for (UInt j = 0; j < 3; ++j)
+			if (a.getElem(i)[j] != b.getElem(i)[j])
+				++numMismatch;
+	return numMismatch;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	vector<pair<string,UInt>> meshes = {{"mesh/pawn.inp", 1000}, {"mesh/bunny.inp", 8000}};
+	for (auto & m : meshes)
+	{
+		cout << m.first << endl;
+
+		//
+		// Neighbours of all elements
+		//
+
+		{
+			bmeshInfo<Triangle, MeshType::GEO> news(m.first);
+			structuredData<Triangle> grid(news), tree(news);
+			tree.setSearchMode(SearchMode::BVH);
+
+			vector<UInt> a, b;
+			UInt numNeighbours(0), numMismatch(0);
+			auto start = high_resolution_clock::now();
+			for (UInt i = 0; i < news.getCPointerToMesh()->getNumElems(); ++i)
+			{
+				grid.getNeighbouringElements(i, a);
+				numNeighbours += a.size();
+			}
+			auto stop = high_resolution_clock::now();
+			cout << "  Grid: " << numNeighbours << " neighbours found in "
+				<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+			numNeighbours = 0;
+			start = high_resolution_clock::now();
+			for (UInt i = 0; i < news.getCPointerToMesh()->getNumElems(); ++i)
+			{
+				tree.getNeighbouringElements(i, b);
+				numNeighbours += b.size();
+			}
+			stop = high_resolution_clock::now();
+			cout << "  Tree: " << numNeighbours << " neighbours found in "
+				<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+			for (UInt i = 0; i < news.getCPointerToMesh()->getNumElems(); ++i)
+			{
+				grid.getNeighbouringElements(i, a);
+				tree.getNeighbouringElements(i, b);
+				sort(a.begin(), a.end());
+				sort(b.begin(), b.end());
+				if (a != b)
+					++numMismatch;
+			}
+			cout << "  Elements with different neighbours: " << numMismatch << endl;
+		}
+
+		//
+		// Simplification
+		//
+
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> withGrid(m.first);
+		auto start = high_resolution_clock::now();
+		withGrid.simplify(m.second, true);
+		auto stop = high_resolution_clock::now();
+		cout << "  Simplification with grid: "
+			<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> withTree(m.first);
+		withTree.setSearchMode(SearchMode::BVH);
+		start = high_resolution_clock::now();
+		withTree.simplify(m.second, true);
+		stop = high_resolution_clock::now();
+		cout << "  Simplification with tree: "
+			<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+		cout << "  Mismatches: "
+			<< compare(*(withGrid.getCPointerToMesh()), *(withTree.getCPointerToMesh())) << endl;
+	}
+}
@@ -0,0 +1,153 @@
+/*!	\file	main_adjacencyMemory.cpp
+	\brief	A small executable comparing the connectivity stored in
+			graphItem's against the same connectivity stored in STL sets,
+			in terms of memory and of time spent in set_intersection(). */
+
+#include <iostream>
+#include <chrono>
+#include <set>
+
+#include "connect.hpp"
+
+using namespace geometry;
+
+/*!	Total number of bytes allocated through any countingAllocator. */
+static size_t allocated(0);
+
+/*!	Allocator keeping track of the bytes allocated by the STL sets. */
+template<typename T>
+struct countingAllocator
+{
+	using value_type = T;
+
+	countingAllocator() = default;
+
+	template<typename U>
+	countingAllocator(const countingAllocator<U> &) {}
+
+	T * allocate(size_t n)
+	{
+		allocated += n * sizeof(T);
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T * p, size_t n)
+	{
+		allocated -= n * sizeof(T);
+		::operator delete(p);
+	}
+};
+
+template<typename T, typename U>
+bool operator==(const countingAllocator<T> &, const countingAllocator<U> &) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const countingAllocator<T> &, const countingAllocator<U> &) { return false; }
+
+/*!	Set of connected Id's, as it used to be. */
+using stlItem = set<UInt, less<UInt>, countingAllocator<UInt>>;
+
+/*!	Layout of a set-based graph item. */
+struct stlGraphItem
+{
+	UInt Id;
+	stlItem conn;
+	bool active;
+};
+
+/*!	Memory used by a list of graph items.
+	\param v	the items
+	\return		number of bytes */
+size_t memory(const vector<graphItem> & v)
+{
+	size_t res(0);
+	for (auto & g : v)
+		res += g.getMemory();
+	return res;
+}
+
+/*!	Memory used by a list of graph items, if they were based on STL sets.
+	\param v	the items
+	\param s	vector to fill with the set-based items
+	\return		number of bytes */
+size_t memory(const vector<graphItem> & v, vector<stlItem> & s)
+{
+	auto before = allocated;
+	s.clear();
+	for (auto & g : v)
+	{
+		auto c = g.getConnected();
+		s.emplace_back(c.cbegin(), c.cend());
+	}
+	// Items plus tree nodes
+	return v.size() * sizeof(stlGraphItem) + allocated - before;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	for (string inputfile : {"mesh/pawn.inp", "mesh/bunny.inp"})
+	{
+		connect<Triangle, MeshType::DATA> conn(inputfile);
+		cout << inputfile << ": " << conn.getPointerToMesh()->getNumNodes() << " nodes, "
+			<< conn.getPointerToMesh()->getNumElems() << " elements" << endl;
+
+		//
+		// Memory
+		//
+
+		vector<stlItem> node2elem;
+		size_t stlBytes(0), flatBytes(0);
+		{
+			vector<stlItem> s;
+			stlBytes += memory(conn.getNode2Node(), s);
+			stlBytes += memory(conn.getNode2Elem(), node2elem);
+			stlBytes += memory(conn.getData2Elem(), s);
+			stlBytes += memory(conn.getElem2Data(), s);
+		}
+		flatBytes += memory(conn.getNode2Node());
+		flatBytes += memory(conn.getNode2Elem());
+		flatBytes += memory(conn.getData2Elem());
+		flatBytes += memory(conn.getElem2Data());
+
+		cout << "  Connectivity with STL sets: " << stlBytes / 1024 << " KiB" << endl;
+		cout << "  Connectivity with flat sets: " << flatBytes / 1024 << " KiB" << endl;
+
+		//
+		// Elements on edges
+		//
+
+		auto edges = conn.getEdges();
+		auto items = conn.getNode2Elem();
+		UInt numRepeat(20), sumStl(0), sumFlat(0);
+
+		auto start = high_resolution_clock::now();
+		for (UInt r = 0; r < numRepeat; ++r)
+			for (auto & edge : edges)
+			{
+				auto & s1 = node2elem[edge[0]];
+				auto & s2 = node2elem[edge[1]];
+				set<UInt> res;
+				set_intersection(s1.cbegin(), s1.cend(), s2.cbegin(), s2.cend(), inserter(res, res.end()));
+				sumStl += res.size();
+			}
+		auto stop = high_resolution_clock::now();
+		cout << "  set_intersection with STL sets: "
+			<< duration_cast<microseconds>(stop-start).count() / numRepeat << " us" << endl;
+
+		start = high_resolution_clock::now();
+		vector<UInt> v;
+		for (UInt r = 0; r < numRepeat; ++r)
+			for (auto & edge : edges)
+			{
+				set_intersection(items[edge[0]], items[edge[1]], v);
+				sumFlat += v.size();
+			}
+		stop = high_resolution_clock::now();
+		cout << "  set_intersection with flat sets: "
+			<< duration_cast<microseconds>(stop-start).count() / numRepeat << " us" << endl;
+
+		cout << "  Same elements on edges: " << (sumStl == sumFlat ? "yes" : "no") << endl;
+	}
+}
@@ -0,0 +1,118 @@
+/*!	\file	main_autoTuning.cpp
+	\brief	A small executable testing and benchmarking the auto-tuning
+			of the cell size of the structured data.
+
+	For each mesh:
+	<ol>
+	<li> the neighbours of each element are found through the default
+		 grid and through the tuned grid, and the two sets are compared;
+	<li> the mesh is simplified with both grids, and the final
+		 meshes are compared.
+	<\ol>
+	The number of re-bins and the average number of elements examined
+	by each query are printed. */
+
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Count the mismatching nodes and elements of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+template<MeshType MT>
+UInt compare(const mesh<Triangle,MT> & a, const mesh<Triangle,MT> & b)
+{
+	if ((a.getNumNodes() != b.getNumNodes()) || (a.getNumElems() != b.getNumElems()))
+		return a.getNumNodes() + a.getNumElems();
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumNodes(); ++i)
+		if ((a.getNode(i) - b.getNode(i)).norm2() > 0.)
+			++numMismatch;
+	for (UInt i = 0; i < a.getNumElems(); ++i)
+		for (UInt j = 0; j < 3; ++j)
+			if (a.getElem(i)[j] != b.getElem(i)[j])
+				++numMismatch;
+	return numMismatch;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	vector<pair<string,UInt>> meshes = {{"mesh/pawn.inp", 1000}, {"mesh/bunny.inp", 8000}};
+	for (auto & m : meshes)
+	{
+		cout << m.first << endl;
+
+		//
+		// Neighbours of all elements
+		//
+
+		{
+			bmeshInfo<Triangle, MeshType::GEO> news(m.first);
+			structuredData<Triangle> fixed(news), tuned(news);
+			tuned.setAutoTuning(true);
+			cout << "  Tuned grid: " << tuned.getCartesianGrid().getTotalNumCells() << " cells (default: "
+				<< fixed.getCartesianGrid().getTotalNumCells() << "), occupancy " << tuned.getOccupancy()
+				<< ", " << tuned.getNumOversized() << " elements larger than the cells" << endl;
+
+			vector<UInt> a, b;
+			UInt numNeighbours(0), numMismatch(0);
+			for (auto sd : {&fixed, &tuned})
+			{
+				numNeighbours = 0;
+				sd->resetStatistics();
+				auto start = high_resolution_clock::now();
+				for (UInt i = 0; i < news.getCPointerToMesh()->getNumElems(); ++i)
+				{
+					sd->getNeighbouringElements(i, a);
+					numNeighbours += a.size();
+				}
+				auto stop = high_resolution_clock::now();
+				cout << "  " << (sd == &fixed ? "Default" : "Tuned") << ": " << numNeighbours
+					<< " neighbours found in " << duration_cast<milliseconds>(stop-start).count()
+					<< " ms, examining " << static_cast<Real>(sd->getNumCandidates()) / sd->getNumQueries()
+					<< " elements per query" << endl;
+			}
+
+			for (UInt i = 0; i < news.getCPointerToMesh()->getNumElems(); ++i)
+			{
+				fixed.getNeighbouringElements(i, a);
+				tuned.getNeighbouringElements(i, b);
+				sort(a.begin(), a.end());
+				sort(b.begin(), b.end());
+				if (a != b)
+					++numMismatch;
+			}
+			cout << "  Elements with different neighbours: " << numMismatch << endl;
+		}
+
+		//
+		// Simplification
+		//
+
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> withFixed(m.first);
+		auto start = high_resolution_clock::now();
+		withFixed.simplify(m.second, true);
+		auto stop = high_resolution_clock::now();
+		cout << "  Simplification with default grid: "
+			<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> withTuned(m.first);
+		withTuned.setAutoTuning(true);
+		start = high_resolution_clock::now();
+		withTuned.simplify(m.second, true);
+		stop = high_resolution_clock::now();
+		cout << "  Simplification with tuned grid: "
+			<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+		cout << "  Mismatches: "
+			<< compare(*(withFixed.getCPointerToMesh()), *(withTuned.getCPointerToMesh())) << endl;
+	}
+}
@@ -4,6 +4,7 @@
 #include <chrono>
 
 #include "boundingBox.hpp"
+#include "cartesianGrid.hpp"
 #include "meshInfo.hpp"
 
 int main()
@@ -12,7 +13,7 @@ int main()
 	using namespace std::chrono;
 	
 	//
-	// Import mesh and set static attributes
+	// Import mesh and build the Cartesian grid
 	//
 		
 	#ifdef NDEBUG
@@ -21,7 +22,8 @@ int main()
 	#endif
 	
 	string inputfile("mesh/bunny.inp");
-	bbox3d::setup(bmeshInfo<Triangle, MeshType::DATA>(inputfile));
+	bmeshInfo<Triangle, MeshType::DATA> news(inputfile);
+	cartesianGrid cg(news);
 	
 	#ifdef NDEBUG
 	stop = high_resolution_clock::now();
@@ -30,14 +32,14 @@ int main()
 	#endif
 	
 	#ifndef NDEBUG
-	cout << "North-East: " << bbox3d::getGlobalNE() << endl
-		<< "South-West: " << bbox3d::getGlobalSW() << endl
-		<< "dx = " << bbox3d::getCellSize(0) 
-		<< ", dy = " << bbox3d::getCellSize(1) 
-		<< ", dz = " << bbox3d::getCellSize(2) << endl
-		<< "Nx = " << bbox3d::getNumCells(0) 
-		<< ", Ny = " << bbox3d::getNumCells(1) 
-		<< ", Nz = " << bbox3d::getNumCells(2) << endl << endl;
+	cout << "North-East: " << cg.getNE() << endl
+		<< "South-West: " << cg.getSW() << endl
+		<< "dx = " << cg.getCellSize(0) 
+		<< ", dy = " << cg.getCellSize(1) 
+		<< ", dz = " << cg.getCellSize(2) << endl
+		<< "Nx = " << cg.getNumCells(0) 
+		<< ", Ny = " << cg.getNumCells(1) 
+		<< ", Nz = " << cg.getNumCells(2) << endl << endl;
 	#endif
 	
 	//
@@ -51,6 +53,7 @@ int main()
 		point3d D(4,6,0);
 		
 		bbox3d bb(A,B,C,D);
+		bb.setIdx(cg.getIdx(bb));
 		cout << bb << endl;
 	}
 }
@@ -0,0 +1,118 @@
+/*!	\file	main_checkpoint.cpp
+	\brief	A small executable testing the checkpoint and resume of a
+			simplification process.
+
+	A mesh is simplified while writing a checkpoint midway; then the
+	process is resumed from the checkpoint and the final mesh is compared
+	with the outcome of the uninterrupted run. This is done both for a mesh
+	with distributed data and the greedy scheduler, and for a purely
+	geometric mesh and the multiple-choice scheduler. */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Count the mismatching nodes and elements of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+template<MeshType MT>
+UInt compare(const mesh<Triangle,MT> & a, const mesh<Triangle,MT> & b)
+{
+	if ((a.getNumNodes() != b.getNumNodes()) || (a.getNumElems() != b.getNumElems()))
+		return a.getNumNodes() + a.getNumElems();
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumNodes(); ++i)
+		if ((a.getNode(i) - b.getNode(i)).norm2() > 0.)
+			++numMismatch;
+	for (UInt i = 0; i < a.getNumElems(); ++i)
+		for (UInt j = 0; j < 3; ++j)
+			if (a.getElem(i)[j] != b.getElem(i)[j])
+				++numMismatch;
+	return numMismatch;
+}
+
+/*!	Count the mismatching data points of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+UInt compareData(const mesh<Triangle, MeshType::DATA> & a, const mesh<Triangle, MeshType::DATA> & b)
+{
+	if (a.getNumData() != b.getNumData())
+		return a.getNumData();
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumData(); ++i)
+		if ((a.getData(i) - b.getData(i)).norm2() > 0.)
+			++numMismatch;
+	return numMismatch;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	// File to mesh and checkpoint
+	string inputfile("mesh/pawn.inp");
+	string checkpointfile("main_checkpoint.chk");
+
+	//
+	// Mesh with distributed data, greedy scheduler
+	//
+
+	{
+		UInt numNodes(2000), step(300);
+
+		// Uninterrupted run, writing a checkpoint at 2222 nodes
+		simplification<Triangle, MeshType::DATA, DataGeo> full(inputfile);
+		full.setCheckpoint(checkpointfile, step);
+		auto start = high_resolution_clock::now();
+		full.simplify(numNodes, true);
+		auto stop = high_resolution_clock::now();
+		cout << "Uninterrupted run: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+		// Resume from the checkpoint
+		start = high_resolution_clock::now();
+		ifstream in(checkpointfile, ios::binary);
+		simplification<Triangle, MeshType::DATA, DataGeo> resumed(in);
+		in.close();
+		cout << "Nodes in the checkpoint: " << resumed.getCPointerToMesh()->getNumNodes() << endl;
+		resumed.simplify(numNodes, true);
+		stop = high_resolution_clock::now();
+		cout << "Resumed run: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+		auto a = full.getCPointerToMesh();
+		auto b = resumed.getCPointerToMesh();
+		cout << "Mismatches (DataGeo): " << compare(*a, *b) + compareData(*a, *b) << endl;
+	}
+
+	//
+	// Purely geometric mesh, multiple-choice scheduler
+	//
+
+	{
+		UInt numNodes(1000), step(700);
+
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> full(inputfile);
+		full.setMultipleChoice(8, 1);
+		full.setCheckpoint(checkpointfile, step);
+		full.simplify(numNodes, true);
+
+		ifstream in(checkpointfile, ios::binary);
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> resumed(in);
+		in.close();
+		cout << "Nodes in the checkpoint: " << resumed.getCPointerToMesh()->getNumNodes() << endl;
+		resumed.simplify(numNodes, true);
+
+		cout << "Mismatches (multiple-choice): "
+			<< compare(*(full.getCPointerToMesh()), *(resumed.getCPointerToMesh())) << endl;
+	}
+
+	remove(checkpointfile.c_str());
+}
@@ -85,7 +85,7 @@ int main()
 		#endif
 		
 		#ifndef NDEBUG
-		auto nc = bbox3d::getNumCells();
+		auto nc = sdata.getCartesianGrid().getNumCells();
 		cout << "Number of cells: " << nc[0] << " " << nc[1] << " " << nc[2] << endl;
 		#endif
 				
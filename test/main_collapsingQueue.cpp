@@ -0,0 +1,71 @@
+/*!	\file	main_collapsingQueue.cpp
+	\brief	Small executable to test the priority queue of collapsing edges
+			in both addressable and lazy mode, including re-keying
+			from the cost components. */
+
+#include <iostream>
+
+#include "collapsingQueue.hpp"
+
+using namespace geometry;
+
+int main()
+{
+	for (auto qm : {QueueMode::ADDRESSABLE, QueueMode::LAZY})
+	{
+		cout << (qm == QueueMode::ADDRESSABLE ? "Addressable" : "Lazy") << " mode" << endl;
+
+		// The set of edges giving the handles, as the connectivity does
+		edgeTable edges;
+		for (UInt i = 0; i < 6; ++i)
+			edges.insert(i, i+1);
+
+		// Fill the queue
+		collapsingQueue cQueue(&edges, qm);
+		cQueue.emplace(0, 1, 3.);
+		cQueue.emplace(1, 2, 1.);
+		cQueue.emplace(2, 3, 5.);
+		cQueue.emplace(3, 4, 2.);
+		cQueue.emplace(4, 5, 4.);
+		cQueue.emplace(5, 6, 2.);
+
+		// Decrease-key, increase-key and erase, also with swapped end-points
+		cQueue.emplace(5, 4, 0.5);
+		cQueue.emplace(2, 1, 6.);
+		cout << "Erased edge (2,3): " << cQueue.erase(3, 2) << endl;
+		cout << "Edge (2,3) still in the queue: " << cQueue.find(2, 3) << endl;
+		cout << "Edges in the queue: " << cQueue.size()
+			<< ", entries in the heap: " << cQueue.getHeapSize() << endl;
+
+		// Apply an old-to-new map
+		vector<UInt> old2new{0, 1, 2, 3, 10, 11, 12};
+		edges.refresh(old2new);
+		cQueue.refresh(old2new);
+
+		// Extract the edges in ascending order of cost
+		while (!cQueue.empty())
+		{
+			auto cEdge = cQueue.top();
+			cout << "(" << cEdge.getId1() << "," << cEdge.getId2() << ") cost "
+				<< cEdge.getCost() << endl;
+			cQueue.pop();
+		}
+
+		// Re-key the queue from the cost components, after a
+		// change in their normalization
+		cQueue.emplace(0, 1, 1., {0.,0.,0.}, {{1., 4., 0.}});
+		cQueue.emplace(1, 2, 2., {0.,0.,0.}, {{2., 1., 0.}});
+		cQueue.emplace(2, 3, 3., {0.,0.,0.}, {{3., 2., 0.}});
+		cQueue.erase(1, 2);
+		cQueue.rekey([](const collapsingEdge & cEdge)
+			{ return cEdge.getComponents()[0] + cEdge.getComponents()[1]; });
+		cout << "After re-keying:" << endl;
+		while (!cQueue.empty())
+		{
+			auto cEdge = cQueue.top();
+			cout << "(" << cEdge.getId1() << "," << cEdge.getId2() << ") cost "
+				<< cEdge.getCost() << endl;
+			cQueue.pop();
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/*!	\file	main_concurrent.cpp
+	\brief	A small executable testing simplifications of different
+			meshes running at the same time in one process.
+
+	Two meshes are simplified one after the other, then simultaneously on
+	two threads. Since each simplification owns the Cartesian grid of its
+	structured data, the concurrent runs should yield the same meshes as the
+	sequential ones. */
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Count the mismatching nodes and elements of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+template<MeshType MT>
+UInt compare(const mesh<Triangle,MT> & a, const mesh<Triangle,MT> & b)
+{
+	if ((a.getNumNodes() != b.getNumNodes()) || (a.getNumElems() != b.getNumElems()))
+		return a.getNumNodes() + a.getNumElems();
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumNodes(); ++i)
+		if ((a.getNode(i) - b.getNode(i)).norm2() > 0.)
+			++numMismatch;
+	for (UInt i = 0; i < a.getNumElems(); ++i)
+		for (UInt j = 0; j < 3; ++j)
+			if (a.getElem(i)[j] != b.getElem(i)[j])
+				++numMismatch;
+	return numMismatch;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	// Meshes to simplify and final number of nodes
+	string file1("mesh/pawn.inp"), file2("mesh/cow.inp");
+	UInt numNodes1(1500), numNodes2(1500);
+
+	//
+	// Sequential runs
+	//
+
+	auto start = high_resolution_clock::now();
+	simplification<Triangle, MeshType::DATA, DataGeo> seq1(file1);
+	seq1.simplify(numNodes1, true);
+	simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> seq2(file2);
+	seq2.simplify(numNodes2, true);
+	auto stop = high_resolution_clock::now();
+	cout << "Sequential runs: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	//
+	// Concurrent runs
+	//
+
+	start = high_resolution_clock::now();
+	simplification<Triangle, MeshType::DATA, DataGeo> con1(file1);
+	simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> con2(file2);
+	thread t1([&](){ con1.simplify(numNodes1, true); });
+	thread t2([&](){ con2.simplify(numNodes2, true); });
+	t1.join();
+	t2.join();
+	stop = high_resolution_clock::now();
+	cout << "Concurrent runs: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	cout << "Mismatches (" << file1 << "): "
+		<< compare(*(seq1.getCPointerToMesh()), *(con1.getCPointerToMesh())) << endl;
+	cout << "Mismatches (" << file2 << "): "
+		<< compare(*(seq2.getCPointerToMesh()), *(con2.getCPointerToMesh())) << endl;
+}
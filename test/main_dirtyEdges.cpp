@@ -0,0 +1,70 @@
+/*!	\file	main_dirtyEdges.cpp
+	\brief	A small executable running the simplification process on a
+			purely geometric mesh and on a mesh with distributed data,
+			and reporting the number of edge costs re-computed after the
+			collapses and the re-computations saved with respect to
+			re-computing all the edges around the collapsing node.
+
+	The process is stopped at a few intermediate sizes, where the
+	queue is compared with a full re-computation of the costs over
+	all the edges of the mesh. Stale edges should be rare: the edges
+	re-computed are those around the elements close to the patch, while
+	the trial collapse of an edge may move its own patch farther. */
+
+#include <iostream>
+#include <chrono>
+
+#include "simplification.hpp"
+
+namespace geometry
+{
+	/*!	Simplify a mesh down to a fraction of its nodes, halving the
+		number of nodes at each step, and check the queue after each step.
+		\param simplifier	the simplification object
+		\param name			name of the cost class, to print
+		\param numSteps		number of steps */
+	template<MeshType MT, typename CostClass>
+	void run(simplification<Triangle,MT,CostClass> & simplifier, const string & name,
+		const UInt & numSteps)
+	{
+		using namespace std::chrono;
+
+		simplifier.setRingStatistics(true);
+		UInt numRecomputations(0);
+		long numSaved(0);
+		milliseconds::rep time(0);
+		for (UInt step = 0; step < numSteps; ++step)
+		{
+			auto start = high_resolution_clock::now();
+			simplifier.simplify(simplifier.getCPointerToMesh()->getNumNodes() / 2, true);
+			auto stop = high_resolution_clock::now();
+			time += duration_cast<milliseconds>(stop-start).count();
+			numRecomputations += simplifier.getNumRecomputations();
+			numSaved += simplifier.getNumSavedRecomputations();
+
+			cout << name << ": " << simplifier.getCPointerToMesh()->getNumNodes()
+				<< " nodes, " << simplifier.getNumStaleEdges() << " stale edges" << endl;
+		}
+
+		cout << name << ": " << numRecomputations << " re-computations, "
+			<< numSaved << " saved, " << time << " ms" << endl;
+	}
+}
+
+int main()
+{
+	using namespace geometry;
+
+	for (string inputfile : {"mesh/brain.inp", "mesh/bunny.inp"})
+	{
+		cout << inputfile << endl;
+
+		// Purely geometric mesh
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> geo(inputfile);
+		run(geo, "OnlyGeo", 2);
+
+		// Mesh with distributed data
+		simplification<Triangle, MeshType::DATA, DataGeo> data(inputfile);
+		run(data, "DataGeo", 2);
+	}
+}
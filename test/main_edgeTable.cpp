@@ -0,0 +1,196 @@
+/*!	\file	main_edgeTable.cpp
+	\brief	A small executable testing class edgeTable against an
+			unordered_map keyed by the pair of end-points.
+
+	The edges of a mesh are inserted both in an edgeTable and in an
+	unordered_map storing the handles. Then, a random sequence of
+	insertions, erasures and lookups is applied to both, checking that
+	handles are stable and recycled. Finally, the table is re-numbered
+	as after a refresh of the mesh. Memory and time are reported. */
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+
+#include "connect.hpp"
+#include "hash.hpp"
+
+using namespace geometry;
+
+int main()
+{
+	using namespace std::chrono;
+
+	for (string inputfile : {"mesh/pawn.inp", "mesh/bunny.inp"})
+	{
+		connect<Triangle, MeshType::GEO> conn(inputfile);
+		auto edges = conn.getEdges();
+		auto numNodes = conn.getPointerToMesh()->getNumNodes();
+		cout << inputfile << ": " << numNodes << " nodes, " << edges.size() << " edges" << endl;
+
+		//
+		// Insertion
+		//
+
+		edgeTable table;
+		unordered_map<pair<UInt,UInt>,UInt> map;
+
+		auto start = high_resolution_clock::now();
+		for (auto & edge : edges)
+			table.insert(edge[1], edge[0]);
+		auto stop = high_resolution_clock::now();
+		cout << "  Insertion in the table: "
+			<< duration_cast<microseconds>(stop-start).count() << " us" << endl;
+
+		start = high_resolution_clock::now();
+		for (auto & edge : edges)
+			map.emplace(make_pair(edge[0], edge[1]), map.size());
+		stop = high_resolution_clock::now();
+		cout << "  Insertion in the map: "
+			<< duration_cast<microseconds>(stop-start).count() << " us" << endl;
+
+		// The handles of the edges of a connect coincide with their Id's
+		UInt numMismatch(0);
+		for (auto & edge : edges)
+			if ((table.find(edge[0], edge[1]) != edge.getId()) ||
+				(map[make_pair(edge[0], edge[1])] != edge.getId()))
+				++numMismatch;
+
+		size_t mapBytes(sizeof(map) + map.bucket_count() * sizeof(void*) +
+			map.size() * (sizeof(pair<pair<UInt,UInt>,UInt>) + 2 * sizeof(void*)));
+		cout << "  Table: " << table.getMemory() / 1024 << " KiB" << endl;
+		cout << "  Map (estimated): " << mapBytes / 1024 << " KiB" << endl;
+
+		//
+		// Random insertions, erasures and lookups
+		//
+
+		default_random_engine gen(0);
+		uniform_int_distribution<UInt> node(0, numNodes - 1);
+		uniform_int_distribution<UInt> op(0, 2);
+		vector<UInt> freeHandles;
+		UInt numHandles(edges.size()), numOps(10*edges.size());
+
+		for (UInt i = 0; i < numOps; ++i)
+		{
+			auto id1(node(gen)), id2(node(gen));
+			if (id1 == id2)
+				continue;
+			auto key = make_pair(min(id1,id2), max(id1,id2));
+			auto it = map.find(key);
+
+			switch (op(gen))
+			{
+				case 0:
+				{
+					// Insert: the handle of an erased edge is recycled
+					auto h = table.insert(id1, id2);
+					if (it == map.end())
+					{
+						UInt expected(numHandles);
+						if (freeHandles.empty())
+							++numHandles;
+						else
+						{
+							expected = freeHandles.back();
+							freeHandles.pop_back();
+						}
+						map.emplace(key, expected);
+						numMismatch += (!h.second || (h.first != expected));
+					}
+					else
+						numMismatch += (h.second || (h.first != it->second));
+					break;
+				}
+				case 1:
+				{
+					// Erase
+					auto h = table.erase(id1, id2);
+					if (it == map.end())
+						numMismatch += (h != edgeTable::none);
+					else
+					{
+						numMismatch += (h != it->second);
+						freeHandles.push_back(it->second);
+						map.erase(it);
+					}
+					break;
+				}
+				default:
+				{
+					// Lookup
+					auto h = table.find(id1, id2);
+					numMismatch += (it == map.end()) ? (h != edgeTable::none) : (h != it->second);
+				}
+			}
+		}
+
+		// Check all edges and their end-points
+		numMismatch += (table.size() != map.size());
+		for (auto & e : map)
+		{
+			auto h = table.find(e.first.first, e.first.second);
+			numMismatch += (h != e.second);
+			numMismatch += !table.isValid(h) || (table.getEnds(h)[0] != e.first.first) ||
+				(table.getEnds(h)[1] != e.first.second);
+		}
+
+		//
+		// Lookups
+		//
+
+		UInt numFound(0);
+		start = high_resolution_clock::now();
+		for (UInt r = 0; r < 10; ++r)
+			for (auto & edge : edges)
+				numFound += (table.find(edge[0], edge[1]) != edgeTable::none);
+		stop = high_resolution_clock::now();
+		cout << "  Lookups in the table: "
+			<< duration_cast<microseconds>(stop-start).count() << " us"
+			<< " (" << numFound << " found)" << endl;
+
+		numFound = 0;
+		start = high_resolution_clock::now();
+		for (UInt r = 0; r < 10; ++r)
+			for (auto & edge : edges)
+				numFound += (map.find(make_pair(edge[0], edge[1])) != map.end());
+		stop = high_resolution_clock::now();
+		cout << "  Lookups in the map: "
+			<< duration_cast<microseconds>(stop-start).count() << " us"
+			<< " (" << numFound << " found)" << endl;
+
+		//
+		// Re-numbering
+		//
+		// Remove one node out of ten, as a refresh of the mesh would do,
+		// and check that the surviving edges get dense handles, in the
+		// same order as the old ones
+
+		vector<UInt> old2new(numNodes, REMOVED_ID);
+		for (UInt id = 0, newId = 0; id < numNodes; ++id)
+			if (id % 10)
+				old2new[id] = newId++;
+
+		auto handles = table.refresh(old2new);
+		UInt numKept(0), last(0);
+		for (auto & e : map)
+		{
+			auto h = handles[e.second];
+			auto id1(old2new[e.first.first]), id2(old2new[e.first.second]);
+			if ((id1 == REMOVED_ID) || (id2 == REMOVED_ID))
+				numMismatch += (h != edgeTable::none);
+			else
+			{
+				++numKept;
+				numMismatch += (h == edgeTable::none) || (table.find(id1, id2) != h);
+			}
+		}
+		for (auto h : handles)
+			if (h != edgeTable::none)
+				numMismatch += (h != last++);
+		numMismatch += (table.size() != numKept) || (table.getNumHandles() != numKept);
+
+		cout << "  Mismatches: " << numMismatch << endl;
+	}
+}
@@ -0,0 +1,104 @@
+/*!	\file	main_intersectionBatch.cpp
+	\brief	A small executable testing and benchmarking the test for
+			intersections between a triangle and a batch of triangles.
+
+	For each element of the mesh, the neighbouring elements are gathered
+	in a batch and tested against the element itself, as well as against
+	the element with its first vertex moved along the normal, so to
+	produce some intersections. The results of the batch test are
+	compared with those of the pairwise test, and the timings of the
+	two approaches are printed. */
+
+#include <iostream>
+#include <chrono>
+
+#include "bmeshInfo.hpp"
+#include "structuredData.hpp"
+#include "intersection.hpp"
+
+using namespace geometry;
+
+int main()
+{
+	using namespace std::chrono;
+
+	bmeshInfo<Triangle, MeshType::GEO> news("mesh/brain.inp");
+	structuredData<Triangle> sd(news);
+	auto grid = news.getCPointerToMesh();
+
+	//
+	// Build the tests
+	//
+
+	vector<array<point3d,3>> refs;
+	vector<triangleBatch> batches;
+	vector<UInt> elems;
+	for (UInt i = 0; i < grid->getNumElems(); ++i)
+	{
+		auto & v = grid->getElem(i);
+		array<point3d,3> ref = {grid->getCoor(v[0]), grid->getCoor(v[1]), grid->getCoor(v[2])};
+
+		triangleBatch batch;
+		sd.getNeighbouringElements(i, elems);
+		for (auto elem : elems)
+			if (elem != i)
+			{
+				auto & w = grid->getElem(elem);
+				batch.push_back(grid->getCoor(w[0]), grid->getCoor(w[1]), grid->getCoor(w[2]));
+			}
+
+		refs.push_back(ref);
+		batches.push_back(batch);
+		ref[0] = ref[0] + 0.5 * sqrt(news.getTriArea(i)) * news.getNormal(i);
+		refs.push_back(ref);
+		batches.push_back(batch);
+	}
+
+	//
+	// Pairwise test
+	//
+
+	UInt numPairs(0), numPairwise(0);
+	auto start = high_resolution_clock::now();
+	for (UInt t = 0; t < refs.size(); ++t)
+	{
+		auto & r = refs[t];
+		auto & b = batches[t];
+		for (UInt k = 0; k < b.size(); ++k)
+			if (intersection<Triangle>::intersect(r[0], r[1], r[2],
+				b.getVertex(k,0), b.getVertex(k,1), b.getVertex(k,2)))
+				++numPairwise;
+		numPairs += b.size();
+	}
+	auto stop = high_resolution_clock::now();
+	cout << "Pairwise test: " << numPairwise << " intersections out of " << numPairs
+		<< " pairs found in " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	//
+	// Batch test
+	//
+
+	vector<vector<uint64_t>> masks(refs.size());
+	start = high_resolution_clock::now();
+	for (UInt t = 0; t < refs.size(); ++t)
+		intersection<Triangle>::intersect(refs[t][0], refs[t][1], refs[t][2], batches[t], masks[t]);
+	stop = high_resolution_clock::now();
+
+	UInt numBatch(0), numMismatch(0);
+	for (UInt t = 0; t < refs.size(); ++t)
+	{
+		auto & r = refs[t];
+		auto & b = batches[t];
+		for (UInt k = 0; k < b.size(); ++k)
+		{
+			bool res = masks[t][k / 64] & (uint64_t(1) << (k % 64));
+			numBatch += res;
+			if (res != intersection<Triangle>::intersect(r[0], r[1], r[2],
+				b.getVertex(k,0), b.getVertex(k,1), b.getVertex(k,2)))
+				++numMismatch;
+		}
+	}
+	cout << "Batch test: " << numBatch << " intersections out of " << numPairs
+		<< " pairs found in " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+	cout << "Mismatches: " << numMismatch << endl;
+}
@@ -0,0 +1,80 @@
+/*!	\file	main_memoryBudget.cpp
+	\brief	A small executable testing the memory report and the
+			memory-budgeted simplification.
+
+	A mesh is simplified twice, with and without a memory cap. With
+	the cap, the mesh is compacted along the process; the final meshes
+	are compared, and the memory occupied by each component before and
+	after the simplification is reported. This is done both for a purely
+	geometric mesh and for a mesh with distributed data. */
+
+#include <iostream>
+#include <chrono>
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Count the mismatching nodes and elements of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+template<MeshType MT>
+UInt compare(const mesh<Triangle,MT> & a, const mesh<Triangle,MT> & b)
+{
+	if ((a.getNumNodes() != b.getNumNodes()) || (a.getNumElems() != b.getNumElems()))
+		return a.getNumNodes() + a.getNumElems();
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumNodes(); ++i)
+		if ((a.getNode(i) - b.getNode(i)).norm2() > 0.)
+			++numMismatch;
+	for (UInt i = 0; i < a.getNumElems(); ++i)
+		for (UInt j = 0; j < 3; ++j)
+			if (a.getElem(i)[j] != b.getElem(i)[j])
+				++numMismatch;
+	return numMismatch;
+}
+
+/*!	Simplify a mesh with and without a memory cap and compare.
+	\param inputfile	path to the mesh
+	\param numNodes		target number of nodes */
+template<MeshType MT, typename CostClass>
+void run(const string & inputfile, const UInt & numNodes)
+{
+	using namespace std::chrono;
+
+	// Without cap; the queue is built upfront, so to
+	// account for it in the memory before the simplification
+	simplification<Triangle, MT, CostClass> free(inputfile);
+	free.setupCollapsingSet();
+	auto before = free.memoryUsage();
+	cout << "Before the simplification:" << endl << before;
+	auto start = high_resolution_clock::now();
+	free.simplify(numNodes, true);
+	auto stop = high_resolution_clock::now();
+	cout << "Without cap: " << duration_cast<milliseconds>(stop-start).count()
+		<< " ms" << endl << free.memoryUsage();
+
+	// With a cap at three quarters of the initial memory
+	simplification<Triangle, MT, CostClass> capped(inputfile);
+	capped.setMemoryBudget(3 * before.total() / 4, 200);
+	start = high_resolution_clock::now();
+	capped.simplify(numNodes, true);
+	stop = high_resolution_clock::now();
+	cout << "With cap: " << duration_cast<milliseconds>(stop-start).count()
+		<< " ms, " << capped.getNumCompactions() << " compactions" << endl
+		<< capped.memoryUsage();
+
+	cout << "Mismatches: " << compare(*(free.getCPointerToMesh()),
+		*(capped.getCPointerToMesh())) << endl;
+}
+
+int main()
+{
+	cout << "Purely geometric mesh" << endl;
+	run<MeshType::GEO, OnlyGeo<MeshType::GEO>>("mesh/pawn.inp", 500);
+
+	cout << endl << "Mesh with distributed data" << endl;
+	run<MeshType::DATA, DataGeo>("mesh/pawn.inp", 1000);
+}
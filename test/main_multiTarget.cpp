@@ -0,0 +1,74 @@
+/*!	\file	main_multiTarget.cpp
+	\brief	A small executable testing the simplification towards several
+			targets in a single pass.
+
+	A purely geometric mesh is simplified towards two targets at once,
+	then the snapshot printed for the intermediate target is compared
+	with the outcome of a separate run. */
+
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+
+#include "simplification.hpp"
+
+int main()
+{
+	using namespace geometry;
+	using namespace std::chrono;
+
+	// File to mesh
+	string inputfile("mesh/pawn.inp");
+
+	// Output file and targets
+	string outputfile("main_multiTarget.inp");
+	UInt numNodesSnapshot(2000), numNodes(1500);
+
+	//
+	// Single pass
+	//
+
+	simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> multi(inputfile);
+	auto start = high_resolution_clock::now();
+	multi.simplify({numNodesSnapshot, numNodes}, true, outputfile);
+	auto stop = high_resolution_clock::now();
+	cout << "Single pass: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	//
+	// Separate run for the intermediate target
+	//
+
+	simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> single(inputfile);
+	start = high_resolution_clock::now();
+	single.simplify(numNodesSnapshot, true);
+	stop = high_resolution_clock::now();
+	cout << "Separate run: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	//
+	// Compare
+	//
+
+	mesh<Triangle, MeshType::GEO> snapshot("main_multiTarget_2000.inp");
+	auto grid = single.getCPointerToMesh();
+	UInt numMismatch(0);
+	if ((snapshot.getNumNodes() != grid->getNumNodes()) || 
+		(snapshot.getNumElems() != grid->getNumElems()))
+		numMismatch = grid->getNumNodes();
+	else
+	{
+		for (UInt i = 0; i < grid->getNumNodes(); ++i)
+			if ((snapshot.getNode(i) - grid->getNode(i)).norm2() > 1e-6)
+				++numMismatch;
+		for (UInt i = 0; i < grid->getNumElems(); ++i)
+			for (UInt j = 0; j < 3; ++j)
+				if (snapshot.getElem(i)[j] != grid->getElem(i)[j])
+					++numMismatch;
+	}
+
+	cout << "Nodes in the snapshot: " << snapshot.getNumNodes() << endl;
+	cout << "Nodes in the final mesh: " << multi.getCPointerToMesh()->getNumNodes() << endl;
+	cout << "Mismatches: " << numMismatch << endl;
+
+	remove("main_multiTarget_2000.inp");
+	remove("main_multiTarget_1500.inp");
+}
@@ -0,0 +1,36 @@
+/*!	\file	main_multipleChoice.cpp
+	\brief	A small executable running the simplification process with
+			the queue of collapsing edges and with the multiple-choice
+			scheduler, for different numbers of random candidates. */
+
+#include <iostream>
+#include <chrono>
+
+#include "simplification.hpp"
+
+int main()
+{
+	using namespace geometry;
+	using namespace std::chrono;
+
+	// File to mesh
+	string inputfile("mesh/pawn.inp");
+
+	// Target number of nodes
+	UInt numNodes(1000);
+
+	for (UInt k : {0, 4, 8, 16})
+	{
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> simplifier(inputfile);
+		simplifier.setMultipleChoice(k, 1);
+
+		auto start = high_resolution_clock::now();
+		simplifier.simplify(numNodes, true);
+		auto stop = high_resolution_clock::now();
+
+		cout << "Choices " << k << ": "
+			<< simplifier.getCPointerToMesh()->getNumNodes() << " nodes, "
+			<< simplifier.getCPointerToMesh()->getNumElems() << " elements, "
+			<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+	}
+}
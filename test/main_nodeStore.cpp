@@ -0,0 +1,124 @@
+/*!	\file	main_nodeStore.cpp
+	\brief	A small executable comparing the nodes of a mesh stored in a
+			nodeStore against the same nodes stored in a vector of point's,
+			in terms of memory and of time spent in computing the bounding box
+			and the normals to the elements. */
+
+#include <iostream>
+#include <chrono>
+
+#include "meshInfo.hpp"
+
+using namespace geometry;
+
+/*!	Layout of a point as it used to be, i.e. with a pointer to the virtual table. */
+struct virtualPoint
+{
+	virtual ~virtualPoint() = default;
+	Real coor[3];
+	UInt Id;
+	UInt boundary;
+	bool active;
+};
+
+int main()
+{
+	using namespace std::chrono;
+
+	for (string inputfile : {"mesh/pawn.inp", "mesh/bunny.inp"})
+	{
+		meshInfo<Triangle, MeshType::GEO> news(inputfile);
+		auto grid = news.getCPointerToMesh();
+		auto & store = grid->getNodeStore();
+		auto nodes = grid->getNodes();
+		cout << inputfile << ": " << grid->getNumNodes() << " nodes, "
+			<< grid->getNumElems() << " elements" << endl;
+
+		//
+		// Memory
+		//
+
+		cout << "  Nodes as points with virtual table: "
+			<< nodes.size() * sizeof(virtualPoint) / 1024 << " KiB" << endl;
+		cout << "  Nodes as points: " << nodes.size() * sizeof(point) / 1024 << " KiB" << endl;
+		cout << "  Nodes in the store: " << store.getMemory() / 1024 << " KiB" << endl;
+
+		//
+		// Bounding box
+		//
+
+		UInt numRepeat(100);
+		point3d NE_aos, NE_soa;
+
+		auto start = high_resolution_clock::now();
+		for (UInt r = 0; r < numRepeat; ++r)
+		{
+			auto aux = numeric_limits<Real>::lowest();
+			NE_aos = point3d(aux,aux,aux);
+			for (auto & p : nodes)
+				if (p.isActive())
+					for (UInt j = 0; j < 3; ++j)
+						if (p[j] > NE_aos[j])
+							NE_aos[j] = p[j];
+		}
+		auto stop = high_resolution_clock::now();
+		cout << "  Bounding box from points: "
+			<< duration_cast<microseconds>(stop-start).count() / numRepeat << " us" << endl;
+
+		start = high_resolution_clock::now();
+		for (UInt r = 0; r < numRepeat; ++r)
+			NE_soa = news.getNorthEastPoint();
+		stop = high_resolution_clock::now();
+		cout << "  Bounding box from the store: "
+			<< duration_cast<microseconds>(stop-start).count() / numRepeat << " us" << endl;
+
+		//
+		// Normals
+		//
+
+		UInt numMismatch((NE_aos - NE_soa).norm2() > 0.);
+		for (UInt i = 0; i < grid->getElemsListSize(); ++i)
+		{
+			auto & elem = grid->getElem(i);
+			auto & A = nodes[elem[0]];
+			auto & B = nodes[elem[1]];
+			auto & C = nodes[elem[2]];
+			if ((((B - A)^(C - B)).normalize() - news.getNormal(i)).norm2() > 0.)
+				++numMismatch;
+		}
+
+		start = high_resolution_clock::now();
+		Real sum(0.);
+		for (UInt r = 0; r < numRepeat; ++r)
+			for (UInt i = 0; i < grid->getElemsListSize(); ++i)
+			{
+				auto & elem = grid->getElem(i);
+				auto & A = nodes[elem[0]];
+				auto & B = nodes[elem[1]];
+				auto & C = nodes[elem[2]];
+				sum += ((B - A)^(C - B)).normalize()[2];
+			}
+		stop = high_resolution_clock::now();
+		cout << "  Normals from points: "
+			<< duration_cast<microseconds>(stop-start).count() / numRepeat << " us"
+			<< " (checksum " << sum << ")" << endl;
+
+		start = high_resolution_clock::now();
+		sum = 0.;
+		for (UInt r = 0; r < numRepeat; ++r)
+			for (UInt i = 0; i < grid->getElemsListSize(); ++i)
+			{
+				auto & elem = grid->getElem(i);
+				auto A = store.getCoor(elem[0]);
+				auto B = store.getCoor(elem[1]);
+				auto C = store.getCoor(elem[2]);
+				sum += ((B - A)^(C - B)).normalize()[2];
+			}
+		stop = high_resolution_clock::now();
+		cout << "  Normals from the store: "
+			<< duration_cast<microseconds>(stop-start).count() / numRepeat << " us"
+			<< " (checksum " << sum << ")" << endl;
+
+		cout << "  Mismatches: " << numMismatch << endl;
+	}
+}
@@ -0,0 +1,66 @@
+/*!	\file	main_parallelSetup.cpp
+	\brief	A small executable comparing the serial and the parallel
+			build of the queue of collapsing edges.
+
+	Two simplification objects are built on the same mesh; the queue is
+	built by a single thread for the former and by several threads
+	for the latter. Then, both meshes are simplified and the resulting
+	nodes compared. */
+
+#include <iostream>
+#include <chrono>
+
+#include "simplification.hpp"
+
+int main()
+{
+	using namespace geometry;
+	using namespace std::chrono;
+
+	// File to mesh
+	string inputfile("mesh/pawn.inp");
+
+	// Target number of nodes
+	UInt numNodes(2000);
+
+	simplification<Triangle, MeshType::DATA, DataGeo> serial(inputfile);
+	simplification<Triangle, MeshType::DATA, DataGeo> parallel(inputfile);
+
+	//
+	// Build the queues
+	//
+
+	serial.setNumThreads(1);
+	auto start = high_resolution_clock::now();
+	serial.setupCollapsingSet();
+	auto stop = high_resolution_clock::now();
+	cout << "Serial build (1 thread): "
+		<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	parallel.setNumThreads(4);
+	start = high_resolution_clock::now();
+	parallel.setupCollapsingSet();
+	stop = high_resolution_clock::now();
+	cout << "Parallel build (" << parallel.getNumThreads() << " threads): "
+		<< duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	//
+	// Simplify and compare
+	//
+
+	serial.simplify(numNodes, true);
+	parallel.simplify(numNodes, true);
+
+	auto grid_s = serial.getCPointerToMesh();
+	auto grid_p = parallel.getCPointerToMesh();
+	UInt numMismatch(0);
+	if (grid_s->getNumNodes() != grid_p->getNumNodes())
+		numMismatch = grid_s->getNumNodes();
+	else
+		for (UInt i = 0; i < grid_s->getNumNodes(); ++i)
+			if ((grid_s->getNode(i) - grid_p->getNode(i)).norm2() > 0.)
+				++numMismatch;
+
+	cout << "Number of nodes:   " << grid_s->getNumNodes() << endl;
+	cout << "Mismatching nodes: " << numMismatch << endl;
+}
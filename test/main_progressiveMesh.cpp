@@ -0,0 +1,85 @@
+/*!	\file	main_progressiveMesh.cpp
+	\brief	A small executable testing the extraction of intermediate
+			meshes from the collapse log.
+
+	A mesh with distributed data is simplified once with the collapse log
+	enabled, then the mesh at an intermediate number of nodes is extracted
+	from the log and compared with the outcome of a separate run. The mesh
+	at the final number of nodes is compared with the simplified mesh. */
+
+#include <iostream>
+#include <chrono>
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Count the mismatching nodes, elements and data points of two meshes.
+	\param a	first mesh
+	\param b	second mesh
+	\return		number of mismatches */
+UInt compare(const mesh<Triangle, MeshType::DATA> & a, const mesh<Triangle, MeshType::DATA> & b)
+{
+	if ((a.getNumNodes() != b.getNumNodes()) || (a.getNumElems() != b.getNumElems())
+		|| (a.getNumData() != b.getNumData()))
+		return a.getNumNodes() + a.getNumElems() + a.getNumData();
+	
+	UInt numMismatch(0);
+	for (UInt i = 0; i < a.getNumNodes(); ++i)
+		if ((a.getNode(i) - b.getNode(i)).norm2() > 0.)
+			++numMismatch;
+	for (UInt i = 0; i < a.getNumElems(); ++i)
+		for (UInt j = 0; j < 3; ++j)
+			if (a.getElem(i)[j] != b.getElem(i)[j])
+				++numMismatch;
+	for (UInt i = 0; i < a.getNumData(); ++i)
+		if ((a.getData(i) - b.getData(i)).norm2() > 0.)
+			++numMismatch;
+	return numMismatch;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	// File to mesh
+	string inputfile("mesh/pawn.inp");
+
+	// Intermediate and final number of nodes
+	UInt numNodesLOD(2000), numNodes(1500);
+
+	//
+	// Simplify once, recording the collapses
+	//
+
+	simplification<Triangle, MeshType::DATA, DataGeo> logged(inputfile);
+	logged.enableCollapseLog();
+	logged.simplify(numNodes, true);
+	cout << "Recorded collapses: " << logged.getCollapseLog().size() << endl;
+
+	auto start = high_resolution_clock::now();
+	auto lod = logged.getLevelOfDetail(numNodesLOD);
+	auto stop = high_resolution_clock::now();
+	auto dif_lod = duration_cast<milliseconds>(stop-start).count();
+
+	//
+	// Simplify to the intermediate number of nodes
+	//
+
+	simplification<Triangle, MeshType::DATA, DataGeo> direct(inputfile);
+	start = high_resolution_clock::now();
+	direct.simplify(numNodesLOD, true);
+	stop = high_resolution_clock::now();
+	auto dif_direct = duration_cast<milliseconds>(stop-start).count();
+
+	//
+	// Compare
+	//
+
+	cout << "Extraction at " << numNodesLOD << " nodes: " << dif_lod << " ms, "
+		<< "separate run: " << dif_direct << " ms" << endl;
+	cout << "Mismatches at " << numNodesLOD << " nodes: " 
+		<< compare(lod, *direct.getCPointerToMesh()) << endl;
+	cout << "Mismatches at " << numNodes << " nodes: " 
+		<< compare(logged.getLevelOfDetail(numNodes), *logged.getCPointerToMesh()) << endl;
+}
@@ -0,0 +1,126 @@
+/*!	\file	main_refresh.cpp
+	\brief	A small executable testing the in-place refresh of a mesh and
+			its connections against the connections re-built from scratch.
+
+	A sequence of edge collapses is applied to a mesh and its connections.
+	Then, the mesh is refreshed and the old-to-new maps are applied to the
+	connections, which are compared with the connections re-built on the
+	refreshed mesh, as it used to be done. Time spent in the two approaches is reported. */
+
+#include <iostream>
+#include <chrono>
+
+#include "connect.hpp"
+
+using namespace geometry;
+
+/*!	Count the items which differ between two lists of connections.
+	\param v	first list
+	\param w	second list
+	\return		number of mismatches */
+UInt compare(const vector<graphItem> & v, const vector<graphItem> & w)
+{
+	if (v.size() != w.size())
+		return max(v.size(), w.size());
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < v.size(); ++i)
+		if ((v[i].getId() != w[i].getId()) || (v[i].getConnected() != w[i].getConnected()))
+			++numMismatch;
+	return numMismatch;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	for (string inputfile : {"mesh/pawn.inp", "mesh/bunny.inp"})
+	{
+		connect<Triangle, MeshType::DATA> conn(inputfile);
+		auto grid = conn.getPointerToMesh();
+		cout << inputfile << ": " << grid->getNumNodes() << " nodes, "
+			<< grid->getNumElems() << " elements" << endl;
+
+		//
+		// Edge collapses
+		//
+
+		// Collapse every other edge satisfying the link condition, i.e.
+		// whose end-points share only the two nodes opposite to the edge,
+		// until a quarter of the nodes have been removed
+		auto edges = conn.getEdges();
+		vector<UInt> common, toRemove;
+		UInt numCollapses(0), maxCollapses(grid->getNumNodes()/4);
+		for (UInt i = 0; (i < edges.size()) && (numCollapses < maxCollapses); i += 2)
+		{
+			UInt id1(edges[i][0]), id2(edges[i][1]);
+			if (!grid->isNodeActive(id1) || !grid->isNodeActive(id2))
+				continue;
+			set_intersection(conn.getNode2Node(id1), conn.getNode2Node(id2), common);
+			set_intersection(conn.getNode2Elem(id1), conn.getNode2Elem(id2), toRemove);
+			if ((common.size() != 2) || (toRemove.size() != 2))
+				continue;
+
+			conn.applyEdgeCollapse(id2, id1, toRemove);
+			grid->setNodeInactive(id2);
+			for (auto elem : toRemove)
+				grid->setElemInactive(elem);
+			++numCollapses;
+		}
+		cout << "  " << numCollapses << " collapses" << endl;
+
+		//
+		// Refresh
+		//
+
+		// Refresh the mesh of a copy, re-build its connections and
+		// apply the old-to-new map for elements to data-element connections
+		connect<Triangle, MeshType::DATA> rebuilt(conn);
+		auto start = high_resolution_clock::now();
+		auto old2new = rebuilt.getPointerToMesh()->refresh();
+		rebuilt.buildNode2Node();
+		rebuilt.buildNode2Elem();
+		vector<graphItem> data2elem, elem2data;
+		data2elem.reserve(grid->getNumData());
+		for (auto & datum : rebuilt.getData2Elem())
+		{
+			data2elem.emplace_back(datum.getId());
+			for (auto id : datum.getConnected())
+				if (old2new.second[id] != REMOVED_ID)
+					data2elem.back().insert(old2new.second[id]);
+		}
+		elem2data.reserve(rebuilt.getPointerToMesh()->getNumElems());
+		for (UInt id = 0; id < rebuilt.getPointerToMesh()->getNumElems(); ++id)
+			elem2data.emplace_back(id);
+		for (auto & datum : data2elem)
+			for (auto id : datum.getConnected())
+				elem2data[id].insert(datum.getId());
+		auto stop = high_resolution_clock::now();
+		cout << "  Refresh and re-build: "
+			<< duration_cast<microseconds>(stop-start).count() << " us" << endl;
+
+		// Refresh in place
+		start = high_resolution_clock::now();
+		conn.refresh();
+		stop = high_resolution_clock::now();
+		cout << "  Refresh in place: "
+			<< duration_cast<microseconds>(stop-start).count() << " us" << endl;
+
+		//
+		// Compare
+		//
+
+		UInt numMismatch(0);
+		numMismatch += compare(conn.getNode2Node(), rebuilt.getNode2Node());
+		numMismatch += compare(conn.getNode2Elem(), rebuilt.getNode2Elem());
+		numMismatch += compare(conn.getData2Elem(), data2elem);
+		numMismatch += compare(conn.getElem2Data(), elem2data);
+		if (conn.getNumEdges() != rebuilt.getNumEdges())
+			++numMismatch;
+		for (UInt i = 0; i < grid->getNodesListSize(); ++i)
+			if ((grid->getNode(i) - rebuilt.getPointerToMesh()->getNode(i)).norm2() > 0.)
+				++numMismatch;
+		cout << "  " << grid->getNumNodes() << " nodes and " << grid->getNumElems()
+			<< " elements left, mismatches: " << numMismatch << endl;
+	}
+}
@@ -0,0 +1,209 @@
+/*!	\file	main_reorder.cpp
+	\brief	A small executable testing and benchmarking the re-ordering
+			of a mesh along the Morton curve.
+
+	The nodes and the elements of a mesh are shuffled, so to mimic an
+	input file stored in arbitrary order. Then:
+	<ol>
+	<li> the shuffled mesh is re-ordered, and the connections updated
+		 by reorder() are compared with the ones re-built from scratch;
+	<li> the extended patch of each node is walked through, on both the
+		 shuffled and the re-ordered mesh;
+	<li> the shuffled mesh is simplified with and without re-ordering.
+	<\ol>
+	Wall time and, whenever the hardware counters are available (Linux
+	only), the number of cache misses are reported. */
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "simplification.hpp"
+
+using namespace geometry;
+
+/*!	Counter of the cache misses of the calling thread,
+	through the Linux performance counters. */
+class cacheMisses
+{
+	private:
+		/*!	File descriptor of the counter; negative if not available. */
+		int fd;
+
+	public:
+		/*!	Constructor. */
+		cacheMisses() : fd(-1)
+		{
+			#ifdef __linux__
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = PERF_COUNT_HW_CACHE_MISSES;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+			#endif
+		}
+
+		/*!	Destructor. */
+		~cacheMisses()
+		{
+			#ifdef __linux__
+			if (fd >= 0)
+				close(fd);
+			#endif
+		}
+
+		/*!	Reset and start the counter. */
+		void start()
+		{
+			#ifdef __linux__
+			if (fd >= 0)
+			{
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+			#endif
+		}
+
+		/*!	Stop the counter.
+			\return		the string to print */
+		string stop()
+		{
+			#ifdef __linux__
+			long long count;
+			if ((fd >= 0) && (ioctl(fd, PERF_EVENT_IOC_DISABLE, 0) == 0) &&
+				(read(fd, &count, sizeof(count)) == sizeof(count)))
+				return to_string(count);
+			#endif
+			return "not available";
+		}
+};
+
+/*!	Count the items which differ between two lists of connections.
+	\param v	first list
+	\param w	second list
+	\return		number of mismatches */
+UInt compare(const vector<graphItem> & v, const vector<graphItem> & w)
+{
+	if (v.size() != w.size())
+		return max(v.size(), w.size());
+
+	UInt numMismatch(0);
+	for (UInt i = 0; i < v.size(); ++i)
+		if ((v[i].getId() != w[i].getId()) || (v[i].getConnected() != w[i].getConnected()))
+			++numMismatch;
+	return numMismatch;
+}
+
+/*!	Walk through the extended patch of each node, i.e. the nodes
+	connected to the node itself or to its neighbours.
+	\param conn	the connectivity
+	\return		a checksum */
+Real walk(connect<Triangle, MeshType::GEO> & conn)
+{
+	auto grid = conn.getPointerToMesh();
+	Real sum(0.);
+	for (UInt i = 0; i < grid->getNumNodes(); ++i)
+		for (auto j : conn.getNode2Node(i))
+			for (auto k : conn.getNode2Node(j))
+				sum += grid->getCoor(k)[0];
+	return sum;
+}
+
+int main()
+{
+	using namespace std::chrono;
+
+	// File to mesh and target number of nodes
+	string inputfile("mesh/bunny.inp");
+	UInt numNodes(30000);
+
+	//
+	// Shuffle the mesh
+	//
+
+	bmesh<Triangle> bm(inputfile);
+	UInt nNodes(bm.getNumNodes()), nElems(bm.getNumElems());
+	vector<UInt> nodesPerm(nNodes), elemsPerm(nElems);
+	iota(nodesPerm.begin(), nodesPerm.end(), 0);
+	iota(elemsPerm.begin(), elemsPerm.end(), 0);
+	mt19937 engine(0);
+	shuffle(nodesPerm.begin(), nodesPerm.end(), engine);
+	shuffle(elemsPerm.begin(), elemsPerm.end(), engine);
+
+	MatrixXd nds(nNodes, 3);
+	MatrixXi els(nElems, 3);
+	for (UInt i = 0; i < nNodes; ++i)
+		for (UInt j = 0; j < 3; ++j)
+			nds(nodesPerm[i], j) = bm.getCoor(i)[j];
+	for (UInt i = 0; i < nElems; ++i)
+		for (UInt j = 0; j < 3; ++j)
+			els(elemsPerm[i], j) = nodesPerm[bm.getElem(i)[j]];
+	cout << inputfile << " shuffled: " << nNodes << " nodes, " << nElems << " elements" << endl;
+
+	//
+	// Re-order and compare with the connections built from scratch
+	//
+
+	connect<Triangle, MeshType::GEO> shuffled(nds, els);
+	connect<Triangle, MeshType::GEO> reordered(shuffled);
+	auto start = high_resolution_clock::now();
+	reordered.reorder();
+	auto stop = high_resolution_clock::now();
+	cout << "Re-ordering: " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+	connect<Triangle, MeshType::GEO> rebuilt(reordered.getMesh());
+	UInt numMismatch(0);
+	numMismatch += compare(reordered.getNode2Node(), rebuilt.getNode2Node());
+	numMismatch += compare(reordered.getNode2Elem(), rebuilt.getNode2Elem());
+	if (reordered.getNumEdges() != rebuilt.getNumEdges())
+		++numMismatch;
+	cout << "Mismatching connections: " << numMismatch << endl;
+
+	//
+	// Walk through the patches
+	//
+
+	cacheMisses counter;
+	for (auto conn : {&shuffled, &reordered})
+	{
+		counter.start();
+		start = high_resolution_clock::now();
+		auto sum = walk(*conn);
+		stop = high_resolution_clock::now();
+		auto misses = counter.stop();
+		cout << ((conn == &shuffled) ? "Shuffled" : "Re-ordered") << " patch walk: "
+			<< duration_cast<microseconds>(stop-start).count() << " us, "
+			<< "cache misses: " << misses << " (checksum " << sum << ")" << endl;
+	}
+
+	//
+	// Simplify with and without re-ordering
+	//
+
+	for (auto flag : {false, true})
+	{
+		simplification<Triangle, MeshType::GEO, OnlyGeo<MeshType::GEO>> simp(nds, els);
+		simp.setReordering(flag);
+		counter.start();
+		start = high_resolution_clock::now();
+		simp.simplify(numNodes, true);
+		stop = high_resolution_clock::now();
+		auto misses = counter.stop();
+		cout << (flag ? "With" : "Without") << " re-ordering: "
+			<< duration_cast<milliseconds>(stop-start).count() << " ms, "
+			<< "cache misses: " << misses << endl;
+	}
+}
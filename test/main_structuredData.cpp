@@ -43,4 +43,19 @@ int main()
 	auto duration = duration_cast<milliseconds>(stop-start).count();
 	cout << "Elapsed time: " << duration << " ms" << endl << endl;
 	#endif
+	
+	// Query the neighbours of all elements, re-using the same buffer
+	{
+	auto t0 = high_resolution_clock::now();
+	vector<UInt> ids;
+	UInt numNeighbours(0);
+	for (UInt i = 0; i < news.getCPointerToMesh()->getNumElems(); ++i)
+	{
+		sd.getNeighbouringElements(i, ids);
+		numNeighbours += ids.size();
+	}
+	auto t1 = high_resolution_clock::now();
+	cout << "Neighbours of all elements: " << numNeighbours << " found in "
+		<< duration_cast<milliseconds>(t1-t0).count() << " ms" << endl;
+	}
 }
@@ -0,0 +1,141 @@
+/*!	\file	main_trialCollapse.cpp
+	\brief	A small executable comparing the trial collapse, which works
+			on a local copy of the patch, with the temporary collapse
+			performed directly on the mesh.
+
+	For each edge of the mesh, the collapse in the mid-point is evaluated
+	both ways; the validity (no degenerate, inverted or empty triangles),
+	the quantity of information of the elements involved and the
+	mesh self-intersections are compared. */
+
+#include <iostream>
+#include <chrono>
+
+#include "projection.hpp"
+#include "structuredData.hpp"
+#include "intersection.hpp"
+#include "trialCollapse.hpp"
+
+int main()
+{
+	using namespace geometry;
+	using namespace std::chrono;
+
+	// File to mesh
+	string inputfile("mesh/brain.inp");
+
+	projection<Triangle> prj(inputfile);
+	auto conn = prj.getPointerToConnectivity();
+	structuredData<Triangle> sdata(prj);
+	intersection<Triangle> intrs(prj.getPointerToMesh());
+
+	auto edges = conn->getEdges();
+	UInt numFeasible(0), numValid(0), numIntersecting(0), numMismatch(0);
+
+	//
+	// Trial collapse
+	//
+
+	auto start = high_resolution_clock::now();
+
+	vector<bool> feasible_t(edges.size(), false), valid_t(edges.size(), false),
+		intersect_t(edges.size(), false);
+	vector<vector<Real>> qoi_t(edges.size());
+	for (UInt i = 0; i < edges.size(); ++i)
+	{
+		auto id1(edges[i][0]), id2(edges[i][1]);
+		trialCollapse<Triangle, MeshType::DATA> trial(prj, id1, id2);
+		feasible_t[i] = trial.isFeasible();
+		if (!feasible_t[i])
+			continue;
+		++numFeasible;
+
+		trial.setCollapsingPoint(0.5*(prj.getCPointerToMesh()->getNode(id1) +
+			prj.getCPointerToMesh()->getNode(id2)));
+		valid_t[i] = trial.isValid() && trial.project();
+		if (valid_t[i])
+		{
+			++numValid;
+			qoi_t[i] = trial.getQuantityOfInformation();
+			intersect_t[i] = trial.intersect(sdata);
+			if (intersect_t[i])
+				++numIntersecting;
+		}
+	}
+
+	auto stop = high_resolution_clock::now();
+	cout << "Trial collapse: " << duration_cast<milliseconds>(stop-start).count()
+		<< " ms" << endl;
+
+	//
+	// Temporary collapse on the mesh
+	//
+
+	start = high_resolution_clock::now();
+
+	for (UInt i = 0; i < edges.size(); ++i)
+	{
+		auto id1(edges[i][0]), id2(edges[i][1]);
+		auto invElems = prj.getElemsInvolvedInEdgeCollapsing(id1,id2);
+		auto toRemove = prj.getElemsOnEdge(id1,id2);
+		auto toKeep = prj.getElemsModifiedInEdgeCollapsing(id1,id2);
+		auto toMove = prj.getDataModifiedInEdgeCollapsing(invElems);
+		if (!feasible_t[i])
+			continue;
+
+		vector<point3d> oldNormals;
+		for (auto elem : toKeep)
+			oldNormals.emplace_back(prj.getNormal(elem));
+
+		// Apply the collapse
+		point3d P(prj.getCPointerToMesh()->getNode(id1));
+		point3d M(0.5*(P + prj.getCPointerToMesh()->getNode(id2)));
+		auto oldConnections = conn->applyEdgeCollapse(id2, id1, toRemove, toKeep);
+		prj.getPointerToMesh()->setNode(id1, M);
+		auto oldData = prj.project(toMove, toKeep);
+		conn->eraseElemInData2Elem(toRemove);
+
+		// Check validity and quantity of information
+		bool valid(true);
+		vector<Real> qoi;
+		for (UInt j = 0; j < toKeep.size(); ++j)
+		{
+			valid = valid && (prj.getTriArea(toKeep[j]) > TOLL) &&
+				(oldNormals[j] * prj.getNormal(toKeep[j]) > TOLL) &&
+				!prj.isEmpty(toKeep[j]);
+			qoi.push_back(prj.getQuantityOfInformation(toKeep[j]));
+		}
+		
+		// Check self-intersections
+		bool intersect(false);
+		if (valid)
+		{
+			sdata.update_f(toKeep);
+			for (auto elem : toKeep)
+				for (auto neighbour : sdata.getNeighbouringElements(elem))
+					intersect = intersect || intrs.intersect(elem, neighbour);
+		}
+		
+		if ((valid != valid_t[i]) || (valid && (qoi != qoi_t[i])) || 
+			(intersect != intersect_t[i]))
+			++numMismatch;
+
+		// Restore the mesh
+		prj.undo(toMove, oldData);
+		conn->insertElemInData2Elem(toRemove);
+		conn->undoEdgeCollapse(id2, id1, oldConnections.first, oldConnections.second, toRemove);
+		prj.getPointerToMesh()->setNode(id1, P);
+		if (valid)
+			sdata.update_f(toKeep);
+	}
+
+	stop = high_resolution_clock::now();
+	cout << "Temporary collapse: " << duration_cast<milliseconds>(stop-start).count()
+		<< " ms" << endl;
+
+	cout << "Number of edges:             " << edges.size() << endl;
+	cout << "Feasible collapses:          " << numFeasible << endl;
+	cout << "Valid collapses:             " << numValid << endl;
+	cout << "Self-intersecting collapses: " << numIntersecting << endl;
+	cout << "Mismatches:                  " << numMismatch << endl;
+}